@@ -22,6 +22,13 @@ static int  cache_check(int ix, int i);
 static int  cache_isbusy(int ix, int i);
 static int  cache_isempty(int ix, int i);
 static void cache_allocbuf(int ix, int i, int len);
+static int  cache_hashix(int ix, U64 key);
+static void cache_hash(int ix, int i);
+static void cache_unhash(int ix, int i);
+static void cache_a1push(int ix, int i);
+static int  cache_a1valid(int ix, U64 slot);
+static int  cache_a1victim(int ix);
+static void cache_policy_reset(int ix, int policy);
 
 DISABLE_GCC_UNUSED_FUNCTION_WARNING;
 
@@ -30,6 +37,14 @@ DISABLE_GCC_UNUSED_FUNCTION_WARNING;
 /*-------------------------------------------------------------------*/
 static CACHEBLK  cacheblk[ CACHE_MAX_INDEX ] = {0};
 
+/*-------------------------------------------------------------------*/
+/* Replacement policy for each cache; kept across cache destroy      */
+/*-------------------------------------------------------------------*/
+static BYTE      cachepolicy[ CACHE_MAX_INDEX ] = {0};
+
+static const char *cachepolicyname[ CACHE_POLICIES ] = { "CLOCK", "2Q" };
+static const char *cachename[] = { "DEVBUF", "L2" };
+
 #define OBTAIN_GLOBAL_CACHE_LOCK()   obtain_lock(  &sysblk.dasdcache_lock )
 #define RELEASE_GLOBAL_CACHE_LOCK()  release_lock( &sysblk.dasdcache_lock )
 
@@ -102,57 +117,75 @@ int cache_hit_percent (int ix)
 
 int cache_lookup (int ix, U64 key, int *oldest_entry)
 {
-    int i,p;
+    int i, n;
 
     if (oldest_entry)
         *oldest_entry = -1;
     if (cache_check_ix(ix))
         return -1;
-    /* `p' is the preferred index */
-    p = (int)(key % cacheblk[ix].nbr);
 
-    if (cacheblk[ix].cache[p].key == key)
-    {
-        i = p;
-        if (!cache_isempty(ix, i))
-        {
-            cacheblk[ix].fasthits++;
-        }
-    }
-    else
+    /* Search the key's hash chain */
+    for (i = cacheblk[ix].hash[cache_hashix(ix, key)] - 1, n = 0;
+         i >= 0; i = cacheblk[ix].cache[i].hnext - 1, n++)
     {
-        if (cache_isbusy(ix, p) || cacheblk[ix].age - cacheblk[ix].cache[p].age < 20)
-            p = -2;
-        for (i = 0; i < cacheblk[ix].nbr; i++)
+        if (cacheblk[ix].cache[i].key == key)
         {
-            if (cacheblk[ix].cache[i].key == key) break;
-            if (oldest_entry && !cache_isbusy(ix, i)
-             && (*oldest_entry < 0 || i == p || cacheblk[ix].cache[i].age < cacheblk[ix].cache[*oldest_entry].age))
-                if (*oldest_entry != p) *oldest_entry = i;
+            cacheblk[ix].probes += n + 1;
+            if (n == 0)
+                cacheblk[ix].fasthits++;
+            cacheblk[ix].hits++;
+            cacheblk[ix].phits[cacheblk[ix].policy]++;
+            return i;
         }
     }
+    cacheblk[ix].probes += n;
+
+    cacheblk[ix].misses++;
+    cacheblk[ix].pmisses[cacheblk[ix].policy]++;
 
-    if (i >= cacheblk[ix].nbr)
+    if (!oldest_entry || cacheblk[ix].busy >= cacheblk[ix].nbr)
+        return -1;
+
+    /* 2Q: steal the oldest probationary entry while the A1in
+       segment holds more than its share of the cache */
+    if (cacheblk[ix].policy == CACHE_POLICY_2Q
+     && cacheblk[ix].empty == 0
+     && cacheblk[ix].a1in > cacheblk[ix].nbr / 4)
     {
-        i = -1;
+        *oldest_entry = cache_a1victim(ix);
+        if (*oldest_entry >= 0)
+            return -1;
     }
-    else if ( i >= 0 && cache_isempty(ix, i) )
+
+    /* Advance the clock hand to an entry that may be stolen.  Each
+       entry is passed over at most twice: the first pass clears the
+       reference bits, so an entry that is not busy is found on the
+       second pass if there is one at all.  Under 2Q the sweep only
+       considers entries in the main (Am) segment. */
+    for (n = 2 * cacheblk[ix].nbr; n > 0; n--)
     {
-        if ( oldest_entry && *oldest_entry < 0 )
+        i = cacheblk[ix].hand;
+        if (++cacheblk[ix].hand >= cacheblk[ix].nbr)
+            cacheblk[ix].hand = 0;
+        cacheblk[ix].sweeps++;
+
+        if (cache_isbusy(ix, i))
+            continue;
+        if (cacheblk[ix].cache[i].seg == CACHE_SEG_A1IN)
+            continue;
+        if (cacheblk[ix].cache[i].ref && !cache_isempty(ix, i))
         {
-            *oldest_entry = i;
+            cacheblk[ix].cache[i].ref = 0;
+            continue;
         }
-        i = -1;
-    }
-    if ( i >= 0 )
-    {
-        cacheblk[ix].hits++;
+        *oldest_entry = i;
+        break;
     }
-    else
-    {
-        cacheblk[ix].misses++;
-    }
-    return i;
+
+    if (*oldest_entry < 0 && cacheblk[ix].policy == CACHE_POLICY_2Q)
+        *oldest_entry = cache_a1victim(ix);
+
+    return -1;
 }
 
 int cache_scan (int ix, CACHE_SCAN_RTN rtn, void *data)
@@ -225,7 +258,35 @@ U64 cache_setkey(int ix, int i, U64 key)
     if (cache_check(ix,i)) return (U64)-1;
     empty = cache_isempty(ix, i);
     oldkey = cacheblk[ix].cache[i].key;
-    cacheblk[ix].cache[i].key = key;
+    if (oldkey != key || !cacheblk[ix].cache[i].hashed)
+    {
+        if (cacheblk[ix].cache[i].hashed)
+            cache_unhash(ix, i);
+        cacheblk[ix].cache[i].key = key;
+        cache_hash(ix, i);
+
+        /* 2Q: an entry leaving A1in is remembered in A1out; a new
+           key goes to Am if it is found there, otherwise to A1in */
+        if (cacheblk[ix].cache[i].seg == CACHE_SEG_A1IN)
+        {
+            cacheblk[ix].a1in--;
+            cacheblk[ix].a1out[cache_hashix(ix, oldkey)] = oldkey;
+        }
+        cacheblk[ix].cache[i].seg = CACHE_SEG_AM;
+        if (cacheblk[ix].policy == CACHE_POLICY_2Q)
+        {
+            int h = cache_hashix(ix, key);
+            if (cacheblk[ix].a1out[h] == key)
+                cacheblk[ix].a1out[h] = CACHE_A1OUT_EMPTY;
+            else
+            {
+                cacheblk[ix].cache[i].seg = CACHE_SEG_A1IN;
+                cacheblk[ix].cache[i].a1seq = ++cacheblk[ix].a1seq;
+                cacheblk[ix].a1in++;
+                cache_a1push(ix, i);
+            }
+        }
+    }
     if (empty && !cache_isempty(ix, i))
         cacheblk[ix].empty--;
     else if (!empty && cache_isempty(ix, i))
@@ -282,6 +343,7 @@ U64 cache_setage(int ix, int i)
     empty = cache_isempty(ix, i);
     oldage = cacheblk[ix].cache[i].age;
     cacheblk[ix].cache[i].age = ++cacheblk[ix].age;
+    cacheblk[ix].cache[i].ref = 1;
     if (empty) cacheblk[ix].empty--;
     return oldage;
 }
@@ -350,6 +412,11 @@ int cache_release(int ix, int i, int flag)
     buf = cacheblk[ix].cache[i].buf;
     len = cacheblk[ix].cache[i].len;
 
+    if (cacheblk[ix].cache[i].hashed)
+        cache_unhash(ix, i);
+    if (cacheblk[ix].cache[i].seg == CACHE_SEG_A1IN)
+        cacheblk[ix].a1in--;
+
     memset(&cacheblk[ix].cache[i], 0, sizeof(CACHE));
 
     if ((flag & CACHE_FREEBUF) && buf != NULL) {
@@ -371,6 +438,98 @@ int cache_release(int ix, int i, int flag)
     return 0;
 }
 
+int cache_getpolicy(int ix)
+{
+    if (cache_check_ix(ix)) return -1;
+    return cachepolicy[ix];
+}
+
+int cache_setpolicy(int ix, int policy)
+{
+    int oldpolicy;
+
+    if (cache_check_ix(ix) || policy < 0 || policy >= CACHE_POLICIES)
+        return -1;
+
+    OBTAIN_GLOBAL_CACHE_LOCK();
+    {
+        oldpolicy = cachepolicy[ix];
+        cachepolicy[ix] = (BYTE)policy;
+        if (cacheblk[ix].magic == CACHE_MAGIC)
+        {
+            obtain_lock(&cacheblk[ix].lock);
+            cache_policy_reset(ix, policy);
+            release_lock(&cacheblk[ix].lock);
+        }
+    }
+    RELEASE_GLOBAL_CACHE_LOCK();
+    return oldpolicy;
+}
+
+/*-------------------------------------------------------------------*/
+/* cache command - display or set the cache replacement policy       */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int cache_cmd(int argc, char *argv[], char *cmdline)
+{
+    int ix, policy;
+    char buf[64];
+
+    UNREFERENCED(cmdline);
+
+    if (argc > 3)
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG(HHC02299, "E", argv[0]);
+        return -1;
+    }
+
+    if (argc < 2)
+    {
+        for (ix = 0; ix < (int)_countof(cachename); ix++)
+        {
+            MSGBUF(buf, "%s policy", cachename[ix]);
+            // "%-14s: %s"
+            WRMSG(HHC02203, "I", buf, cachepolicyname[cachepolicy[ix]]);
+        }
+        return 0;
+    }
+
+    for (ix = 0; ix < (int)_countof(cachename); ix++)
+        if (strcasecmp(argv[1], cachename[ix]) == 0)
+            break;
+    if (ix >= (int)_countof(cachename))
+    {
+        // "Invalid argument %s%s"
+        WRMSG(HHC02205, "E", argv[1], "");
+        return -1;
+    }
+
+    MSGBUF(buf, "%s policy", cachename[ix]);
+
+    if (argc < 3)
+    {
+        // "%-14s: %s"
+        WRMSG(HHC02203, "I", buf, cachepolicyname[cachepolicy[ix]]);
+        return 0;
+    }
+
+    for (policy = 0; policy < CACHE_POLICIES; policy++)
+        if (strcasecmp(argv[2], cachepolicyname[policy]) == 0)
+            break;
+    if (policy >= CACHE_POLICIES)
+    {
+        // "Invalid argument %s%s"
+        WRMSG(HHC02205, "E", argv[2], "");
+        return -1;
+    }
+
+    cache_setpolicy(ix, policy);
+
+    // "%-14s set to %s"
+    WRMSG(HHC02204, "I", buf, cachepolicyname[policy]);
+    return 0;
+}
+
 DLL_EXPORT int cachestats_cmd(int argc, char *argv[], char *cmdline)
 {
     int ix, i;
@@ -394,6 +553,9 @@ DLL_EXPORT int cachestats_cmd(int argc, char *argv[], char *cmdline)
         MSGBUF( buf, "Cache............ %10d", ix);
         WRMSG(HHC02294, "I", buf);
 
+        MSGBUF( buf, "policy .......... %10s", cachepolicyname[cacheblk[ix].policy]);
+        WRMSG(HHC02294, "I", buf);
+
         MSGBUF( buf, "nbr ............. %10d", cacheblk[ix].nbr);
         WRMSG(HHC02294, "I", buf);
 
@@ -424,9 +586,31 @@ DLL_EXPORT int cachestats_cmd(int argc, char *argv[], char *cmdline)
         MSGBUF( buf, "misses .......... %10"PRId64, cacheblk[ix].misses);
         WRMSG(HHC02294, "I", buf);
 
+        MSGBUF( buf, "hash probes ..... %10"PRId64, cacheblk[ix].probes);
+        WRMSG(HHC02294, "I", buf);
+
+        MSGBUF( buf, "clock sweeps .... %10"PRId64, cacheblk[ix].sweeps);
+        WRMSG(HHC02294, "I", buf);
+
         MSGBUF( buf, "hit%% ............ %10d", cache_hit_percent(ix));
         WRMSG(HHC02294, "I", buf);
 
+        for (i = 0; i < CACHE_POLICIES; i++)
+        {
+            S64 total = cacheblk[ix].phits[i] + cacheblk[ix].pmisses[i];
+            if (total == 0)
+                continue;
+            MSGBUF( buf, "hit%% %-5s ...... %10d", cachepolicyname[i],
+                (int)((cacheblk[ix].phits[i] * 100) / total));
+            WRMSG(HHC02294, "I", buf);
+        }
+
+        if (cacheblk[ix].policy == CACHE_POLICY_2Q)
+        {
+            MSGBUF( buf, "2Q A1in ......... %10d", cacheblk[ix].a1in);
+            WRMSG(HHC02294, "I", buf);
+        }
+
         MSGBUF( buf, "age ............. %10"PRId64, cacheblk[ix].age);
         WRMSG(HHC02294, "I", buf);
 
@@ -476,6 +660,9 @@ static int cache_destroy_locked (int ix)
 
             free (cacheblk[ix].cache);
         }
+        free (cacheblk[ix].hash);
+        free (cacheblk[ix].a1q);
+        free (cacheblk[ix].a1out);
     }
     memset(&cacheblk[ix], 0, sizeof(CACHEBLK));
     return 0;
@@ -506,6 +693,52 @@ static int cache_create_locked( int ix )
             errno, strerror(errno));
         return -1;
     }
+
+    /* Hash table with at least as many buckets as entries */
+    for (cacheblk[ix].hashbits = 1;
+         (1 << cacheblk[ix].hashbits) < cacheblk[ix].nbr;
+         cacheblk[ix].hashbits++);
+
+    cacheblk[ix].hash = calloc ((size_t)1 << cacheblk[ix].hashbits, sizeof(int));
+
+    if (cacheblk[ix].hash == NULL)
+    {
+        // "Function %s failed; cache %d size %d: [%02d] %s"
+        WRMSG (HHC00011, "E", "cache()", ix,
+            (int)((1 << cacheblk[ix].hashbits) * (int)sizeof(int)),
+            errno, strerror(errno));
+        free (cacheblk[ix].cache);
+        cacheblk[ix].cache = NULL;
+        return -1;
+    }
+
+    /* 2Q queues: the A1in FIFO may also hold stale slots for entries
+       that have since left A1in, and A1out is indexed like the hash
+       with unused slots set to CACHE_A1OUT_EMPTY since 0 is a key */
+    cacheblk[ix].a1qsize = 2 * cacheblk[ix].nbr;
+    cacheblk[ix].a1q = calloc (cacheblk[ix].a1qsize, sizeof(U64));
+    cacheblk[ix].a1out = malloc (((size_t)1 << cacheblk[ix].hashbits) * sizeof(U64));
+
+    if (cacheblk[ix].a1q == NULL || cacheblk[ix].a1out == NULL)
+    {
+        // "Function %s failed; cache %d size %d: [%02d] %s"
+        WRMSG (HHC00011, "E", "cache()", ix,
+            (int)((cacheblk[ix].a1qsize + (1 << cacheblk[ix].hashbits)) * (int)sizeof(U64)),
+            errno, strerror(errno));
+        free (cacheblk[ix].a1q);
+        free (cacheblk[ix].a1out);
+        free (cacheblk[ix].hash);
+        free (cacheblk[ix].cache);
+        cacheblk[ix].a1q = NULL;
+        cacheblk[ix].a1out = NULL;
+        cacheblk[ix].hash = NULL;
+        cacheblk[ix].cache = NULL;
+        return -1;
+    }
+    memset(cacheblk[ix].a1out, 0xFF,
+        ((size_t)1 << cacheblk[ix].hashbits) * sizeof(U64));
+
+    cacheblk[ix].policy = cachepolicy[ix];
     return 0;
 }
 
@@ -563,11 +796,106 @@ static int cache_isbusy(int ix, int i)
 
 static int cache_isempty(int ix, int i)
 {
-    return (cacheblk[ix].cache[i].key  == 0
+    return (!cacheblk[ix].cache[i].hashed
          && cacheblk[ix].cache[i].flag == 0
          && cacheblk[ix].cache[i].age  == 0);
 }
 
+static int cache_hashix(int ix, U64 key)
+{
+    /* Fibonacci hashing: the device number and track (or L2 table)
+       parts of a key both contribute to the high order bits */
+    return (int)((key * 0x9E3779B97F4A7C15ULL) >> (64 - cacheblk[ix].hashbits));
+}
+
+static void cache_hash(int ix, int i)
+{
+    int h = cache_hashix(ix, cacheblk[ix].cache[i].key);
+    cacheblk[ix].cache[i].hnext = cacheblk[ix].hash[h];
+    cacheblk[ix].hash[h] = i + 1;
+    cacheblk[ix].cache[i].hashed = 1;
+}
+
+static void cache_unhash(int ix, int i)
+{
+    int *p = &cacheblk[ix].hash[cache_hashix(ix, cacheblk[ix].cache[i].key)];
+
+    while (*p != 0 && *p != i + 1)
+        p = &cacheblk[ix].cache[*p - 1].hnext;
+    if (*p != 0)
+        *p = cacheblk[ix].cache[i].hnext;
+    cacheblk[ix].cache[i].hnext = 0;
+    cacheblk[ix].cache[i].hashed = 0;
+}
+
+static void cache_a1push(int ix, int i)
+{
+    int next = (cacheblk[ix].a1head + 1) % cacheblk[ix].a1qsize;
+
+    /* If the FIFO is full then its oldest slot is dropped; an entry
+       still in A1in at that point is moved to Am */
+    if (next == cacheblk[ix].a1tail)
+    {
+        U64 slot = cacheblk[ix].a1q[cacheblk[ix].a1tail];
+        if (cache_a1valid(ix, slot))
+        {
+            cacheblk[ix].cache[(U32)slot].seg = CACHE_SEG_AM;
+            cacheblk[ix].a1in--;
+        }
+        cacheblk[ix].a1tail = (cacheblk[ix].a1tail + 1) % cacheblk[ix].a1qsize;
+    }
+
+    cacheblk[ix].a1q[cacheblk[ix].a1head] =
+        ((U64)cacheblk[ix].cache[i].a1seq << 32) | (U32)i;
+    cacheblk[ix].a1head = next;
+}
+
+static int cache_a1valid(int ix, U64 slot)
+{
+    int i = (int)(U32)slot;
+    return (cacheblk[ix].cache[i].seg == CACHE_SEG_A1IN
+         && cacheblk[ix].cache[i].a1seq == (U32)(slot >> 32));
+}
+
+static int cache_a1victim(int ix)
+{
+    int i, n;
+    U64 slot;
+
+    /* Return the oldest A1in entry that is not busy.  Stale slots
+       are discarded and busy entries are requeued at the head. */
+    n = (cacheblk[ix].a1head - cacheblk[ix].a1tail + cacheblk[ix].a1qsize)
+      % cacheblk[ix].a1qsize;
+    for ( ; n > 0; n--)
+    {
+        slot = cacheblk[ix].a1q[cacheblk[ix].a1tail];
+        i = (int)(U32)slot;
+        if (cache_a1valid(ix, slot) && !cache_isbusy(ix, i))
+            return i;
+        cacheblk[ix].a1tail = (cacheblk[ix].a1tail + 1) % cacheblk[ix].a1qsize;
+        if (cache_a1valid(ix, slot))
+        {
+            cacheblk[ix].a1q[cacheblk[ix].a1head] = slot;
+            cacheblk[ix].a1head = (cacheblk[ix].a1head + 1) % cacheblk[ix].a1qsize;
+        }
+    }
+    return -1;
+}
+
+static void cache_policy_reset(int ix, int policy)
+{
+    int i;
+
+    /* All entries start out in Am under the new policy */
+    for (i = 0; i < cacheblk[ix].nbr; i++)
+        cacheblk[ix].cache[i].seg = CACHE_SEG_AM;
+    cacheblk[ix].a1in = 0;
+    cacheblk[ix].a1head = cacheblk[ix].a1tail = 0;
+    memset(cacheblk[ix].a1out, 0xFF,
+        ((size_t)1 << cacheblk[ix].hashbits) * sizeof(U64));
+    cacheblk[ix].policy = policy;
+}
+
 static void cache_allocbuf(int ix, int i, int len)
 {
     cacheblk[ix].cache[i].buf = calloc (len, 1);
@@ -24,11 +24,34 @@
       void     *buf;
       int       value;
       U64       age;
+      int       hnext;
+      BYTE      ref;
+      BYTE      seg;
+      BYTE      hashed;
+      U32       a1seq;
 
     The first 8 bits of the flag indicates if the entry is `busy' or
     not.  If any of the first 8 bits are non-zero then the entry is
     considered `busy' and will not be stolen or otherwise reused.
 
+    Entries that have been given a key, including a key of zero, are
+    chained from a hash table by `hnext' and have `hashed' set, so a
+    lookup examines only the entries whose keys hash to the same
+    bucket.  Entries to be stolen are chosen by a CLOCK
+    sweep: `ref' is set whenever an entry's age is set and cleared
+    as the clock hand passes over it, and the first entry found
+    that is not busy and not recently referenced is chosen.
+
+    Alternatively the scan resistant 2Q policy may be selected for a
+    cache.  A newly keyed entry is then placed on the probationary
+    FIFO queue `A1in' (`seg' CACHE_SEG_A1IN, queued with sequence
+    number `a1seq') unless its key was recently evicted from that
+    queue, in which case it goes directly to the main `Am' segment.
+    Entries are stolen from A1in while it holds more than a quarter
+    of the cache, and otherwise from Am using the CLOCK sweep, so a
+    single sequential pass only replaces probationary entries.  Keys
+    evicted from A1in are remembered in the `A1out' ghost table.
+
   APIs:
 
     General query functions:
@@ -65,8 +88,9 @@
 
      Notes        [0] `ix' identifies the cache.  This is an integer
                       and is reserved in `cache.h'
-                  [1] An empty entry contains a zero key value.
-                      A valid key should not be all zeroes
+                  [1] An empty entry has never been given a key
+                      (or has been released) and has no flags or age.
+                      A key of all zeroes is a valid key
                       (0x0000000000000000) or all ones
                       (0xffffffffffffffff).   All ones is used to
                       indicate an error circumstance.
@@ -133,8 +157,8 @@
       int         cache_lookup(int ix, U64 key, int *o);
                   Search cache `ix' for entry matching `key'.
                   If a non-NULL pointer `o' is provided, then the
-                  oldest or preferred cache entry index is returned
-                  that is available to be stolen.
+                  index of an empty or least recently used entry that
+                  is available to be stolen is returned.
 
       int         cache_scan (int ix, int (rtn)(), void *data);
                   Scan a cache routine entry by entry calling routine
@@ -158,6 +182,15 @@
                   Release the cache entry.  If flag is CACHE_FREEBUF
                   then the object buffer is also freed.
 
+      int         cache_getpolicy(int ix);
+                  Return the replacement policy for cache `ix'
+
+      int         cache_setpolicy(int ix, int policy);
+                  Set the replacement policy (CACHE_POLICY_CLOCK or
+                  CACHE_POLICY_2Q) for cache `ix'; the old policy is
+                  returned.  The setting persists if the cache is
+                  destroyed and later created again.
+
   -------------------------------------------------------------------*/
 
 #ifndef _HERCULES_CACHE_H
@@ -189,8 +222,25 @@ typedef struct _CACHE {                 /* Cache entry               */
       void     *buf;                    /* Buffer address            */
       int       value;                  /* Arbitrary value           */
       U64       age;                    /* Age                       */
+      int       hnext;                  /* Next entry in hash chain  */
+      BYTE      ref;                    /* 1=Referenced since the
+                                           clock hand last passed    */
+      BYTE      seg;                    /* 2Q segment                */
+      BYTE      hashed;                 /* 1=Key is in the hash table*/
+      U32       a1seq;                  /* A1in queue sequence       */
     } CACHE;
 
+/*-------------------------------------------------------------------*/
+/* Replacement policies                                              */
+/*-------------------------------------------------------------------*/
+#define CACHE_POLICY_CLOCK            0 /* CLOCK (approximate LRU)   */
+#define CACHE_POLICY_2Q               1 /* 2Q (scan resistant)       */
+#define CACHE_POLICIES                2 /* Number of policies        */
+
+#define CACHE_SEG_AM                  0 /* 2Q main segment           */
+#define CACHE_SEG_A1IN                1 /* 2Q probationary segment   */
+#define CACHE_A1OUT_EMPTY    ((U64)-1) /* Unused 2Q A1out slot      */
+
 /*-------------------------------------------------------------------*/
 /* Cache header                                                      */
 /*-------------------------------------------------------------------*/
@@ -205,10 +255,27 @@ typedef struct _CACHEBLK {              /* Cache header              */
       S64       hits;                   /* Number lookup hits        */
       S64       fasthits;               /* Number fast lookup hits   */
       S64       misses;                 /* Number lookup misses      */
+      S64       probes;                 /* Hash chain entries probed */
+      S64       sweeps;                 /* Clock hand advances       */
       U64       age;                    /* Age counter               */
       LOCK      lock;                   /* Lock                      */
       COND      waitcond;               /* Wait for available entry  */
       CACHE    *cache;                  /* Cache table address       */
+      int      *hash;                   /* Hash table: first entry
+                                           index + 1 for each bucket */
+      int       hashbits;               /* log2 of hash table size   */
+      int       hand;                   /* Clock hand                */
+      int       policy;                 /* Replacement policy        */
+      S64       phits[CACHE_POLICIES];  /* Lookup hits by policy     */
+      S64       pmisses[CACHE_POLICIES];/* Lookup misses by policy   */
+      U64      *a1q;                    /* 2Q A1in FIFO: a1seq << 32
+                                           | entry index             */
+      int       a1qsize;                /* A1in FIFO slots           */
+      int       a1head;                 /* A1in FIFO next slot       */
+      int       a1tail;                 /* A1in FIFO oldest slot     */
+      int       a1in;                   /* Entries in A1in segment   */
+      U32       a1seq;                  /* A1in sequence counter     */
+      U64      *a1out;                  /* 2Q A1out ghost keys       */
       time_t    atime;                  /* Time last adjustment      */
       time_t    wtime;                  /* Time last wait            */
       int       adjusts;                /* Number of adjustments     */
@@ -250,6 +317,7 @@ typedef struct _CACHEBLK {              /* Cache header              */
 /* Functions                                                         */
 /*-------------------------------------------------------------------*/
 CCH_DLL_IMPORT int cachestats_cmd(int argc, char *argv[], char *cmdline);
+CCH_DLL_IMPORT int cache_cmd(int argc, char *argv[], char *cmdline);
 
 int         cache_nbr(int ix);
 int         cache_busy(int ix);
@@ -279,6 +347,8 @@ int         cache_getlen(int ix, int i);
 int         cache_getval(int ix, int i);
 int         cache_setval(int ix, int i, int val);
 int         cache_release(int ix, int i, int flag);
+int         cache_getpolicy(int ix);
+int         cache_setpolicy(int ix, int policy);
 
 /*-------------------------------------------------------------------*/
 /* Specific cache definitions (until a better place is found)        */
@@ -296,6 +366,9 @@ int         cache_release(int ix, int i, int flag);
 #define   CCKD_CACHE_UPDATED 0x08000000 /* Buffer has been updated   */
 #define   CCKD_CACHE_WRITE   0x04000000 /* Entry pending write       */
 #define   CCKD_CACHE_USED    0x00800000 /* Entry has been used       */
+#define   CCKD_CACHE_RAHEAD  0x00400000 /* Entry read ahead by stream*/
+#define   CCKD_CACHE_RASTRM  0x00030000 /* Readahead stream index    */
+#define   CCKD_CACHE_RASHIFT         16 /* Shift for stream index    */
 
 #define   CKD_CACHE_ACTIVE   0x80000000 /* Active entry              */
 #define   FBA_CACHE_ACTIVE   0x80000000 /* Active entry              */
@@ -351,6 +424,13 @@ do { \
 #define SHRD_CACHE_SETKEY(_devnum, _trk) \
   ((U64)(((U64)(_devnum) << 32) | (U64)(_trk)))
 
+/*-------------------------------------------------------------------*/
+/* Number of CKD tracks or FBA block groups following one that is    */
+/* read sequentially that the host is advised to read ahead          */
+/*-------------------------------------------------------------------*/
+
+#define DEVBUF_HOST_RA          16
+
 /*-------------------------------------------------------------------*/
 /* L2 definitions                                                    */
 /*-------------------------------------------------------------------*/
@@ -34,6 +34,7 @@ typedef struct CCKD_L2ENT       CCKD_L2ENT;     // Level 2 table entry
 typedef struct CCKD_FREEBLK     CCKD_FREEBLK;   // Free block
 typedef struct CCKD_IFREEBLK    CCKD_IFREEBLK;  // Free block (internal)
 typedef struct CCKD_RA          CCKD_RA;        // Readahead queue entry
+typedef struct CCKD_RASTRM      CCKD_RASTRM;    // Readahead stream
 typedef struct CCKDBLK          CCKDBLK;        // Global CCKD dasd block
 typedef struct CCKD_EXT         CCKD_EXT;       // CCKD Extension block
 typedef struct SPCTAB           SPCTAB;         // Space table
@@ -100,12 +101,15 @@ struct CKD_RECHDR {                     /* Record header             */
 #define CKD_NULLTRK_SIZE1       (CKD_TRKHDR_SIZE + CKD_R0_SIZE + CKD_R0_DLEN                + CKD_ENDTRK_SIZE)
 #define CKD_NULLTRK_SIZE2       (CKD_TRKHDR_SIZE + CKD_R0_SIZE + CKD_R0_DLEN + (12 * (CKD_RECHDR_SIZE + CKD_NULL_FMT2_DLEN)) + CKD_ENDTRK_SIZE)
 
+#define CCKD_DICT_SIZE         416   /* Max preset dictionary size */
+
 /*-------------------------------------------------------------------*/
 /*     Structure definitions for Compressed CCKD/CFBA devices        */
 /*-------------------------------------------------------------------*/
 /*    NOTE: The num_L1tab, num_L2tab, cyls, cdh_size, cdh_used,      */
 /*    free_off, free_total, free_largest, free_num, free_imbed,      */
-/*    and cmp_parm fields are kept in LITTLE endian format.          */
+/*    cmp_parm, cdh_dictlen and cdh_dictid fields are kept in        */
+/*    LITTLE endian format.                                          */
 /*-------------------------------------------------------------------*/
 struct CCKD_DEVHDR                      /* Compress device header    */
 {
@@ -125,12 +129,27 @@ struct CCKD_DEVHDR                      /* Compress device header    */
 /* 44 */BYTE             cdh_nullfmt;   /* Null track format         */
 /* 45 */BYTE             cmp_algo;      /* Compression algorithm     */
 /* 46 */S16              cmp_parm;      /* Compression parameter     */
-/* 48 */BYTE             resv2[464];    /* Reserved                  */
+/* 48 */U16              cdh_dictlen;   /* Dictionary length         */
+/* 50 */BYTE             resv3[2];      /* Reserved                  */
+/* 52 */U32              cdh_dictid;    /* Dictionary adler32        */
+/* 56 */BYTE             cdh_dict[CCKD_DICT_SIZE]; /* zlib preset
+                                           dictionary, most useful
+                                           strings last              */
+/*472 */BYTE             resv2[40];     /* Reserved                  */
 };
 
 #define CCKD_VERSION           0
 #define CCKD_RELEASE           3
 #define CCKD_MODLVL            1
+#define CCKD_MODLVL_ZSTDLZ4    2     /* Image has zstd or lz4 tracks */
+#define CCKD_MODLVL_DICT       3     /* Image has zlib tracks compressed
+                                        with a preset dictionary     */
+#define CCKD_MODLVL_MAX        3     /* Highest modlvl supported     */
+
+/* Whether an image's version.release.modlvl can be processed        */
+#define CCKD_VRM_SUPPORTED( _vrm )                                    \
+    ((((_vrm)[0] << 16) | ((_vrm)[1] << 8) | (_vrm)[2])               \
+     <= ((CCKD_VERSION << 16) | (CCKD_RELEASE << 8) | CCKD_MODLVL_MAX))
 
 #define CCKD_OPT_BIGEND        0x02  /* file in BIG endian format    */
 #define CCKD_OPT_SPERRS        0x20  /* Space errors detected        */
@@ -140,7 +159,9 @@ struct CCKD_DEVHDR                      /* Compress device header    */
 #define CCKD_COMPRESS_NONE     0x00
 #define CCKD_COMPRESS_ZLIB     0x01
 #define CCKD_COMPRESS_BZIP2    0x02
-#define CCKD_COMPRESS_MASK     0x03
+#define CCKD_COMPRESS_ZSTD     0x04
+#define CCKD_COMPRESS_LZ4      0x08
+#define CCKD_COMPRESS_MASK     0x0F
 
 #define CCKD_STRESS_MINLEN     4096
 #if defined( HAVE_ZLIB )
@@ -181,15 +202,31 @@ struct CCKD_IFREEBLK {                  /* Free block (internal)     */
         int              ifb_idxprv;    /* Index to prev free blk    */
         int              ifb_idxnxt;    /* Index to next free blk    */
         int              ifb_pending;   /* 1=Free pending (don't use)*/
+        U32              ifb_off;       /* Offset this free blk      */
+        int              ifb_child[2][2]; /* Lower and higher child in
+                                           offset and size trees     */
+        int              ifb_sized;     /* 1=In the size tree        */
 };
 
 struct CCKD_RA {                        /* Readahead queue entry     */
         DEVBLK          *ra_dev;        /* Readahead device          */
         int              ra_trk;        /* Readahead track           */
+        int              ra_strm;       /* Readahead stream index    */
         int              ra_idxprv;     /* Index to prev entry       */
         int              ra_idxnxt;     /* Index to next entry       */
 };
 
+struct CCKD_RASTRM {                    /* Readahead stream          */
+        int              rs_last;       /* Last track read           */
+        int              rs_dir;        /* 1=Forward -1=Backward     */
+        int              rs_depth;      /* Tracks to read ahead      */
+        int              rs_high;       /* Farthest track read ahead */
+        unsigned int     rs_seq;        /* Sequential reads          */
+        unsigned int     rs_wasted;     /* Readaheads replaced unused*/
+        unsigned int     rs_checked;    /* rs_wasted at last read    */
+        unsigned int     rs_stamp;      /* Last use (0=Unused)       */
+};
+
 typedef  U32          CCKD_L1ENT;       /* Level 1 table entry       */
 typedef  CCKD_L1ENT   CCKD_L1TAB[];     /* Level 1 table             */
 typedef  CCKD_L2ENT   CCKD_L2TAB[256];  /* Level 2 table             */
@@ -213,6 +250,8 @@ typedef  char         CCKD_ITRACE[256]; /* Trace table entry         */
 /* Adjustable values */
 
 #define CCKD_IFB_ENTS_INCR     1024     /* ifb entries per (re)alloc */
+#define CCKD_FSP_OFFSET        0        /* Free space offset tree    */
+#define CCKD_FSP_SIZE          1        /* Free space size tree      */
 #define CCKD_FREE_MIN_SIZE     96       /* Minimum free space size   */
 #define CCKD_FREE_MIN_INCR     32       /* Added for each ifb incr   */
 
@@ -233,9 +272,12 @@ typedef  char         CCKD_ITRACE[256]; /* Trace table entry         */
 #define CCKD_DEF_RA            2        /* Def readahead threads     */
 #define CCKD_MAX_RA            9        /* Max readahead threads     */
 
+#define CCKD_RA_STREAMS        4        /* Readahead streams/device  */
+
 #define CCKD_MIN_WRITER        1        /* Min writer threads        */
 #define CCKD_DEF_WRITER        2        /* Def writer threads        */
 #define CCKD_MAX_WRITER        9        /* Max writer threads        */
+#define CCKD_WRQ_SIZE          16       /* Write queue size          */
 
 #define CCKD_MIN_GCOL          0        /* Min garbage collectors    */
 #define CCKD_DEF_GCOL          1        /* Def garbage collectors    */
@@ -249,6 +291,16 @@ typedef  char         CCKD_ITRACE[256]; /* Trace table entry         */
 #define CCKD_DEF_GCPARM        0        /* Def gcol adjustment parm  */
 #define CCKD_MAX_GCPARM       +8        /* max gcol adjustment parm  */
 
+#define CCKD_MIN_GCSTEP        0        /* Min gcol step time (ms)   */
+#define CCKD_DEF_GCSTEP        50       /* Def gcol step time (ms)   */
+#define CCKD_MAX_GCSTEP        1000     /* Max gcol step time (ms)   */
+
+#define CCKD_MIN_GCRATE        0        /* Min gcol i/o rate (KB/s)  */
+#define CCKD_DEF_GCRATE        0        /* Def gcol i/o rate (KB/s)  */
+#define CCKD_MAX_GCRATE        1048576  /* Max gcol i/o rate (KB/s)  */
+
+#define CCKD_LAT_BUCKETS       8        /* Latency histogram buckets */
+
 #define CCKD_DEF_NUM_TRACE     64       /* Def nbr of trace entries  */
 #define CCKD_MAX_NUM_TRACE     262144   /* Max nbr of trace entries  */
 
@@ -281,6 +333,10 @@ struct CCKDBLK {                        /* Global cckd dasd block    */
         int              gcmax;         /* Max garbage collectors    */
         int              gcint;         /* Wait time in seconds      */
         int              gcparm;        /* Adjustment parm           */
+        int              gcstep;        /* Step time limit (ms)      */
+        int              gcrate;        /* I/O budget (KB/s)         */
+        S64              gcbudget;      /* Bytes left in i/o budget  */
+        U64              gcrefill;      /* Time budget last refilled */
 
         LOCK             wrlock;        /* I/O lock                  */
         COND             wrcond;        /* I/O condition             */
@@ -290,6 +346,10 @@ struct CCKDBLK {                        /* Global cckd dasd block    */
         int              wra;           /* Number writer threads active  */
         int              wrmax;         /* Max writer threads        */
         int              wrprio;        /* Writer thread priority    */
+        int              wrq[CCKD_WRQ_SIZE]; /* Write queue: cache
+                                           entries oldest first      */
+        int              wrqn;          /* Write queue size          */
+        int              wrqx;          /* Next write queue entry    */
 
         LOCK             ralock;        /* Readahead lock            */
         COND             racond;        /* Readahead condition       */
@@ -321,6 +381,7 @@ struct CCKDBLK {                        /* Global cckd dasd block    */
         U64              stats_cachemisses;    /* Cache misses       */
         U64              stats_readaheads;     /* Readaheads         */
         U64              stats_readaheadmisses;/* Readahead misses   */
+        U64              stats_rauseful;       /* Readaheads used    */
         U64              stats_iowaits;        /* Waits for i/o      */
         U64              stats_cachewaits;     /* Waits for cache    */
         U64              stats_stresswrites;   /* Writes under stress*/
@@ -333,6 +394,16 @@ struct CCKDBLK {                        /* Global cckd dasd block    */
         U64              stats_writebytes;     /* Bytes written      */
         U64              stats_gcolmoves;      /* Spaces moved       */
         U64              stats_gcolbytes;      /* Bytes moved        */
+        U64              stats_wrscans;        /* Write queue scans  */
+        U64              stats_wrqueued;       /* Writes queued      */
+        U64              stats_wrskipped;      /* Queued not written */
+        S64              stats_compress;       /* Compressions       */
+        S64              stats_compbytes;      /* Bytes compressed   */
+        S64              stats_compout;        /* Bytes after compr. */
+        S64              stats_gclat[CCKD_LAT_BUCKETS]; /* Gcol file
+                                           lock hold times (atomic)  */
+        S64              stats_rdlat[CCKD_LAT_BUCKETS]; /* Track read
+                                           latencies (atomic)        */
 
         LOCK             trclock;       /* Internal trace table lock */
         CCKD_ITRACE     *itrace;        /* Internal trace table      */
@@ -396,12 +467,18 @@ struct CCKD_EXT {                       /* Ext for compressed ckd    */
         int              free_idxlast;  /* Index of last entry       */
         int              free_idxavail; /* Index of available entry  */
         unsigned int     free_minsize;  /* Minimum free space size   */
+        int              free_root[2];  /* Free space offset and
+                                           size tree roots           */
 
         int              lastsync;      /* Time of last sync         */
+        unsigned int     gcleft;        /* Kbytes left in gc cycle   */
 
         int              ralkup[CCKD_MAX_RA_SIZE];/* Lookup table    */
 
         int              ratrk;         /* Track to readahead        */
+        int              radir;         /* Readahead direction       */
+        CCKD_RASTRM      rastrm[CCKD_RA_STREAMS]; /* Readahead streams */
+        unsigned int     rastamp;       /* Readahead stream clock    */
         unsigned int     totreads;      /* Total nbr trk reads       */
         unsigned int     totwrites;     /* Total nbr trk writes      */
         unsigned int     totl2reads;    /* Total nbr l2 reads        */
@@ -411,6 +488,7 @@ struct CCKD_EXT {                       /* Ext for compressed ckd    */
         unsigned int     readaheads;    /* Number trks read ahead    */
         unsigned int     switches;      /* Number trk switches       */
         unsigned int     misses;        /* Number readahead misses   */
+        unsigned int     rauseful;      /* Number readaheads used    */
 
         int              fd[CCKD_MAX_SF+1];      /* File descriptors */
         BYTE             swapend[CCKD_MAX_SF+1]; /* Swap endian flag */
@@ -60,7 +60,8 @@ const   CKD_RECHDR   CKD_ENDTRK  =      /* END-OF-TRACK marker is a     \
 /*-------------------------------------------------------------------*/
 /*    NOTE: The num_L1tab, num_L2tab, cyls, cdh_size, cdh_used,      */
 /*    free_off, free_total, free_largest, free_num, free_imbed,      */
-/*    and cmp_parm fields are kept in LITTLE endian format.          */
+/*    cmp_parm, cdh_dictlen and cdh_dictid fields are kept in        */
+/*    LITTLE endian format.                                          */
 /*-------------------------------------------------------------------*/
 struct CCKD64_DEVHDR                    /* Compress device header    */
 {
@@ -80,7 +81,13 @@ struct CCKD64_DEVHDR                    /* Compress device header    */
 /* 72 */BYTE             cdh_nullfmt;   /* Null track format         */
 /* 73 */BYTE             cmp_algo;      /* Compression algorithm     */
 /* 74 */S16              cmp_parm;      /* Compression parameter     */
-/* 76 */BYTE             resv2[436];    /* Reserved                  */
+/* 76 */U16              cdh_dictlen;   /* Dictionary length         */
+/* 78 */BYTE             resv3[2];      /* Reserved                  */
+/* 80 */U32              cdh_dictid;    /* Dictionary adler32        */
+/* 84 */BYTE             cdh_dict[CCKD_DICT_SIZE]; /* zlib preset
+                                           dictionary, most useful
+                                           strings last              */
+/*500 */BYTE             resv2[12];     /* Reserved                  */
 };
 
 struct CCKD64_L2ENT {                   /* Level 2 table entry       */
@@ -115,6 +122,11 @@ struct CCKD64_IFREEBLK {                /* Free block (internal)     */
         int              ifb_idxnxt;    /* Index to next free blk    */
         int              ifb_pending;   /* 1=Free pending (don't use)*/
         int              ifb_pad;       /* (padding/reserved)        */
+        U64              ifb_off;       /* Offset this free blk      */
+        int              ifb_child[2][2]; /* Lower and higher child in
+                                           offset and size trees     */
+        int              ifb_sized;     /* 1=In the size tree        */
+        int              ifb_pad2;      /* (padding/reserved)        */
 };
 
 /*-------------------------------------------------------------------*/
@@ -185,12 +197,18 @@ struct CCKD64_EXT {                     /* Ext for compressed ckd    */
         int              free_idxlast;  /* Index of last entry       */
         int              free_idxavail; /* Index of available entry  */
         unsigned int     free_minsize;  /* Minimum free space size   */
+        int              free_root[2];  /* Free space offset and
+                                           size tree roots           */
 
         int              lastsync;      /* Time of last sync         */
+        unsigned int     gcleft;        /* Kbytes left in gc cycle   */
 
         int              ralkup[CCKD_MAX_RA_SIZE];/* Lookup table    */
 
         int              ratrk;         /* Track to readahead        */
+        int              radir;         /* Readahead direction       */
+        CCKD_RASTRM      rastrm[CCKD_RA_STREAMS]; /* Readahead streams */
+        unsigned int     rastamp;       /* Readahead stream clock    */
         unsigned int     totreads;      /* Total nbr trk reads       */
         unsigned int     totwrites;     /* Total nbr trk writes      */
         unsigned int     totl2reads;    /* Total nbr l2 reads        */
@@ -200,6 +218,7 @@ struct CCKD64_EXT {                     /* Ext for compressed ckd    */
         unsigned int     readaheads;    /* Number trks read ahead    */
         unsigned int     switches;      /* Number trk switches       */
         unsigned int     misses;        /* Number readahead misses   */
+        unsigned int     rauseful;      /* Number readaheads used    */
 
         int              fd[CCKD_MAX_SF+1];      /* File descriptors */
         BYTE             swapend[CCKD_MAX_SF+1]; /* Swap endian flag */
@@ -33,7 +33,10 @@ DISABLE_GCC_UNUSED_SET_WARNING;
 
 DLL_EXPORT  CCKDBLK  cckdblk;       /* cckd global area */
 
-char*         compname   [] = { "none", "zlib", "bzip2" };
+char*         compname   [] = { "none", "zlib", "bzip2", "?",
+                                "zstd", "?",    "?",     "?",
+                                "lz4",  "?",    "?",     "?",
+                                "?",    "?",    "?",     "?" };
 CCKD_L2ENT    empty_l2   [ CKD_NULLTRK_FMTMAX + 1 ][256] = {0};
 CCKD64_L2ENT  empty64_l2 [ CKD_NULLTRK_FMTMAX + 1 ][256] = {0};
 
@@ -86,6 +89,8 @@ int cckd_dasd_init( int argc, BYTE* argv[] )
     cckdblk.gcmax      = CCKD_DEF_GCOL;
     cckdblk.gcint      = CCKD_DEF_GCINT;
     cckdblk.gcparm     = CCKD_DEF_GCPARM;
+    cckdblk.gcstep     = CCKD_DEF_GCSTEP;
+    cckdblk.gcrate     = CCKD_DEF_GCRATE;
     cckdblk.readaheads = CCKD_DEF_READAHEADS;
     cckdblk.freepend   = CCKD_DEF_FREEPEND;
 
@@ -94,6 +99,12 @@ int cckd_dasd_init( int argc, BYTE* argv[] )
 #endif
 #if defined( CCKD_BZIP2 )
     cckdblk.comps     |= CCKD_COMPRESS_BZIP2;
+#endif
+#if defined( CCKD_ZSTD )
+    cckdblk.comps     |= CCKD_COMPRESS_ZSTD;
+#endif
+#if defined( CCKD_LZ4 )
+    cckdblk.comps     |= CCKD_COMPRESS_LZ4;
 #endif
     cckdblk.comp       = 0xff;
     cckdblk.compparm   = -1;
@@ -137,6 +148,8 @@ int cckd_dasd_init( int argc, BYTE* argv[] )
 /*-------------------------------------------------------------------*/
 void cckd_dasd_term_if_appropriate()
 {
+    int  ramax, gcmax, wrmax;           /* Saved maximum threads     */
+
     /* Check if it's time to terminate yet */
     obtain_lock( &cckdblk.devlock );
     {
@@ -153,36 +166,42 @@ void cckd_dasd_term_if_appropriate()
     /* Terminate all readahead threads... */
     obtain_lock( &cckdblk.ralock );
     {
+        ramax = cckdblk.ramax;
         cckdblk.ramax = 0;      /* signal   all threads to terminate */
         while (cckdblk.ras)     /* wait for all threads to terminate */
         {
             broadcast_condition( &cckdblk.racond );
             wait_condition( &cckdblk.termcond, &cckdblk.ralock );
         }
+        cckdblk.ramax = ramax;  /* allow restart for a later device  */
     }
     release_lock( &cckdblk.ralock );
 
     /* Terminate all garbage collection threads... */
     obtain_lock( &cckdblk.gclock );
     {
+        gcmax = cckdblk.gcmax;
         cckdblk.gcmax = 0;      /* signal   all threads to terminate */
         while (cckdblk.gcs)     /* wait for all threads to terminate */
         {
             broadcast_condition( &cckdblk.gccond );
             wait_condition( &cckdblk.termcond, &cckdblk.gclock );
         }
+        cckdblk.gcmax = gcmax;  /* allow restart for a later device  */
     }
     release_lock( &cckdblk.gclock );
 
     /* Terminate all writer threads... */
     obtain_lock( &cckdblk.wrlock );
     {
+        wrmax = cckdblk.wrmax;
         cckdblk.wrmax = 0;      /* signal   all threads to terminate */
         while (cckdblk.wrs)     /* wait for all threads to terminate */
         {
             broadcast_condition( &cckdblk.wrcond );
             wait_condition( &cckdblk.termcond, &cckdblk.wrlock );
         }
+        cckdblk.wrmax = wrmax;  /* allow restart for a later device  */
     }
     release_lock( &cckdblk.wrlock );
 
@@ -617,6 +636,10 @@ int             rc;                     /* Return code               */
     CCKD_TRACE( "file[%d] fd[%d] read, off 0x%16.16"PRIx64" len %d",
                 sfx, cckd->fd[ sfx ], off, len );
 
+#if !defined( _MSVC_ )
+    /* Read the data at the specified offset */
+    rc = pread( cckd->fd[ sfx ], buf, len, off );
+#else
     /* Seek to specified offset */
     if (lseek( cckd->fd[ sfx ], off, SEEK_SET ) < 0)
     {
@@ -629,6 +652,7 @@ int             rc;                     /* Return code               */
 
     /* Read the data */
     rc = read( cckd->fd[ sfx ], buf, len );
+#endif
     if (rc < (int)len)
     {
         if (rc < 0)
@@ -664,6 +688,10 @@ int             rc = 0;                 /* Return code               */
     CCKD_TRACE( "file[%d] fd[%d] write, off 0x%16.16"PRIx64" len %d",
                 sfx, cckd->fd[ sfx ], off, len );
 
+#if !defined( _MSVC_ )
+    /* Write the data at the specified offset */
+    rc = pwrite( cckd->fd[ sfx ], buf, len, off );
+#else
     /* Seek to specified offset */
     if (lseek( cckd->fd[ sfx ], off, SEEK_SET ) < 0)
     {
@@ -676,6 +704,7 @@ int             rc = 0;                 /* Return code               */
 
     /* Write the data */
     rc = write( cckd->fd[ sfx ], buf, len );
+#endif
     if (rc < (int)len)
     {
         if (rc < 0)
@@ -1174,11 +1203,15 @@ int             fnd;                    /* Cache index for hit       */
 int             lru;                    /* Oldest unused cache index */
 int             len;                    /* Length of track image     */
 int             maxlen;                 /* Length for buffer         */
-int             curtrk = -1;            /* Current track (at entry)  */
+int             radir;                  /* Readahead direction       */
+int             rastrm;                 /* Readahead stream index    */
+int             ran = 0;                /* Number tracks to readahead*/
+int             useful;                 /* 1=Hit was read ahead      */
 U16             devnum;                 /* Device number             */
 U32             oldtrk;                 /* Stolen track number       */
 U32             flag;                   /* Cache flag                */
 BYTE           *buf;                    /* Read buffer               */
+U64             rdstart;                /* Time read started         */
 
     if (dev->cckd64)
         return cckd64_read_trk( dev, trk, ra, unitstat );
@@ -1197,7 +1230,6 @@ BYTE           *buf;                    /* Read buffer               */
     /* Inactivate the old entry */
     if (!ra)
     {
-        curtrk = dev->bufcur;
         if (dev->cache >= 0)
             cache_setflag(CACHE_DEVBUF, dev->cache, ~CCKD_CACHE_ACTIVE, 0);
         dev->bufcur = dev->cache = -1;
@@ -1217,6 +1249,7 @@ cckd_read_trk_retry:
         }
 
         /* Mark the new entry active */
+        useful = !(cache_getflag(CACHE_DEVBUF, fnd) & CCKD_CACHE_USED);
         cache_setflag(CACHE_DEVBUF, fnd, ~0, CCKD_CACHE_ACTIVE | CCKD_CACHE_USED);
         cache_setage(CACHE_DEVBUF, fnd);
 
@@ -1237,6 +1270,10 @@ cckd_read_trk_retry:
 
         cckdblk.stats_switches++;  cckd->switches++;
         cckdblk.stats_cachehits++; cckd->cachehits++;
+        if (useful)
+        {
+            cckdblk.stats_rauseful++; cckd->rauseful++;
+        }
 
         /* if read/write is in progress then wait for it to finish */
         while (cache_getflag(CACHE_DEVBUF, fnd) & CCKD_CACHE_IOBUSY)
@@ -1254,11 +1291,13 @@ cckd_read_trk_retry:
                         ra, fnd, trk);
         }
 
+        ran = cckd_ra_stream (dev, trk, useful, &radir, &rastrm);
+
         release_lock (&cckd->cckdiolock);
 
         /* Asynchrously schedule readaheads */
-        if (curtrk > 0 && trk > curtrk && trk <= curtrk + 2)
-            cckd_readahead (dev, trk);
+        if (ran > 0)
+            cckd_readahead (dev, trk, radir, ran, rastrm);
 
         return fnd;
 
@@ -1294,10 +1333,9 @@ cckd_read_trk_retry:
     {
         CCKD_TRACE( "%d rdtrk[%d] %d dropping %4.4X:%d from cache",
                     ra, lru, trk, devnum, oldtrk);
-        if (!(cache_getflag(CACHE_DEVBUF, lru) & CCKD_CACHE_USED))
-        {
-            cckdblk.stats_readaheadmisses++;  cckd->misses++;
-        }
+        flag = cache_getflag(CACHE_DEVBUF, lru);
+        if ((flag & DEVBUF_TYPE_COMP) && !(flag & CCKD_CACHE_USED))
+            cckd_ra_wasted (devnum, flag);
     }
 
     /* Initialize the entry */
@@ -1320,19 +1358,26 @@ cckd_read_trk_retry:
 
     cache_unlock (CACHE_DEVBUF);
 
-    if (!ra) release_lock (&cckd->cckdiolock);
+    if (!ra)
+    {
+        ran = cckd_ra_stream (dev, trk, 0, &radir, &rastrm);
+        release_lock (&cckd->cckdiolock);
+    }
 
     /* Asynchronously schedule readaheads */
-    if (!ra && curtrk > 0 && trk > curtrk && trk <= curtrk + 2)
-        cckd_readahead (dev, trk);
+    if (ran > 0)
+        cckd_readahead (dev, trk, radir, ran, rastrm);
 
     /* Clear the buffer if batch mode */
     if (dev->batch) memset(buf, 0, maxlen);
 
     /* Read the track image */
+    rdstart = cckd_usecs();
     obtain_lock (&cckd->filelock);
     len = cckd_read_trkimg (dev, buf, trk, unitstat);
     release_lock (&cckd->filelock);
+    if (!ra)
+        cckd_lat_record (cckdblk.stats_rdlat, cckd_usecs() - rdstart);
     cache_setval (CACHE_DEVBUF, lru, len);
 
     obtain_lock (&cckd->cckdiolock);
@@ -1365,10 +1410,119 @@ cckd_read_trk_retry:
 
 } /* end function cckd_read_trk */
 
+/*-------------------------------------------------------------------*/
+/* Update readahead stream detection for a track read                */
+/*                                                                   */
+/* Returns the number of tracks to read ahead of `trk' and sets      */
+/* `dir' to the direction in which to read them and `strm' to the    */
+/* index of the stream.  `useful' is set if the track was found in   */
+/* the cache because it had been read ahead.  Called with cckdiolock */
+/* held.                                                             */
+/*-------------------------------------------------------------------*/
+int cckd_ra_stream (DEVBLK *dev, int trk, int useful, int *dir, int *strm)
+{
+CCKD_EXT       *cckd;                   /* -> cckd extension         */
+CCKD_RASTRM    *rs = NULL;              /* -> readahead stream       */
+int             i, d;                   /* Index, distance           */
+int             wasted;                 /* 1=Readahead was replaced  */
+
+    cckd = dev->cckd_ext;
+    *dir = *strm = 0;
+
+    if (cckdblk.ramax < 1 || cckdblk.readaheads < 1)
+        return 0;
+
+    /* Find the stream this track continues */
+    for (i = 0; i < CCKD_RA_STREAMS; i++)
+    {
+        if (!cckd->rastrm[i].rs_stamp)
+            continue;
+        d = trk - cckd->rastrm[i].rs_last;
+        if (d == 0)
+        {
+            cckd->rastrm[i].rs_stamp = ++cckd->rastamp;
+            return 0;
+        }
+        if (cckd->rastrm[i].rs_dir ? (d * cckd->rastrm[i].rs_dir >= 1
+                                   && d * cckd->rastrm[i].rs_dir <= 2)
+                                   : (d >= -2 && d <= 2))
+        {
+            rs = &cckd->rastrm[i];
+            break;
+        }
+    }
+
+    /* Otherwise start a new stream in place of the least recent */
+    if (rs == NULL)
+    {
+        rs = &cckd->rastrm[0];
+        for (i = 1; i < CCKD_RA_STREAMS; i++)
+            if (cckd->rastrm[i].rs_stamp < rs->rs_stamp)
+                rs = &cckd->rastrm[i];
+        memset (rs, 0, sizeof(CCKD_RASTRM));
+        rs->rs_last = rs->rs_high = trk;
+        rs->rs_stamp = ++cckd->rastamp;
+        return 0;
+    }
+
+    if (!rs->rs_dir)
+        rs->rs_dir = d > 0 ? 1 : -1;
+    rs->rs_last = trk;
+    rs->rs_seq++;
+    rs->rs_stamp = ++cckd->rastamp;
+
+    /* Double the depth while readaheads are being used; halve it if
+       tracks it read ahead have been replaced without being used */
+    wasted = rs->rs_wasted != rs->rs_checked;
+    rs->rs_checked = rs->rs_wasted;
+    if (wasted && rs->rs_depth)
+        rs->rs_depth = rs->rs_depth > 1 ? rs->rs_depth / 2 : 1;
+    else if (useful)
+        rs->rs_depth = rs->rs_depth ? rs->rs_depth * 2 : 1;
+    else if (!rs->rs_depth)
+        rs->rs_depth = 1;
+    if (rs->rs_depth > cckdblk.readaheads)
+        rs->rs_depth = cckdblk.readaheads;
+
+    rs->rs_high = trk + rs->rs_dir * rs->rs_depth;
+    *dir = rs->rs_dir;
+    *strm = (int)(rs - cckd->rastrm);
+    return rs->rs_depth;
+
+} /* end function cckd_ra_stream */
+
+/*-------------------------------------------------------------------*/
+/* Count a track read ahead and replaced in the cache unused         */
+/*                                                                   */
+/* `devnum' and `flag' are the key device number and the flag of the */
+/* replaced cache entry, which may belong to another device.  The    */
+/* miss is charged to that device and, if the entry was tagged by    */
+/* the readahead thread, to the stream that read it ahead.  Called   */
+/* with the cache lock held.                                         */
+/*-------------------------------------------------------------------*/
+void cckd_ra_wasted (U16 devnum, U32 flag)
+{
+DEVBLK         *dev;                    /* -> replaced entry device  */
+CCKD_EXT       *cckd;                   /* -> cckd extension         */
+
+    cckdblk.stats_readaheadmisses++;
+
+    if ((dev = cckd_find_device_by_devnum (devnum)) == NULL)
+        return;
+
+    /* (rastrm and misses are at the same offsets in CCKD64_EXT) */
+    cckd = dev->cckd_ext;
+    cckd->misses++;
+    if (flag & CCKD_CACHE_RAHEAD)
+        cckd->rastrm[(flag & CCKD_CACHE_RASTRM) >> CCKD_CACHE_RASHIFT]
+            .rs_wasted++;
+
+} /* end function cckd_ra_wasted */
+
 /*-------------------------------------------------------------------*/
 /* Schedule asynchronous readaheads                                  */
 /*-------------------------------------------------------------------*/
-void cckd_readahead (DEVBLK *dev, int trk)
+void cckd_readahead (DEVBLK *dev, int trk, int dir, int n, int strm)
 {
 CCKD_EXT       *cckd;                   /* -> cckd extension         */
 int             i, r;                   /* Indexes                   */
@@ -1379,12 +1533,15 @@ int             rc;
 
     if (cckdblk.ramax < 1 || cckdblk.readaheads < 1)
         return;
+    if (n > cckdblk.readaheads)
+        n = cckdblk.readaheads;
 
     obtain_lock (&cckdblk.ralock);
 
     /* Scan the cache to see if the tracks are already there */
     memset( cckd->ralkup, 0, sizeof(cckd->ralkup) );
     cckd->ratrk = trk;
+    cckd->radir = dir;
     cache_lock(CACHE_DEVBUF);
     cache_scan(CACHE_DEVBUF, cckd_readahead_scan, dev);
     cache_unlock(CACHE_DEVBUF);
@@ -1393,16 +1550,16 @@ int             rc;
     for (r = cckdblk.ra1st; r >= 0; r = cckdblk.ra[r].ra_idxnxt)
         if (cckdblk.ra[r].ra_dev == dev)
         {
-            i = cckdblk.ra[r].ra_trk - trk;
-            if (i > 0 && i <= cckdblk.readaheads)
+            i = (cckdblk.ra[r].ra_trk - trk) * dir;
+            if (i > 0 && i <= n)
                 cckd->ralkup[i-1] = 1;
         }
 
     /* Queue the tracks to the readahead queue */
-    for (i = 1; i <= cckdblk.readaheads && cckdblk.rafree >= 0; i++)
+    for (i = 1; i <= n && cckdblk.rafree >= 0; i++)
     {
         if (cckd->ralkup[i-1]) continue;
-        if (trk + i >= dev->ckdtrks) break;
+        if (trk + dir * i < 0 || trk + dir * i >= dev->ckdtrks) break;
         r = cckdblk.rafree;
         cckdblk.rafree = cckdblk.ra[r].ra_idxnxt;
         if (cckdblk.ralast < 0)
@@ -1417,7 +1574,8 @@ int             rc;
             cckdblk.ra[r].ra_idxnxt = -1;
             cckdblk.ralast = r;
         }
-        cckdblk.ra[r].ra_trk = trk + i;
+        cckdblk.ra[r].ra_trk = trk + dir * i;
+        cckdblk.ra[r].ra_strm = strm;
         cckdblk.ra[r].ra_dev = dev;
     }
 
@@ -1472,7 +1630,7 @@ int             k;                      /* Index                     */
     CCKD_CACHE_GETKEY(i, devnum, trk);
     if (devnum == dev->devnum)
     {
-        k = (int)trk - cckd->ratrk;
+        k = ((int)trk - cckd->ratrk) * cckd->radir;
         if (k > 0 && k <= cckdblk.readaheads)
             cckd->ralkup[k-1] = 1;
     }
@@ -1487,8 +1645,10 @@ void* cckd_ra (void* arg)
 CCKD_EXT       *cckd;                   /* -> cckd extension         */
 DEVBLK         *dev;                    /* Readahead devblk          */
 int             trk;                    /* Readahead track           */
+int             strm;                   /* Readahead stream index    */
 int             ra;                     /* Readahead index           */
 int             r;                      /* Readahead queue index     */
+int             i;                      /* Cache index               */
 TID             tid;                    /* Readahead thread id       */
 char            threadname[40];
 int             rc;
@@ -1543,6 +1703,7 @@ int             ras;
 
         r = cckdblk.ra1st;
         trk = cckdblk.ra[r].ra_trk;
+        strm = cckdblk.ra[r].ra_strm;
         dev = cckdblk.ra[r].ra_dev;
 
         cckd = dev->cckd_ext;
@@ -1594,7 +1755,16 @@ int             ras;
         release_lock (&cckdblk.ralock);
         {
             /* Read the readahead track */
-            cckd_read_trk (dev, trk, ra, NULL);
+            i = cckd_read_trk (dev, trk, ra, NULL);
+
+            /* Tag it with its stream unless it was used meanwhile */
+            cache_lock (CACHE_DEVBUF);
+            if (i >= 0
+             && cache_getkey(CACHE_DEVBUF, i) == CCKD_CACHE_SETKEY(dev->devnum, trk)
+             && !(cache_getflag(CACHE_DEVBUF, i) & CCKD_CACHE_USED))
+                cache_setflag(CACHE_DEVBUF, i, ~CCKD_CACHE_RASTRM,
+                              CCKD_CACHE_RAHEAD | (strm << CCKD_CACHE_RASHIFT));
+            cache_unlock (CACHE_DEVBUF);
         }
         obtain_lock (&cckdblk.ralock);
 
@@ -1819,10 +1989,10 @@ int             wrs;
             cckdblk.wrwaiting--;
         }
 
-        /* Scan the cache for the oldest pending write */
+        /* Get the oldest pending write from the write queue */
         cache_lock( CACHE_DEVBUF );
         {
-            o = cache_scan( CACHE_DEVBUF, cckd_writer_scan, NULL );
+            o = cckd_writer_next();
 
             /* Possibly shutting down if no writes pending */
             if (o < 0)
@@ -1903,19 +2073,77 @@ int             wrs;
     return NULL;
 } /* end thread cckd_writer */
 
+/*-------------------------------------------------------------------*/
+/* cckd writer thread helper:   get the next pending write           */
+/*-------------------------------------------------------------------*/
+/* Rather than scanning the whole cache for each track to be         */
+/* written, a single scan queues the CCKD_WRQ_SIZE oldest pending    */
+/* writes.  The writer threads then take entries from the queue in   */
+/* order, compressing them in parallel, and the cache is only        */
+/* scanned again once the queue is exhausted.  An entry which is no  */
+/* longer pending write when it is taken from the queue (because it  */
+/* was updated again in the meantime) is skipped.                    */
+/*                                                                   */
+/* Both cckdblk.wrlock and the cache lock must be held.              */
+/*-------------------------------------------------------------------*/
+int cckd_writer_next()
+{
+int             o;                      /* Cache entry               */
+
+    while (1)
+    {
+        /* Refill the write queue if it is empty */
+        if (cckdblk.wrqx >= cckdblk.wrqn)
+        {
+            cckdblk.wrqn = cckdblk.wrqx = 0;
+            cache_scan( CACHE_DEVBUF, cckd_writer_scan, NULL );
+            cckdblk.stats_wrscans++;
+            cckdblk.stats_wrqueued += cckdblk.wrqn;
+
+            if (!cckdblk.wrqn)
+                return -1;
+        }
+
+        o = cckdblk.wrq[ cckdblk.wrqx++ ];
+
+        if (cache_getflag( CACHE_DEVBUF, o ) & CCKD_CACHE_WRITE)
+            return o;
+
+        cckdblk.stats_wrskipped++;
+    }
+}
+
 int cckd_writer_scan( int* o, int ix, int i, void* data )
 {
+int             n;                      /* Insertion index           */
+U64             age;                    /* Age of this entry         */
+
+    UNREFERENCED( o );
     UNREFERENCED( data );
 
     if (1
         && (cache_getflag( ix, i ) & DEVBUF_TYPE_COMP)
         && (cache_getflag( ix, i ) & CCKD_CACHE_WRITE)
-        && (0
-            || *o == -1
-            || cache_getage( ix, i ) < cache_getage( ix, *o )
-           )
     )
-        *o = i;
+    {
+        /* Keep the oldest entries in the queue, oldest first */
+        age = cache_getage( ix, i );
+        n = cckdblk.wrqn;
+
+        if (n >= CCKD_WRQ_SIZE)
+        {
+            if (age >= cache_getage( ix, cckdblk.wrq[ n-1 ] ))
+                return 0;
+            n--;
+        }
+        else
+            cckdblk.wrqn++;
+
+        for (; n > 0 && cache_getage( ix, cckdblk.wrq[ n-1 ] ) > age; n--)
+            cckdblk.wrq[ n ] = cckdblk.wrq[ n-1 ];
+
+        cckdblk.wrq[ n ] = i;
+    }
 
     return 0;
 }
@@ -1936,6 +2164,7 @@ BYTE*           bufp;                   /* Buffer to be written      */
 int             len, bufl;              /* Buffer lengths            */
 int             comp;                   /* Compression algorithm     */
 int             parm;                   /* Compression parameter     */
+BYTE            modlvl;                 /* Header modlvl needed      */
 U32             flag;                   /* Cache flag                */
 BYTE            buf2[ 64*1024 ];        /* 64K Compress buffer       */
 
@@ -1953,9 +2182,13 @@ BYTE            buf2[ 64*1024 ];        /* 64K Compress buffer       */
     buf  = cache_getbuf( CACHE_DEVBUF, o, 0 );
     len  = cckd_trklen( dev, buf );
 
-    comp = len < CCKD_COMPRESS_MIN ? CCKD_COMPRESS_NONE :
-         cckdblk.comp == 0xff ? cckd->cdevhdr[ cckd->sfn ].cmp_algo
-                              : cckdblk.comp;
+    comp = cckdblk.comp == 0xff ? cckd->cdevhdr[ cckd->sfn ].cmp_algo
+                                : cckdblk.comp;
+
+    /* Small images are only worth compressing with a dictionary */
+    if (len < CCKD_COMPRESS_MIN
+        && !(comp == CCKD_COMPRESS_ZLIB && cckd->cdevhdr[ cckd->sfn ].cdh_dictlen))
+        comp = CCKD_COMPRESS_NONE;
 
     parm = cckdblk.compparm < 0 ? cckd->cdevhdr[ cckd->sfn ].cmp_parm
                                 : cckdblk.compparm;
@@ -2009,6 +2242,26 @@ BYTE            buf2[ 64*1024 ];        /* 64K Compress buffer       */
             cckd_write_chdr( dev );
         }
 
+        /* Older releases cannot read zstd or lz4 track images, nor
+           zlib track images compressed with a preset dictionary */
+        modlvl = CCKD_MODLVL;
+        if (bufl > CKD_NULLTRK_FMTMAX)
+        {
+            if (bufp[0] & (CCKD_COMPRESS_ZSTD | CCKD_COMPRESS_LZ4))
+                modlvl = CCKD_MODLVL_ZSTDLZ4;
+            else if (1
+                && (bufp[0] & CCKD_COMPRESS_ZLIB)
+                && bufl > CKD_TRKHDR_SIZE + 1
+                && (bufp[ CKD_TRKHDR_SIZE + 1 ] & 0x20)  /* FDICT */
+            )
+                modlvl = CCKD_MODLVL_DICT;
+        }
+        if (cckd->cdevhdr[ cckd->sfn ].cdh_vrm[2] < modlvl)
+        {
+            cckd->cdevhdr[ cckd->sfn ].cdh_vrm[2] = modlvl;
+            cckd_write_chdr( dev );
+        }
+
         /* Write the track image */
         cckd_write_trkimg( dev, bufp, bufl, trk, CCKD_SIZE_ANY );
     }
@@ -2159,6 +2412,263 @@ off_t           fpos;
 } /* end function cckd_chk_space */
 #endif // defined( DEBUG_FREESPACE )
 
+/*-------------------------------------------------------------------*/
+/* Free space index                                                  */
+/*                                                                   */
+/* The free space chain is kept in file offset order, the order in   */
+/* which it is written to the file.  So that the chain need not be   */
+/* searched from the start whenever space is obtained or released,   */
+/* two trees are kept over its entries.  The offset tree holds every */
+/* free space keyed by its offset and is used to find where a        */
+/* released space belongs in the chain.  The size tree holds the     */
+/* free spaces that are not pending keyed by length and then offset, */
+/* and is used to find the free space that best fits a request and   */
+/* the largest free space.  Both are treaps, balanced by a priority  */
+/* derived from the entry index.  The trees are built when the free  */
+/* space is read and are not written to the file.                    */
+/*-------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------*/
+/* Return the treap priority of free space entry `i'                 */
+/*-------------------------------------------------------------------*/
+static U32 cckd_fsp_pri(int i)
+{
+U32             x;                      /* Hash value                */
+
+    x = (U32)i * 0x9E3779B1;
+    x ^= x >> 16;
+    x *= 0x85EBCA6B;
+    x ^= x >> 13;
+    return x;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return whether free space `i' goes before `t' in tree `k'         */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_before(CCKD_IFREEBLK *ifb, int k, int i, int t)
+{
+    if (k == CCKD_FSP_SIZE && ifb[i].ifb_len != ifb[t].ifb_len)
+        return ifb[i].ifb_len < ifb[t].ifb_len;
+    return ifb[i].ifb_off < ifb[t].ifb_off;
+}
+
+/*-------------------------------------------------------------------*/
+/* Insert free space `i' into the subtree of tree `k' rooted at `t'  */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_ins(CCKD_IFREEBLK *ifb, int k, int t, int i)
+{
+int             d;                      /* Direction (0=lower)       */
+int             c;                      /* Child to rotate up        */
+
+    if (t < 0)
+    {
+        ifb[i].ifb_child[k][0] = ifb[i].ifb_child[k][1] = -1;
+        return i;
+    }
+
+    d = !cckd_fsp_before(ifb, k, i, t);
+    c = ifb[t].ifb_child[k][d] = cckd_fsp_ins(ifb, k, ifb[t].ifb_child[k][d], i);
+    if (cckd_fsp_pri(c) > cckd_fsp_pri(t))
+    {
+        ifb[t].ifb_child[k][d] = ifb[c].ifb_child[k][!d];
+        ifb[c].ifb_child[k][!d] = t;
+        return c;
+    }
+    return t;
+}
+
+/*-------------------------------------------------------------------*/
+/* Join subtrees `a' and `b' of tree `k', all of `a' before `b'      */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_join(CCKD_IFREEBLK *ifb, int k, int a, int b)
+{
+    if (a < 0) return b;
+    if (b < 0) return a;
+
+    if (cckd_fsp_pri(a) > cckd_fsp_pri(b))
+    {
+        ifb[a].ifb_child[k][1] = cckd_fsp_join(ifb, k, ifb[a].ifb_child[k][1], b);
+        return a;
+    }
+    ifb[b].ifb_child[k][0] = cckd_fsp_join(ifb, k, a, ifb[b].ifb_child[k][0]);
+    return b;
+}
+
+/*-------------------------------------------------------------------*/
+/* Remove free space `i' from the subtree of tree `k' rooted at `t'  */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_del(CCKD_IFREEBLK *ifb, int k, int t, int i)
+{
+int             d;                      /* Direction (0=lower)       */
+
+    if (t < 0)
+        return t;
+    if (t == i)
+        return cckd_fsp_join(ifb, k, ifb[t].ifb_child[k][0], ifb[t].ifb_child[k][1]);
+    d = !cckd_fsp_before(ifb, k, i, t);
+    ifb[t].ifb_child[k][d] = cckd_fsp_del(ifb, k, ifb[t].ifb_child[k][d], i);
+    return t;
+}
+
+/*-------------------------------------------------------------------*/
+/* Add or remove a free space in the offset tree                     */
+/*-------------------------------------------------------------------*/
+static void cckd_fsp_off_add(CCKD_EXT *cckd, int i)
+{
+    cckd->free_root[CCKD_FSP_OFFSET] = cckd_fsp_ins(cckd->ifb,
+        CCKD_FSP_OFFSET, cckd->free_root[CCKD_FSP_OFFSET], i);
+}
+
+static void cckd_fsp_off_del(CCKD_EXT *cckd, int i)
+{
+    cckd->free_root[CCKD_FSP_OFFSET] = cckd_fsp_del(cckd->ifb,
+        CCKD_FSP_OFFSET, cckd->free_root[CCKD_FSP_OFFSET], i);
+}
+
+/*-------------------------------------------------------------------*/
+/* Add a free space to the size tree if it is not pending, or        */
+/* remove it.  The length and offset must not change in between.     */
+/*-------------------------------------------------------------------*/
+static void cckd_fsp_size_add(CCKD_EXT *cckd, int i)
+{
+    if ((cckd->ifb[i].ifb_sized = !cckd->ifb[i].ifb_pending))
+        cckd->free_root[CCKD_FSP_SIZE] = cckd_fsp_ins(cckd->ifb,
+            CCKD_FSP_SIZE, cckd->free_root[CCKD_FSP_SIZE], i);
+}
+
+static void cckd_fsp_size_del(CCKD_EXT *cckd, int i)
+{
+    if (cckd->ifb[i].ifb_sized)
+        cckd->free_root[CCKD_FSP_SIZE] = cckd_fsp_del(cckd->ifb,
+            CCKD_FSP_SIZE, cckd->free_root[CCKD_FSP_SIZE], i);
+    cckd->ifb[i].ifb_sized = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the last free space before offset `pos', or -1             */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_prev(CCKD_EXT *cckd, U32 pos)
+{
+int             t, p = -1;              /* Free space indexes        */
+
+    for (t = cckd->free_root[CCKD_FSP_OFFSET]; t >= 0; )
+    {
+        if (cckd->ifb[t].ifb_off < pos)
+        {
+            p = t;
+            t = cckd->ifb[t].ifb_child[CCKD_FSP_OFFSET][1];
+        }
+        else
+            t = cckd->ifb[t].ifb_child[CCKD_FSP_OFFSET][0];
+    }
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/* Find the free space that best fits `len' bytes                    */
+/*                                                                   */
+/* A free space fits if it is exactly `len' bytes or if it leaves    */
+/* room for a free block after `len' bytes.  The smallest fitting    */
+/* free space at or above the level 2 table bounds is chosen, the    */
+/* lowest in the file if there are several.  Returns -1 if none.     */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_best(CCKD_EXT *cckd, U32 len)
+{
+CCKD_IFREEBLK  *ifb = cckd->ifb;        /* -> free space entries     */
+int             t, best;                /* Free space indexes        */
+U32             minlen;                 /* Minimum length            */
+U64             minoff;                 /* Minimum offset at minlen  */
+
+    minlen = len;
+    minoff = cckd->L2_bounds;
+    for ( ; ; )
+    {
+        /* Find the first free space at or after (minlen, minoff) */
+        best = -1;
+        for (t = cckd->free_root[CCKD_FSP_SIZE]; t >= 0; )
+        {
+            if (ifb[t].ifb_len > minlen
+             || (ifb[t].ifb_len == minlen && ifb[t].ifb_off >= minoff))
+            {
+                best = t;
+                t = ifb[t].ifb_child[CCKD_FSP_SIZE][0];
+            }
+            else
+                t = ifb[t].ifb_child[CCKD_FSP_SIZE][1];
+        }
+        if (best < 0)
+            return -1;
+
+        /* Skip lengths that leave no room for a free block, and
+           free spaces of this length below the level 2 bounds */
+        if (ifb[best].ifb_len != len
+         && ifb[best].ifb_len < len + CCKD_FREEBLK_SIZE)
+            minlen = len + CCKD_FREEBLK_SIZE;
+        else if (ifb[best].ifb_off < cckd->L2_bounds)
+            minlen = ifb[best].ifb_len;
+        else
+            return best;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the largest free space that is not pending                 */
+/*-------------------------------------------------------------------*/
+static U32 cckd_fsp_largest(CCKD_EXT *cckd)
+{
+int             t;                      /* Free space index          */
+
+    if ((t = cckd->free_root[CCKD_FSP_SIZE]) < 0)
+        return 0;
+    while (cckd->ifb[t].ifb_child[CCKD_FSP_SIZE][1] >= 0)
+        t = cckd->ifb[t].ifb_child[CCKD_FSP_SIZE][1];
+    return cckd->ifb[t].ifb_len;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the number of free spaces in the subtree of tree `k'       */
+/* rooted at `t', or -1 if the subtree is out of order               */
+/*-------------------------------------------------------------------*/
+static int cckd_fsp_count(CCKD_IFREEBLK *ifb, int k, int t)
+{
+int             l, h;                   /* Lower, higher counts      */
+
+    if (t < 0)
+        return 0;
+    l = ifb[t].ifb_child[k][0];
+    h = ifb[t].ifb_child[k][1];
+    if ((l >= 0 && !cckd_fsp_before(ifb, k, l, t))
+     || (h >= 0 && !cckd_fsp_before(ifb, k, t, h)))
+        return -1;
+    if ((l = cckd_fsp_count(ifb, k, l)) < 0
+     || (h = cckd_fsp_count(ifb, k, h)) < 0)
+        return -1;
+    return l + h + 1;
+}
+
+/*-------------------------------------------------------------------*/
+/* Build the free space index from the free space chain              */
+/*-------------------------------------------------------------------*/
+void cckd_fsp_build(DEVBLK *dev)
+{
+CCKD_EXT       *cckd;                   /* -> cckd extension         */
+U32             fpos;                   /* Free space offset         */
+int             i;                      /* Free space index          */
+
+    cckd = dev->cckd_ext;
+
+    cckd->free_root[CCKD_FSP_OFFSET] = cckd->free_root[CCKD_FSP_SIZE] = -1;
+
+    fpos = cckd->cdevhdr[cckd->sfn].free_off;
+    for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
+    {
+        cckd->ifb[i].ifb_off = fpos;
+        cckd_fsp_off_add(cckd, i);
+        cckd_fsp_size_add(cckd, i);
+        fpos = cckd->ifb[i].ifb_offnxt;
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /* Get file space                                                    */
 /*-------------------------------------------------------------------*/
@@ -2220,20 +2730,24 @@ cckd_get_space_atend:
         return fpos;
     }
 
-    /* Scan free space chain */
-    fpos = (off_t)cckd->cdevhdr[sfx].free_off;
-    for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
+    /* Level 2 tables go in the first free space that fits, keeping
+       them towards the beginning of the file; track images go in
+       the free space that fits best */
+    if (flags & CCKD_L2SPACE)
     {
-        if (cckd->ifb[i].ifb_pending == 0
-         && (len2 <= (int)cckd->ifb[i].ifb_len || len == (int)cckd->ifb[i].ifb_len)
-         && ((flags & CCKD_L2SPACE) || (U64)fpos >= cckd->L2_bounds))
-            break;
-        fpos = (off_t)cckd->ifb[i].ifb_offnxt;
+        for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
+            if (cckd->ifb[i].ifb_pending == 0
+             && (len2 <= (int)cckd->ifb[i].ifb_len || len == (int)cckd->ifb[i].ifb_len))
+                break;
     }
+    else
+        i = cckd_fsp_best (cckd, len);
 
     /* This can happen if largest comes before L2_bounds */
     if (i < 0) goto cckd_get_space_atend;
 
+    fpos = (off_t)cckd->ifb[i].ifb_off;
+
     flen = cckd->ifb[i].ifb_len;
     p = cckd->ifb[i].ifb_idxprv;
     n = cckd->ifb[i].ifb_idxnxt;
@@ -2246,17 +2760,21 @@ cckd_get_space_atend:
         *size = (int)flen;
 
     /* Remove the new space from free space */
+    cckd_fsp_size_del (cckd, i);
     if (*size < (int)flen)
     {
         cckd->ifb[i].ifb_len -= *size;
+        cckd->ifb[i].ifb_off += *size;
         if (p >= 0)
             cckd->ifb[p].ifb_offnxt += *size;
         else
             cckd->cdevhdr[sfx].free_off += *size;
+        cckd_fsp_size_add (cckd, i);
     }
     else
     {
         cckd->cdevhdr[sfx].free_num--;
+        cckd_fsp_off_del (cckd, i);
 
         /* Remove the free space entry from the chain */
         if (p >= 0)
@@ -2282,14 +2800,7 @@ cckd_get_space_atend:
 
     /* Find the largest free space if we got the largest */
     if (flen >= cckd->cdevhdr[sfx].free_largest)
-    {
-        int i;
-        cckd->cdevhdr[sfx].free_largest = 0;
-        for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
-            if (cckd->ifb[i].ifb_len > cckd->cdevhdr[sfx].free_largest
-             && cckd->ifb[i].ifb_pending == 0)
-                cckd->cdevhdr[sfx].free_largest = cckd->ifb[i].ifb_len;
-    }
+        cckd->cdevhdr[sfx].free_largest = cckd_fsp_largest (cckd);
 
     /* Update free space stats */
     cckd->cdevhdr[sfx].cdh_used += len;
@@ -2311,7 +2822,7 @@ void cckd_rel_space(DEVBLK *dev, off_t pos, int len, int size)
 {
 CCKD_EXT       *cckd;                   /* -> cckd extension         */
 int             sfx;                    /* Shadow file index         */
-off_t           ppos, npos;             /* Prev/next free offsets    */
+off_t           ppos;                   /* Prev free offset          */
 int             i, p, n;                /* Free space indexes        */
 int             pending;                /* Calculated pending value  */
 int             fsize = size;           /* Free space size           */
@@ -2335,16 +2846,10 @@ int             fsize = size;           /* Free space size           */
 
     CCKD_CHK_SPACE(dev);
 
-    /* Scan free space chain */
-    ppos = -1;
-    npos = cckd->cdevhdr[sfx].free_off;
-    for (p = -1, n = cckd->free_idx1st; n >= 0; n = cckd->ifb[n].ifb_idxnxt)
-    {
-        if (pos < npos) break;
-        ppos = npos;
-        npos = cckd->ifb[n].ifb_offnxt;
-        p = n;
-    }
+    /* Find the free spaces either side in the free space chain */
+    p = cckd_fsp_prev (cckd, (U32)pos);
+    n = p >= 0 ? cckd->ifb[p].ifb_idxnxt : cckd->free_idx1st;
+    ppos = p >= 0 ? (off_t)cckd->ifb[p].ifb_off : -1;
 
     /* Calculate the `pending' value */
     pending = cckdblk.freepend >= 0 ? cckdblk.freepend : 1 + (1 - cckdblk.fsync);
@@ -2352,8 +2857,10 @@ int             fsize = size;           /* Free space size           */
     /* If possible use previous adjacent free space otherwise get an available one */
     if (p >= 0 && ppos + cckd->ifb[p].ifb_len == pos && cckd->ifb[p].ifb_pending == pending)
     {
+        cckd_fsp_size_del (cckd, p);
         cckd->ifb[p].ifb_len += size;
         fsize = cckd->ifb[p].ifb_len;
+        cckd_fsp_size_add (cckd, p);
     }
     else
     {
@@ -2381,6 +2888,9 @@ int             fsize = size;           /* Free space size           */
         cckd->ifb[i].ifb_idxnxt = n;
         cckd->ifb[i].ifb_len = size;
         cckd->ifb[i].ifb_pending = pending;
+        cckd->ifb[i].ifb_off = (U32)pos;
+        cckd_fsp_off_add (cckd, i);
+        cckd_fsp_size_add (cckd, i);
 
         /* Update the previous entry */
         if (p >= 0)
@@ -2444,6 +2954,7 @@ U32             ppos, pos;              /* Free space offsets        */
     {
         cckd->cdevhdr[sfx].free_num = cckd->cdevhdr[sfx].free_off = 0;
         cckd->free_idx1st = cckd->free_idxlast = cckd->free_idxavail = -1;
+        cckd_fsp_build (dev);
     }
 
     pos = cckd->cdevhdr[sfx].free_off;
@@ -2452,6 +2963,7 @@ U32             ppos, pos;              /* Free space offsets        */
     for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
     {
         /* Decrement the pending count */
+        cckd_fsp_size_del (cckd, i);
         if (cckd->ifb[i].ifb_pending)
             --cckd->ifb[i].ifb_pending;
 
@@ -2462,6 +2974,8 @@ U32             ppos, pos;              /* Free space offsets        */
             if (cckd->ifb[n].ifb_pending > cckd->ifb[i].ifb_pending + 1
              || cckd->ifb[n].ifb_pending < cckd->ifb[i].ifb_pending)
                 break;
+            cckd_fsp_size_del (cckd, n);
+            cckd_fsp_off_del (cckd, n);
             cckd->ifb[i].ifb_offnxt  = cckd->ifb[n].ifb_offnxt;
             cckd->ifb[i].ifb_len += cckd->ifb[n].ifb_len;
             cckd->ifb[i].ifb_idxnxt = cckd->ifb[n].ifb_idxnxt;
@@ -2472,6 +2986,7 @@ U32             ppos, pos;              /* Free space offsets        */
                 cckd->ifb[n].ifb_idxprv = i;
 
         }
+        cckd_fsp_size_add (cckd, i);
         ppos = pos;
         pos = cckd->ifb[i].ifb_offnxt;
         cckd->cdevhdr[sfx].free_num++;
@@ -2496,6 +3011,8 @@ U32             ppos, pos;              /* Free space offsets        */
                     sfx, ppos, cckd->ifb[i].ifb_len);
 
         /* Remove the entry from the chain */
+        cckd_fsp_size_del (cckd, i);
+        cckd_fsp_off_del (cckd, i);
         if (p >= 0)
         {
             cckd->ifb[p].ifb_offnxt = 0;
@@ -2517,13 +3034,7 @@ U32             ppos, pos;              /* Free space offsets        */
         cckd->cdevhdr[sfx].free_total -= cckd->ifb[i].ifb_len;
         cckd->cdevhdr[sfx].free_num--;
         if (cckd->ifb[i].ifb_len >= cckd->cdevhdr[sfx].free_largest)
-        {
-            cckd->cdevhdr[sfx].free_largest = 0;
-            for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
-                if (cckd->ifb[i].ifb_len > cckd->cdevhdr[sfx].free_largest
-                 && cckd->ifb[i].ifb_pending == 0)
-                    cckd->cdevhdr[sfx].free_largest = cckd->ifb[i].ifb_len;
-        }
+            cckd->cdevhdr[sfx].free_largest = cckd_fsp_largest (cckd);
 
         /* Truncate the file */
         cckd_ftruncate (dev, sfx, (off_t)cckd->cdevhdr[sfx].cdh_size);
@@ -2556,6 +3067,16 @@ int             sfx;                    /* File index                */
     if (cckd_read (dev, sfx, CKD_DEVHDR_SIZE, &cckd->cdevhdr[sfx], CCKD_DEVHDR_SIZE) < 0)
         return -1;
 
+    /* Refuse images with track images this release cannot read */
+    if (!CCKD_VRM_SUPPORTED( cckd->cdevhdr[sfx].cdh_vrm ))
+    {
+        // "%1d:%04X CCKD file %s: header level %u.%u.%u is not supported"
+        WRMSG( HHC00386, "E", LCSS_DEVNUM, cckd_sf_name( dev, sfx ),
+               cckd->cdevhdr[sfx].cdh_vrm[0], cckd->cdevhdr[sfx].cdh_vrm[1],
+               cckd->cdevhdr[sfx].cdh_vrm[2] );
+        return -1;
+    }
+
     /* Check endian format */
     cckd->swapend[sfx] = 0;
     if ((cckd->cdevhdr[sfx].cdh_opts & CCKD_OPT_BIGEND) != cckd_def_opt_bigend())
@@ -2603,10 +3124,12 @@ int             sfx;                    /* File index                */
 
     CCKD_TRACE( "file[%d] write_chdr", sfx);
 
-    /* Set version.release.modlvl */
+    /* Set version.release.modlvl, keeping a higher modlvl that
+       marks an image as having zstd, lz4 or dictionary tracks */
     cckd->cdevhdr[sfx].cdh_vrm[0] = CCKD_VERSION;
     cckd->cdevhdr[sfx].cdh_vrm[1] = CCKD_RELEASE;
-    cckd->cdevhdr[sfx].cdh_vrm[2] = CCKD_MODLVL;
+    if (cckd->cdevhdr[sfx].cdh_vrm[2] < CCKD_MODLVL)
+        cckd->cdevhdr[sfx].cdh_vrm[2] = CCKD_MODLVL;
 
     if (cckd_write (dev, sfx, CCKD_DEVHDR_POS, &cckd->cdevhdr[sfx], CCKD_DEVHDR_SIZE) < 0)
         return -1;
@@ -2879,6 +3402,9 @@ CCKD_FREEBLK    freeblk;                /* First freeblk read        */
 
     /* Set minimum free space size */
     cckd->free_minsize = CCKD_MIN_FREESIZE( cckd->free_count );
+
+    /* Build the free space index */
+    cckd_fsp_build (dev);
     return 0;
 
 } /* end function cckd_read_fsp */
@@ -4783,7 +5309,7 @@ int             free_count=0;           /* Total number free spaces  */
     WRMSG (HHC00333, "I", LCSS_DEVNUM);
 
     if (cckd->readaheads || cckd->misses)
-    // "%1d:%04X                                                      readaheads   misses"
+    // "%1d:%04X                                                      readaheads   misses   useful"
     WRMSG (HHC00334, "I", LCSS_DEVNUM);
 
     // "%1d:%04X ------------------------------------------------------------------------"
@@ -4804,9 +5330,9 @@ int             free_count=0;           /* Total number free spaces  */
     );
 
     if (cckd->readaheads || cckd->misses)
-    // "%1d:%04X                                                         %7.7d  %7.7d"
+    // "%1d:%04X                                                         %7.7d  %7.7d  %7.7d"
     WRMSG (HHC00337, "I", LCSS_DEVNUM,
-            cckd->readaheads, cckd->misses);
+            cckd->readaheads, cckd->misses, cckd->rauseful);
 
     /* base file statistics */
 
@@ -4992,6 +5518,10 @@ struct timeval  tv_now;                 /* Time-of-day (as timeval)  */
 time_t          tt_now;                 /* Time-of-day (as time_t)   */
 struct timespec tm;                     /* Time-of-day to wait       */
 int             gcs;
+int             more = 0;               /* 1=A step was cut short    */
+int             resume;                 /* 1=Resume cut short steps  */
+U64             now, elapsed;           /* Microsecond times         */
+S64             ms, owed;               /* Milliseconds to pause     */
 
     UNREFERENCED( arg );
 
@@ -5030,17 +5560,62 @@ int             gcs;
 
     while (gcol <= cckdblk.gcmax)
     {
-        /* Perform collection on each device */
+        /* Replenish the i/o budget for the time that has passed */
+        now = cckd_usecs();
+        if (cckdblk.gcrate > 0)
+        {
+            elapsed = now - cckdblk.gcrefill;
+            if (elapsed < 1000000)
+                cckdblk.gcbudget += (S64)(elapsed * ((U64)cckdblk.gcrate << SHIFT_1K) / 1000000);
+            else
+                cckdblk.gcbudget = (S64)cckdblk.gcrate << SHIFT_1K;
+            if (cckdblk.gcbudget > (S64)cckdblk.gcrate << SHIFT_1K)
+                cckdblk.gcbudget = (S64)cckdblk.gcrate << SHIFT_1K;
+        }
+        cckdblk.gcrefill = now;
+
+        /* Perform collection on each device.  A resume pass only
+           steps the devices whose last step was cut short (gcleft is
+           at the same offset in the 64-bit extension, as is devnext) */
+        resume = more;
+        more = 0;
         cckd_lock_devchain(0);
         {
             for (dev = cckdblk.dev1st; dev; dev = cckd->devnext)
             {
                 cckd = dev->cckd_ext;
-                cckd_gcol_dev( dev, &tv_now );
+                if (resume && !cckd->gcleft)
+                    continue;
+                more |= cckd_gcol_dev( dev, &tv_now );
             }
         }
         cckd_unlock_devchain();
 
+        /* If a step was cut short then resume the cycle after a short
+           pause, long enough to bring the i/o budget back into credit */
+        if (more)
+        {
+            ms = cckdblk.gcstep > 0 ? cckdblk.gcstep : 10;
+            if (cckdblk.gcrate > 0 && cckdblk.gcbudget < 0)
+            {
+                owed = (-cckdblk.gcbudget * 1000)
+                     / ((S64)cckdblk.gcrate << SHIFT_1K) + 1;
+                if (owed > ms)
+                    ms = owed;
+            }
+
+            gettimeofday (&tv_now, NULL);
+            tm.tv_sec  = tv_now.tv_sec + (time_t)(ms / 1000);
+            tm.tv_nsec = (tv_now.tv_usec + (long)(ms % 1000) * 1000) * 1000;
+            if (tm.tv_nsec >= 1000000000)
+            {
+                tm.tv_sec++;
+                tm.tv_nsec -= 1000000000;
+            }
+            timed_wait_condition (&cckdblk.gccond, &cckdblk.gclock, &tm);
+            continue;
+        }
+
         /* If we're in manual on-demand mode, then we're done. */
         if (cckdblk.gcint <= 0)
             break;
@@ -5077,10 +5652,14 @@ int             gcs;
 
 /*-------------------------------------------------------------------*/
 /* Perform garbage collection for a given CCKD device                */
+/*                                                                   */
+/* Returns 1 if the collection step was cut short by the step time   */
+/* limit or the i/o budget and the cycle should be resumed shortly.  */
 /*-------------------------------------------------------------------*/
-void cckd_gcol_dev( DEVBLK* dev, struct timeval* tv_now )
+int cckd_gcol_dev( DEVBLK* dev, struct timeval* tv_now )
 {
 int             rc;                     /* Return code               */
+int             more;                   /* 1=Cycle not complete      */
 CCKD_EXT       *cckd;                   /* -> cckd extension         */
 S64             size, fsiz;             /* File size, free size      */
 int             gc;                     /* Garbage collection state  */
@@ -5092,10 +5671,7 @@ int             gctab[5]= {             /* default gcol parameters   */
                             256};       /* none       0%   -   6.3%  */
 
     if (dev->cckd64)
-    {
-        cckd64_gcol_dev( dev, tv_now );
-        return;
-    }
+        return cckd64_gcol_dev( dev, tv_now );
 
     cckd = dev->cckd_ext;
 
@@ -5105,14 +5681,14 @@ int             gctab[5]= {             /* default gcol parameters   */
         if (cckd->merging || cckd->stopping)
         {
             release_lock (&cckd->cckdiolock);
-            return;
+            return 0;
         }
 
         /* Bypass if not opened read-write */
         if (cckd->open[cckd->sfn] != CCKD_OPEN_RW)
         {
             release_lock (&cckd->cckdiolock);
-            return;
+            return 0;
         }
 
         /* Free newbuf if it hasn't been used */
@@ -5126,7 +5702,7 @@ int             gctab[5]= {             /* default gcol parameters   */
         {
             if (cckd->updated) cckd_flush_cache (dev);
             release_lock (&cckd->cckdiolock);
-            return;
+            return 0;
         }
 
         /* Determine garbage state */
@@ -5153,11 +5729,16 @@ int             gctab[5]= {             /* default gcol parameters   */
             size = cckd->cdevhdr[cckd->sfn].cdh_used >> SHIFT_1K;
         if (size < 64)
             size = 64;
+
+        /* Resume a cycle whose last step was cut short */
+        if (cckd->gcleft)
+            size = cckd->gcleft;
     }
     release_lock (&cckd->cckdiolock);
 
     /* Call the garbage collector */
     cckd_gc_percolate (dev, (unsigned int)size);
+    more = cckd->gcleft != 0;
 
     /* Schedule any updated tracks to be written */
     obtain_lock (&cckd->cckdiolock);
@@ -5186,8 +5767,8 @@ int             gctab[5]= {             /* default gcol parameters   */
         release_lock (&cckd->filelock);
     }
 
-    /* Flush the free space */
-    if (cckd->cdevhdr[cckd->sfn].free_num)
+    /* Flush the free space once the cycle is complete */
+    if (!more && cckd->cdevhdr[cckd->sfn].free_num)
     {
         obtain_lock (&cckd->filelock);
         {
@@ -5195,12 +5776,69 @@ int             gctab[5]= {             /* default gcol parameters   */
         }
         release_lock (&cckd->filelock);
     }
+
+    return more;
 }
 
 /*-------------------------------------------------------------------*/
-/* Garbage Collection -- Percolate algorithm                         */
-/*-------------------------------------------------------------------*/
-int cckd_gc_percolate(DEVBLK *dev, unsigned int size)
+/* Garbage Collection -- Pace a collection step                      */
+/*                                                                   */
+/* Called after each space is moved with the time the step started   */
+/* and the number of bytes just moved.  Returns 1 if the step should */
+/* end because it has run for `gcstep' milliseconds or because the   */
+/* collector has spent its i/o budget of `gcrate' Kbytes per second. */
+/* Ending the step releases the device for guest i/o until the       */
+/* garbage collector thread resumes the cycle.                       */
+/*-------------------------------------------------------------------*/
+int cckd_gc_pace(U64 start, unsigned int bytes)
+{
+    if (cckdblk.gcrate > 0)
+    {
+        cckdblk.gcbudget -= bytes;
+        if (cckdblk.gcbudget <= 0)
+            return 1;
+    }
+
+    if (cckdblk.gcstep > 0
+     && cckd_usecs() - start >= (U64)cckdblk.gcstep * 1000)
+        return 1;
+
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the time of day in microseconds                            */
+/*-------------------------------------------------------------------*/
+U64 cckd_usecs()
+{
+struct timeval  tv;                     /* Time-of-day               */
+
+    gettimeofday (&tv, NULL);
+    return (U64)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+/*-------------------------------------------------------------------*/
+/* Count a latency in a latency histogram                            */
+/*                                                                   */
+/* The first bucket counts latencies under 64 microseconds and each  */
+/* following bucket covers four times the range of the one before,   */
+/* the last counting latencies of 256 milliseconds or more.  Device  */
+/* and garbage collector threads record latencies concurrently, so   */
+/* the bucket is updated atomically.                                 */
+/*-------------------------------------------------------------------*/
+void cckd_lat_record(S64 *hist, U64 usecs)
+{
+int             i;                      /* Bucket index              */
+
+    for (i = 0, usecs >>= 6; usecs && i < CCKD_LAT_BUCKETS - 1; i++)
+        usecs >>= 2;
+    atomic_update64( &hist[i], +1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* Garbage Collection -- Percolate algorithm                         */
+/*-------------------------------------------------------------------*/
+int cckd_gc_percolate(DEVBLK *dev, unsigned int size)
 {
 CCKD_EXT       *cckd;                   /* -> cckd extension         */
 int             rc;                     /* Return code               */
@@ -5215,12 +5853,15 @@ int             trk;                    /* Track number              */
 int             L1idx, l2x;             /* Table Indexes             */
 CCKD_L2ENT      l2;                     /* Copied level 2 entry      */
 BYTE            buf[256*1024];          /* Buffer                    */
+U64             start, held;            /* Step, lock start times    */
 
     if (dev->cckd64)
         return cckd64_gc_percolate( dev, size );
 
     cckd = dev->cckd_ext;
     size = size << SHIFT_1K;
+    start = cckd_usecs();
+    cckd->gcleft = 0;
 
     /* Debug */
     OBTAIN_TRACE_LOCK();
@@ -5255,6 +5896,7 @@ BYTE            buf[256*1024];          /* Buffer                    */
     while (moved < size && after < 4)
     {
         obtain_lock (&cckd->filelock);
+        held = cckd_usecs();
         sfx = cckd->sfn;
 
         /* Exit if no more free space */
@@ -5415,6 +6057,17 @@ BYTE            buf[256*1024];          /* Buffer                    */
         cckdblk.stats_gcolbytes += i;
 
         release_lock (&cckd->filelock);
+        cckd_lat_record (cckdblk.stats_gclat, cckd_usecs() - held);
+
+        /* End the step if it has used its time or the i/o budget,
+           leaving the rest of the cycle for the next step */
+        if (moved < size && after < 4 && cckd_gc_pace (start, (unsigned int)i))
+        {
+            cckd->gcleft = (unsigned int)((size - moved + 1023) >> SHIFT_1K);
+            CCKD_TRACE( "gcperc step ended, moved %u left %uK",
+                        (unsigned int)moved, cckd->gcleft);
+            break;
+        }
 
     } /* while (moved < size) */
 
@@ -5660,6 +6313,14 @@ BYTE            comp;                     /* Compression type        */
         to = cckd->newbuf;
         newlen = cckd_uncompress_bzip2 (dev, to, from, len, maxlen);
         break;
+    case CCKD_COMPRESS_ZSTD:
+        to = cckd->newbuf;
+        newlen = cckd_uncompress_zstd (dev, to, from, len, maxlen);
+        break;
+    case CCKD_COMPRESS_LZ4:
+        to = cckd->newbuf;
+        newlen = cckd_uncompress_lz4 (dev, to, from, len, maxlen);
+        break;
     default:
         newlen = -1;
         break;
@@ -5717,6 +6378,28 @@ BYTE            comp;                     /* Compression type        */
         return to;
     }
 
+    /* zstd compression */
+    to = cckd->newbuf;
+    newlen = cckd_uncompress_zstd  (dev, to, from, len, maxlen);
+    newlen = cckd_validate         (dev, to, trk, newlen);
+    if (newlen > 0)
+    {
+        cckd->newbuf = from;
+        cckd->bufused = 1;
+        return to;
+    }
+
+    /* lz4 compression */
+    to = cckd->newbuf;
+    newlen = cckd_uncompress_lz4   (dev, to, from, len, maxlen);
+    newlen = cckd_validate         (dev, to, trk, newlen);
+    if (newlen > 0)
+    {
+        cckd->newbuf = from;
+        cckd->bufused = 1;
+        return to;
+    }
+
     /* Unable to uncompress */
     WRMSG (HHC00343, "E",
             LCSS_DEVNUM, cckd->sfn, cckd_sf_name(dev, cckd->sfn), trk,
@@ -5727,6 +6410,107 @@ BYTE            comp;                     /* Compression type        */
     return NULL;
 }
 
+/*-------------------------------------------------------------------*/
+/* Return the preset compression dictionary of a cckd file           */
+/*-------------------------------------------------------------------*/
+static BYTE *cckd_dict (DEVBLK *dev, int sfx, int *len, U32 *id)
+{
+BYTE *dict;
+
+    if (dev->cckd64)
+    {
+        CCKD64_EXT *cckd = dev->cckd_ext;
+        *len = cckd->cdevhdr[sfx].cdh_dictlen;
+        *id  = cckd->cdevhdr[sfx].cdh_dictid;
+        dict = cckd->cdevhdr[sfx].cdh_dict;
+    }
+    else
+    {
+        CCKD_EXT *cckd = dev->cckd_ext;
+        *len = cckd->cdevhdr[sfx].cdh_dictlen;
+        *id  = cckd->cdevhdr[sfx].cdh_dictid;
+        dict = cckd->cdevhdr[sfx].cdh_dict;
+    }
+    return *len > 0 && *len <= CCKD_DICT_SIZE ? dict : NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the dictionary used for new track images                   */
+/*-------------------------------------------------------------------*/
+static BYTE *cckd_cur_dict (DEVBLK *dev, int *len)
+{
+U32 id;
+
+    if (dev == NULL || dev->cckd_ext == NULL)
+        return NULL;
+    return cckd_dict (dev, ((CCKD_EXT *)dev->cckd_ext)->sfn, len, &id);
+}
+
+/*-------------------------------------------------------------------*/
+/* Find the dictionary with the given adler32 in the file chain      */
+/*-------------------------------------------------------------------*/
+static BYTE *cckd_find_dict (DEVBLK *dev, U32 dictid, int *len)
+{
+BYTE *dict;
+U32   id;
+int   sfx;
+
+    *len = 0;
+    if (dev == NULL || dev->cckd_ext == NULL)
+        return NULL;
+    for (sfx = ((CCKD_EXT *)dev->cckd_ext)->sfn; sfx >= 0; sfx--)
+        if ((dict = cckd_dict (dev, sfx, len, &id)) && id == dictid)
+            return dict;
+    *len = 0;
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Set the preset compression dictionary of a cckd image             */
+/*-------------------------------------------------------------------*/
+/* Only the base file of an image without shadow files may be given  */
+/* a dictionary, and it must be set before any track image is        */
+/* written with it (e.g. by dasdcopy -dict) since images compressed  */
+/* with an earlier dictionary would no longer be readable.  The      */
+/* header is written when the image is next hardened or closed.      */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int cckd_set_dict (DEVBLK *dev, BYTE *dict, int len)
+{
+CCKD_EXT *cckd = dev->cckd_ext;
+U32       id = 0;
+
+    if (cckd == NULL || cckd->sfn != 0 || len < 0 || len > CCKD_DICT_SIZE)
+        return -1;
+
+#if defined( HAVE_ZLIB )
+    if (len)
+        id = (U32)adler32 (adler32 (0, Z_NULL, 0), dict, len);
+#else
+    if (len)
+        return -1;
+#endif
+
+    obtain_lock (&cckd->filelock);
+    if (dev->cckd64)
+    {
+        CCKD64_EXT *cckd64 = dev->cckd_ext;
+        memset (cckd64->cdevhdr[0].cdh_dict, 0, CCKD_DICT_SIZE);
+        if (len) memcpy (cckd64->cdevhdr[0].cdh_dict, dict, len);
+        cckd64->cdevhdr[0].cdh_dictlen = len;
+        cckd64->cdevhdr[0].cdh_dictid  = id;
+    }
+    else
+    {
+        memset (cckd->cdevhdr[0].cdh_dict, 0, CCKD_DICT_SIZE);
+        if (len) memcpy (cckd->cdevhdr[0].cdh_dict, dict, len);
+        cckd->cdevhdr[0].cdh_dictlen = len;
+        cckd->cdevhdr[0].cdh_dictid  = id;
+    }
+    release_lock (&cckd->filelock);
+
+    return 0;
+}
+
 /*-------------------------------------------------------------------*/
 /* cckd_uncompress_zlib                                              */
 /*-------------------------------------------------------------------*/
@@ -5736,11 +6520,25 @@ int cckd_uncompress_zlib (DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen
 unsigned long newlen;
 int rc;
 
-    UNREFERENCED(dev);
     memcpy (to, from, CKD_TRKHDR_SIZE);
     newlen = maxlen - CKD_TRKHDR_SIZE;
-    rc = uncompress(&to[CKD_TRKHDR_SIZE], &newlen,
-                &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE);
+
+    /* Image was compressed with a preset dictionary (FDICT) */
+    if (len > CKD_TRKHDR_SIZE + 6 && (from[CKD_TRKHDR_SIZE+1] & 0x20))
+    {
+        BYTE *dict;
+        int   dictlen;
+
+        dict = cckd_find_dict (dev, fetch_fw (&from[CKD_TRKHDR_SIZE+2]), &dictlen);
+        rc = cckd_inflate_dict (&to[CKD_TRKHDR_SIZE], (int)newlen,
+                                &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE,
+                                dict, dictlen);
+        newlen = rc < 0 ? 0 : (unsigned long)rc;
+        rc = rc < 0 ? Z_NEED_DICT : Z_OK;
+    }
+    else
+        rc = uncompress(&to[CKD_TRKHDR_SIZE], &newlen,
+                    &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE);
     if (rc == Z_OK)
     {
         newlen += CKD_TRKHDR_SIZE;
@@ -5799,6 +6597,75 @@ int rc;
 #endif
 }
 
+/*-------------------------------------------------------------------*/
+/* cckd_uncompress_zstd                                              */
+/*-------------------------------------------------------------------*/
+int cckd_uncompress_zstd (DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen)
+{
+#if defined( CCKD_ZSTD )
+size_t rc;
+int newlen;
+
+    UNREFERENCED(dev);
+    memcpy (to, from, CKD_TRKHDR_SIZE);
+    rc = ZSTD_decompress (&to[CKD_TRKHDR_SIZE], maxlen - CKD_TRKHDR_SIZE,
+                          &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE);
+    if (!ZSTD_isError (rc))
+    {
+        newlen = (int)rc + CKD_TRKHDR_SIZE;
+        to[0] = 0;
+    }
+    else
+        newlen = -1;
+
+    CCKD_TRACE( "uncompress zstd newlen %d",newlen);
+
+    return newlen;
+#else
+    UNREFERENCED(dev);
+    UNREFERENCED(to);
+    UNREFERENCED(from);
+    UNREFERENCED(len);
+    UNREFERENCED(maxlen);
+    return -1;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* cckd_uncompress_lz4                                               */
+/*-------------------------------------------------------------------*/
+int cckd_uncompress_lz4 (DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen)
+{
+#if defined( CCKD_LZ4 )
+int newlen;
+
+    UNREFERENCED(dev);
+    memcpy (to, from, CKD_TRKHDR_SIZE);
+    newlen = LZ4_decompress_safe ((const char *)&from[CKD_TRKHDR_SIZE],
+                                  (char *)&to[CKD_TRKHDR_SIZE],
+                                  len - CKD_TRKHDR_SIZE,
+                                  maxlen - CKD_TRKHDR_SIZE);
+    if (newlen >= 0)
+    {
+        newlen += CKD_TRKHDR_SIZE;
+        to[0] = 0;
+    }
+    else
+        newlen = -1;
+
+    CCKD_TRACE( "uncompress lz4 newlen %d",newlen);
+
+    return newlen;
+#else
+    UNREFERENCED(dev);
+    UNREFERENCED(to);
+    UNREFERENCED(from);
+    UNREFERENCED(len);
+    UNREFERENCED(maxlen);
+    return -1;
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /* Compress a track image                                            */
 /*-------------------------------------------------------------------*/
@@ -5807,6 +6674,10 @@ int cckd_compress (DEVBLK *dev, BYTE **to, BYTE *from, int len,
 {
 int newlen;
 
+    /* Writer threads compress concurrently outside of any lock */
+    atomic_update64( &cckdblk.stats_compress, +1 );
+    atomic_update64( &cckdblk.stats_compbytes, len );
+
     switch (comp) {
     case CCKD_COMPRESS_NONE:
         newlen = cckd_compress_none (dev, to, from, len, parm);
@@ -5817,10 +6688,20 @@ int newlen;
     case CCKD_COMPRESS_BZIP2:
         newlen = cckd_compress_bzip2 (dev, to, from, len, parm);
         break;
+    case CCKD_COMPRESS_ZSTD:
+        newlen = cckd_compress_zstd (dev, to, from, len, parm);
+        break;
+    case CCKD_COMPRESS_LZ4:
+        newlen = cckd_compress_lz4 (dev, to, from, len, parm);
+        break;
     default:
         newlen = cckd_compress_bzip2 (dev, to, from, len, parm);
         break;
     }
+
+    if (newlen > 0)
+        atomic_update64( &cckdblk.stats_compout, newlen );
+
     return newlen;
 }
 
@@ -5846,15 +6727,38 @@ unsigned long newlen;
 int rc;
 BYTE *buf;
 
-    UNREFERENCED(dev);
+BYTE *dict;
+int dictlen;
+
     buf = *to;
     from[0] = CCKD_COMPRESS_NONE;
     memcpy (buf, from, CKD_TRKHDR_SIZE);
     buf[0] = CCKD_COMPRESS_ZLIB;
     newlen = 65535 - CKD_TRKHDR_SIZE;
-    rc = compress2 (&buf[CKD_TRKHDR_SIZE], &newlen,
-                    &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE,
-                    parm);
+    dict = cckd_cur_dict (dev, &dictlen);
+    if (dict)
+    {
+        z_stream z;
+
+        /* Compress using the image's preset dictionary */
+        memset (&z, 0, sizeof(z));
+        z.next_in   = &from[CKD_TRKHDR_SIZE];
+        z.avail_in  = len - CKD_TRKHDR_SIZE;
+        z.next_out  = &buf[CKD_TRKHDR_SIZE];
+        z.avail_out = (uInt)newlen;
+        rc = deflateInit (&z, parm);
+        if (rc == Z_OK)
+        {
+            if ((rc = deflateSetDictionary (&z, dict, dictlen)) == Z_OK)
+                rc = deflate (&z, Z_FINISH) == Z_STREAM_END ? Z_OK : Z_BUF_ERROR;
+            newlen = z.total_out;
+            deflateEnd (&z);
+        }
+    }
+    else
+        rc = compress2 (&buf[CKD_TRKHDR_SIZE], &newlen,
+                        &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE,
+                        parm);
     newlen += CKD_TRKHDR_SIZE;
     if (rc != Z_OK || (int)newlen >= len)
     {
@@ -5901,6 +6805,68 @@ BYTE *buf;
 #endif
 }
 
+/*-------------------------------------------------------------------*/
+/* cckd_compress_zstd                                                */
+/*-------------------------------------------------------------------*/
+int cckd_compress_zstd (DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm)
+{
+#if defined( CCKD_ZSTD )
+size_t rc;
+int newlen;
+BYTE *buf;
+
+    UNREFERENCED(dev);
+    buf = *to;
+    from[0] = CCKD_COMPRESS_NONE;
+    memcpy (buf, from, CKD_TRKHDR_SIZE);
+    buf[0] = CCKD_COMPRESS_ZSTD;
+    rc = ZSTD_compress (&buf[CKD_TRKHDR_SIZE], 65535 - CKD_TRKHDR_SIZE,
+                        &from[CKD_TRKHDR_SIZE], len - CKD_TRKHDR_SIZE,
+                        parm >= 1 && parm <= 9 ? parm : 3);
+    newlen = ZSTD_isError (rc) ? len : (int)rc + CKD_TRKHDR_SIZE;
+    if (newlen >= len)
+    {
+        *to = from;
+        newlen = len;
+    }
+    return newlen;
+#else
+    return cckd_compress_zlib (dev, to, from, len, parm);
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* cckd_compress_lz4                                                 */
+/*-------------------------------------------------------------------*/
+int cckd_compress_lz4 (DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm)
+{
+#if defined( CCKD_LZ4 )
+int newlen;
+BYTE *buf;
+
+    UNREFERENCED(dev);
+    buf = *to;
+    from[0] = CCKD_COMPRESS_NONE;
+    memcpy (buf, from, CKD_TRKHDR_SIZE);
+    buf[0] = CCKD_COMPRESS_LZ4;
+    /* A higher parm trades compression ratio for speed */
+    newlen = LZ4_compress_fast ((const char *)&from[CKD_TRKHDR_SIZE],
+                                (char *)&buf[CKD_TRKHDR_SIZE],
+                                len - CKD_TRKHDR_SIZE,
+                                65535 - CKD_TRKHDR_SIZE,
+                                parm >= 1 && parm <= 9 ? parm : 1);
+    newlen = newlen > 0 ? newlen + CKD_TRKHDR_SIZE : len;
+    if (newlen >= len)
+    {
+        *to = from;
+        newlen = len;
+    }
+    return newlen;
+#else
+    return cckd_compress_zlib (dev, to, from, len, parm);
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /* cckd command help                                                 */
 /*-------------------------------------------------------------------*/
@@ -5918,14 +6884,18 @@ void cckd_command_help()
 
         //    ***  Please keep these in alphabetical order!  ***
 
-        , "  comp=<n>      Override compression                 (-1,0,1,2)"
+        , "  comp=<n>      Override compression             (-1,0,1,2,4,8)"
+        , "  compbench=<n> Benchmark track compression       (10 ... 1000)"
         , "  compparm=<n>  Override compression parm            (-1 ... 9)"
         , "  debug=<n>     Enable CCW tracing debug messages      (0 or 1)"
         , "  freepend=<n>  Set free pending cycles              (-1 ... 4)"
+        , "  fspbench=<n>  Benchmark free space            (100 .. 100000)"
         , "  fsync=<n>     Enable fsync                           (0 or 1)"
         , "  gcint=<n>     Set garbage collector interval (sec) ( 0 .. 60)"
         , "  gcparm=<n>    Set garbage collector parameter      (-8 ... 8)"
+        , "  gcrate=<n>    Set garbage collector i/o KB/sec   (0=no limit)"
         , "  gcstart=<n>   Start garbage collector                (0 or 1)"
+        , "  gcstep=<n>    Set garbage collector step msecs   (0 ... 1000)"
         , "  linuxnull=<n> Check for null linux tracks            (0 or 1)"
         , "  nosfd=<n>     Disable stats report at close          (0 or 1)"
         , "  nostress=<n>  Disable stress writes                  (0 or 1)"
@@ -5961,6 +6931,8 @@ void cckd_command_opts()
         ","   "fsync=%d"
         ","   "gcint=%d"
         ","   "gcparm=%d"
+        ","   "gcrate=%d"
+        ","   "gcstep=%d"
 
         , cckdblk.comp == 0xff ? -1 : cckdblk.comp
         , cckdblk.compparm
@@ -5969,6 +6941,8 @@ void cckd_command_opts()
         , cckdblk.fsync
         , cckdblk.gcint
         , cckdblk.gcparm
+        , cckdblk.gcrate
+        , cckdblk.gcstep
     );
     WRMSG( HHC00346, "I", msgbuf );
 
@@ -5999,6 +6973,20 @@ void cckd_command_opts()
     return;
 } /* end function cckd_command_opts */
 
+/*-------------------------------------------------------------------*/
+/* cckd command stats latency histogram line                         */
+/*-------------------------------------------------------------------*/
+static void cckd_command_lat( const char* name, S64* hist )
+{
+    char msgbuf[128];
+    int  i, n;
+
+    n = MSGBUF( msgbuf, "%s", name );
+    for (i = 0; i < CCKD_LAT_BUCKETS && n < (int)sizeof( msgbuf ); i++)
+        n += snprintf( msgbuf + n, sizeof( msgbuf ) - n, "%8"PRId64, hist[i] );
+    WRMSG( HHC00347, "I", msgbuf );
+}
+
 /*-------------------------------------------------------------------*/
 /* cckd command stats                                                */
 /*-------------------------------------------------------------------*/
@@ -6016,8 +7004,9 @@ void cckd_command_stats()
                     cckdblk.stats_writes, cckdblk.stats_writebytes >> SHIFT_1K );
     WRMSG( HHC00347, "I", msgbuf );
 
-    MSGBUF( msgbuf, "  readaheads%9"PRId64" misses...%10"PRId64,
-                    cckdblk.stats_readaheads, cckdblk.stats_readaheadmisses );
+    MSGBUF( msgbuf, "  readaheads%9"PRId64" misses...%10"PRId64" useful...%10"PRId64,
+                    cckdblk.stats_readaheads, cckdblk.stats_readaheadmisses,
+                    cckdblk.stats_rauseful );
     WRMSG( HHC00347, "I", msgbuf );
 
     MSGBUF( msgbuf, "  switches.%10"PRId64" l2 reads.%10"PRId64" strs wrt.%10"PRId64,
@@ -6040,9 +7029,360 @@ void cckd_command_stats()
                     cckdblk.stats_gcolmoves, cckdblk.stats_gcolbytes >> SHIFT_1K );
     WRMSG( HHC00347, "I", msgbuf );
 
+    MSGBUF( msgbuf, "  wr scans.%10"PRId64" queued...%10"PRId64" skipped..%10"PRId64,
+                    cckdblk.stats_wrscans, cckdblk.stats_wrqueued, cckdblk.stats_wrskipped );
+    WRMSG( HHC00347, "I", msgbuf );
+
+    MSGBUF( msgbuf, "  compress.%10"PRId64" Kbytes...%10"PRId64" to Kbytes%10"PRId64,
+                    cckdblk.stats_compress, cckdblk.stats_compbytes >> SHIFT_1K,
+                    cckdblk.stats_compout >> SHIFT_1K );
+    WRMSG( HHC00347, "I", msgbuf );
+
+    WRMSG( HHC00347, "I", "  latency..   <64us  <256us    <1ms    <4ms   <16ms   <64ms  <256ms    more" );
+    cckd_command_lat( "  gc lock..", cckdblk.stats_gclat );
+    cckd_command_lat( "  trk read.", cckdblk.stats_rdlat );
+
     return;
 } /* end function cckd_command_stats */
 
+/*-------------------------------------------------------------------*/
+/* cckd command fspbench                                             */
+/*                                                                   */
+/* Free space microbenchmark.  A device is simulated in storage      */
+/* whose file is fragmented into `nfree' free spaces lying between   */
+/* used spaces.  Random used spaces are then rewritten, each one     */
+/* getting new space with cckd_get_space and releasing its old space */
+/* with cckd_rel_space, and the average time taken is displayed.     */
+/* The free space is flushed every 1000 rewrites, as the garbage     */
+/* collector would, but that time is not counted.  No track images   */
+/* are read or written; a scratch file is used only so that free     */
+/* space at the end of the file can be truncated.                    */
+/*-------------------------------------------------------------------*/
+void cckd_command_fspbench( int nfree )
+{
+DEVBLK         *dev;                    /* -> simulated device       */
+CCKD_EXT       *cckd;                   /* -> cckd extension         */
+FILE           *fp;                     /* Scratch file              */
+off_t          *pos;                    /* Used space offsets        */
+int            *len, *size;             /* Used space lengths, sizes */
+int             nused;                  /* Number used spaces        */
+int             nops;                   /* Number rewrites           */
+int             i, j, l, n, sz;         /* Work variables            */
+unsigned int    seed = 1;               /* Random number seed        */
+off_t           fpos;                   /* Free space offset         */
+U32             total;                  /* Free space total          */
+U64             start, usecs = 0;       /* Times                     */
+
+#define FSPBENCH_RAND()  (seed = seed * 1103515245 + 12345, (seed >> 8) & 0xffff)
+#define FSPBENCH_LEN()   (256 + FSPBENCH_RAND() % 16384)
+
+    nused = nfree + 1;
+    nops = 10000;
+
+    dev  = calloc( 1, sizeof( DEVBLK ));
+    cckd = calloc( 1, sizeof( CCKD_EXT ));
+    pos  = calloc( nused, sizeof( off_t ));
+    len  = calloc( nused, sizeof( int ));
+    size = calloc( nused, sizeof( int ));
+    fp   = tmpfile();
+
+    if (!dev || !cckd || !pos || !len || !size || !fp)
+    {
+        // "CCKD free space benchmark: %s"
+        WRMSG( HHC00383, "E", "out of storage or no scratch file" );
+        goto fspbench_exit;
+    }
+
+    dev->cckd_ext = cckd;
+    cckd->fd[0] = fileno( fp );
+    cckd->open[0] = CCKD_OPEN_RW;
+    cckd->cckd_maxsize = CCKD_MAXSIZE;
+    cckd->cdevhdr[0].cdh_size = cckd->cdevhdr[0].cdh_used = CCKD_L1TAB_POS;
+
+    /* Start with an empty free space chain */
+    if (!(cckd->ifb = cckd_calloc( dev, "ifb", CCKD_IFB_ENTS_INCR, CCKD_IFREEBLK_SIZE )))
+        goto fspbench_exit;
+    cckd->free_count = CCKD_IFB_ENTS_INCR;
+    cckd->free_idx1st = cckd->free_idxlast = -1;
+    cckd->free_idxavail = 0;
+    for (i = 0; i < cckd->free_count; i++)
+        cckd->ifb[i].ifb_idxnxt = i + 1;
+    cckd->ifb[i-1].ifb_idxnxt = -1;
+    cckd->free_minsize = CCKD_MIN_FREESIZE( cckd->free_count );
+    cckd_fsp_build( dev );
+
+    /* Fragment the file: allocate `nfree' spaces each followed by a
+       used space, then release the spaces between the used spaces */
+    for (i = j = 0; i < nfree; i++)
+    {
+        l = sz = FSPBENCH_LEN();
+        fpos = cckd_get_space( dev, &sz, CCKD_SIZE_EXACT );
+        size[j] = len[j] = FSPBENCH_LEN();
+        pos[j] = cckd_get_space( dev, &size[j], CCKD_SIZE_EXACT );
+        j++;
+        cckd_rel_space( dev, fpos, l, sz );
+    }
+    size[j] = len[j] = FSPBENCH_LEN();
+    pos[j] = cckd_get_space( dev, &size[j], CCKD_SIZE_EXACT );
+    for (i = 0; i < CCKD_MAX_FREEPEND; i++)
+        cckd_flush_space( dev );
+
+    /* Rewrite random used spaces */
+    for (n = 0; n < nops; )
+    {
+        start = cckd_usecs();
+        for (i = 0; i < 1000 && n < nops; i++, n++)
+        {
+            j = FSPBENCH_RAND() % nused;
+            l = sz = FSPBENCH_LEN();
+            fpos = cckd_get_space( dev, &sz, CCKD_SIZE_ANY );
+            cckd_rel_space( dev, pos[j], len[j], size[j] );
+            pos[j] = fpos;
+            len[j] = l;
+            size[j] = sz;
+        }
+        usecs += cckd_usecs() - start;
+        cckd_flush_space( dev );
+    }
+
+    // "CCKD free space benchmark: %d free spaces, %d gets and releases in %"PRId64" usecs, %"PRId64" nsecs each"
+    WRMSG( HHC00382, "I", nfree, nops, usecs, (usecs * 1000) / nops );
+
+    /* Check the free space chain is in order and adds up, and that
+       the free space index agrees with it */
+    fpos = (off_t)cckd->cdevhdr[0].free_off;
+    for (n = l = 0, total = 0, i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt, n++)
+    {
+        if (cckd->ifb[i].ifb_offnxt && (off_t)cckd->ifb[i].ifb_offnxt < fpos + (off_t)cckd->ifb[i].ifb_len)
+            break;
+        if ((off_t)cckd->ifb[i].ifb_off != fpos
+         || cckd_fsp_prev( cckd, (U32)fpos + 1 ) != i
+         || cckd->ifb[i].ifb_sized == (cckd->ifb[i].ifb_pending != 0))
+            break;
+        total += cckd->ifb[i].ifb_len;
+        l += cckd->ifb[i].ifb_sized;
+        fpos = (off_t)cckd->ifb[i].ifb_offnxt;
+    }
+    if (i >= 0 || n != cckd->cdevhdr[0].free_num
+     || n != cckd_fsp_count( cckd->ifb, CCKD_FSP_OFFSET, cckd->free_root[CCKD_FSP_OFFSET] )
+     || l != cckd_fsp_count( cckd->ifb, CCKD_FSP_SIZE, cckd->free_root[CCKD_FSP_SIZE] )
+     || total != cckd->cdevhdr[0].free_total - cckd->cdevhdr[0].free_imbed)
+        // "CCKD free space benchmark: %s"
+        WRMSG( HHC00383, "E", "free space is inconsistent" );
+    else
+        // "CCKD free space benchmark: %s"
+        WRMSG( HHC00383, "I", "free space is consistent" );
+
+fspbench_exit:
+
+    if (cckd && cckd->ifb)
+        cckd_free( dev, "ifb", cckd->ifb );
+    if (fp)
+        fclose( fp );
+    free( size );
+    free( len );
+    free( pos );
+    free( cckd );
+    free( dev );
+
+#undef FSPBENCH_RAND
+#undef FSPBENCH_LEN
+
+} /* end function cckd_command_fspbench */
+
+/*-------------------------------------------------------------------*/
+/* cckd command compbench                                            */
+/*                                                                   */
+/* Track compression microbenchmark.  `ntrks' 3390 track images of   */
+/* twelve 4K records are built in storage, the records taking turns  */
+/* holding 80 byte card images, binary words and 100 byte records    */
+/* with a name, a counter and a packed decimal field.  Each image is */
+/* then compressed and uncompressed by every algorithm Hercules was  */
+/* built with, using the compparm option, and the compressed size    */
+/* and the throughput of each direction is displayed.  Every image   */
+/* must uncompress to the original.  No files are read or written.   */
+/*-------------------------------------------------------------------*/
+void cckd_command_compbench( int ntrks )
+{
+DEVBLK         *dev;                    /* -> simulated device       */
+CCKD_EXT       *cckd;                   /* -> cckd extension         */
+BYTE           *trks;                   /* Track images              */
+BYTE           *cbuf;                   /* Compressed track images   */
+int            *clen;                   /* Compressed lengths        */
+BYTE           *trk, *rec, *bufp;       /* Work pointers             */
+char            card[81];               /* Card image                */
+const char     *w[5];                   /* Words on a card           */
+U32             v;                      /* Binary value              */
+BYTE            buf[64*1024];           /* Uncompressed track image  */
+int             trklen;                 /* Track image length        */
+int             i, j, k, n, r;          /* Work variables            */
+int             failed = 0;             /* Images not round tripped  */
+unsigned int    seed = 1;               /* Random number seed        */
+U64             inbytes, outbytes;      /* Byte counts               */
+U64             start, cusecs, uusecs;  /* Times                     */
+char            msgbuf[64];             /* Message buffer            */
+static const BYTE comps[] = { CCKD_COMPRESS_ZLIB, CCKD_COMPRESS_BZIP2,
+                              CCKD_COMPRESS_ZSTD, CCKD_COMPRESS_LZ4 };
+static int (*compress[])( DEVBLK*, BYTE**, BYTE*, int, int ) =
+    { cckd_compress_zlib, cckd_compress_bzip2,
+      cckd_compress_zstd, cckd_compress_lz4 };
+static int (*uncompress[])( DEVBLK*, BYTE*, BYTE*, int, int ) =
+    { cckd_uncompress_zlib, cckd_uncompress_bzip2,
+      cckd_uncompress_zstd, cckd_uncompress_lz4 };
+static const char *words[] =
+    { "LA", "L", "ST", "MVC", "CLC", "BNE", "BAL", "LTR", "USING", "DS",
+      "DC", "R1", "R14", "0(R2)", "8(R13)", "F'0'", "CL8' '", "WORKAREA",
+      "SAVEAREA", "RETURN", "=A(TABLE)", "*+4", "EQU", "CSECT" };
+
+#define COMPBENCH_RAND()  (seed = seed * 1103515245 + 12345, (seed >> 8) & 0xffff)
+#define COMPBENCH_WORD()  words[ COMPBENCH_RAND() % _countof( words ) ]
+
+    trklen = (int)(CKD_TRKHDR_SIZE + CKD_R0_SIZE + CKD_R0_DLEN
+           + 12 * (CKD_RECHDR_SIZE + 4096) + CKD_ENDTRK_SIZE);
+
+    dev  = calloc( 1, sizeof( DEVBLK ));
+    cckd = calloc( 1, sizeof( CCKD_EXT ));
+    trks = calloc( ntrks, trklen );
+    cbuf = calloc( ntrks, sizeof( buf ));
+    clen = calloc( ntrks, sizeof( int ));
+
+    if (!dev || !cckd || !trks || !cbuf || !clen)
+    {
+        // "CCKD compression benchmark: %s"
+        WRMSG( HHC00385, "E", "out of storage" );
+        goto compbench_exit;
+    }
+    dev->cckd_ext = cckd;
+
+    /* Build the track images */
+    for (i = n = 0; i < ntrks; i++)
+    {
+        trk = trks + (size_t)i * trklen;
+        store_hw( trk + 1, i / 15 );
+        store_hw( trk + 3, i % 15 );
+        memcpy( trk + CKD_TRKHDR_SIZE, trk + 1, 4 );
+        store_hw( trk + CKD_TRKHDR_SIZE + 6, CKD_R0_DLEN );
+        rec = trk + CKD_TRKHDR_SIZE + CKD_R0_SIZE + CKD_R0_DLEN;
+        for (r = 1; r <= 12; r++, rec += 4096)
+        {
+            memcpy( rec, trk + 1, 4 );
+            rec[4] = r;
+            store_hw( rec + 6, 4096 );
+            rec += CKD_RECHDR_SIZE;
+
+            switch (r % 3) {
+            case 0:                     /* Card images               */
+                for (j = 0; j < 4096; j += 80)
+                {
+                    w[0] = COMPBENCH_RAND() % 4 ? "" : "LOOP";
+                    for (k = 1; k < 5; k++)
+                        w[k] = COMPBENCH_WORD();
+                    MSGBUF( msgbuf, "%-8s %-5s %s,%s,%s", w[0], w[1], w[2], w[3], w[4] );
+                    MSGBUF( card, "%-72.72s%08d", msgbuf, ++n );
+                    memcpy( rec + j, card, MIN( 80, 4096 - j ));
+                }
+                break;
+            case 1:                     /* Binary words              */
+                for (j = 0; j < 4096; j += 4)
+                {
+                    k = COMPBENCH_RAND() % 10;
+                    v = COMPBENCH_RAND();
+                    if (k < 3)
+                        v = 0;
+                    else if (k < 6)
+                        v %= 256;
+                    else
+                        v |= COMPBENCH_RAND() << 16;
+                    store_fw( rec + j, v );
+                }
+                break;
+            default:                    /* Fixed length records      */
+                for (j = 0; j + 100 <= 4096; j += 100)
+                {
+                    w[0] = COMPBENCH_WORD();
+                    memset( rec + j, ' ', 24 );
+                    memcpy( rec + j, w[0], strlen( w[0] ));
+                    store_fw( rec + j + 24, ++n );
+                    for (k = 0; k < 5; k++)
+                    {
+                        v = COMPBENCH_RAND();
+                        rec[ j + 28 + k ] = (((v >> 4) % 10) << 4)
+                                          | (k < 4 ? v % 10 : 0x0C);
+                    }
+                }
+                break;
+            }
+        }
+        memset( rec, 0xff, CKD_ENDTRK_SIZE );
+    }
+
+    /* Compress and uncompress the track images */
+    for (k = 0; k < (int)_countof( comps ); k++)
+    {
+        if (!(cckdblk.comps & comps[k]))
+            continue;
+
+        inbytes = outbytes = cusecs = uusecs = 0;
+        for (i = 0; i < ntrks; i++)
+        {
+            trk  = trks + (size_t)i * trklen;
+            bufp = cbuf + (size_t)i * sizeof( buf );
+            start = cckd_usecs();
+            clen[i] = compress[k]( dev, &bufp, trk, trklen, cckdblk.compparm );
+            cusecs += cckd_usecs() - start;
+            if (bufp == trk)
+                memcpy( cbuf + (size_t)i * sizeof( buf ), trk, trklen );
+            inbytes  += trklen;
+            outbytes += clen[i];
+        }
+        for (i = 0; i < ntrks; i++)
+        {
+            trk  = trks + (size_t)i * trklen;
+            bufp = cbuf + (size_t)i * sizeof( buf );
+            start = cckd_usecs();
+            if (bufp[0] == comps[k])
+                n = uncompress[k]( dev, buf, bufp, clen[i], sizeof( buf ));
+            else if (bufp[0] == CCKD_COMPRESS_NONE)
+                memcpy( buf, bufp, n = clen[i] );
+            else
+                n = -1;
+            uusecs += cckd_usecs() - start;
+            if (n != trklen || memcmp( buf, trk, trklen ))
+                failed |= comps[k];
+        }
+
+        // "CCKD compression benchmark: %-5s %d tracks, %"PRId64" bytes to %"PRId64" (%d%%), compress %"PRId64" MB/s, uncompress %"PRId64" MB/s"
+        WRMSG( HHC00384, "I", compname[ comps[k] ], ntrks, inbytes, outbytes,
+               (int)((outbytes * 100) / inbytes),
+               inbytes / MAX( cusecs, 1 ), inbytes / MAX( uusecs, 1 ));
+    }
+
+    for (k = 0; k < (int)_countof( comps ); k++)
+    {
+        if (failed & comps[k])
+        {
+            MSGBUF( msgbuf, "%s track images did not round trip", compname[ comps[k] ] );
+            // "CCKD compression benchmark: %s"
+            WRMSG( HHC00385, "E", msgbuf );
+        }
+    }
+    if (!failed)
+        // "CCKD compression benchmark: %s"
+        WRMSG( HHC00385, "I", "all track images round trip" );
+
+compbench_exit:
+
+    free( clen );
+    free( cbuf );
+    free( trks );
+    free( cckd );
+    free( dev );
+
+#undef COMPBENCH_RAND
+#undef COMPBENCH_WORD
+
+} /* end function cckd_command_compbench */
+
 /*-------------------------------------------------------------------*/
 /* cckd_dtax return Dump Table At Exit setting                       */
 /*-------------------------------------------------------------------*/
@@ -6149,6 +7489,8 @@ int   rc;
             case CCKD_COMPRESS_NONE:
             case CCKD_COMPRESS_ZLIB:
             case CCKD_COMPRESS_BZIP2:
+            case CCKD_COMPRESS_ZSTD:
+            case CCKD_COMPRESS_LZ4:
                 cckdblk.comp = val < 0 ? 0xff : val;
                 opts = 1;
                 break;
@@ -6158,6 +7500,18 @@ int   rc;
                 return -1;
             }
         }
+        // Track compression microbenchmark
+        else if (CMD( kw, COMPBENCH, 9 ))
+        {
+            if (val < 10 || val > 1000)
+            {
+                // "CCKD file: value %d invalid for %s"
+                WRMSG( HHC00348, "E", val, kw );
+                return -1;
+            }
+            else if (cmd)
+                cckd_command_compbench( val );
+        }
         // Compression parameter to be used
         else if (CMD( kw, COMPPARM, 8 ))
         {
@@ -6263,6 +7617,33 @@ int   rc;
                 opts = 1;
             }
         }
+        // Garbage collection i/o rate
+        else if (CMD( kw, GCRATE, 6 ))
+        {
+            if (val < CCKD_MIN_GCRATE || val > CCKD_MAX_GCRATE)
+            {
+                // "CCKD file: value %d invalid for %s"
+                WRMSG( HHC00348, "E", val, kw );
+                return -1;
+            }
+            else
+            {
+                cckdblk.gcrate = val;
+                opts = 1;
+            }
+        }
+        // Free space microbenchmark
+        else if (CMD( kw, FSPBENCH, 8 ))
+        {
+            if (val < 100 || val > 100000)
+            {
+                // "CCKD file: value %d invalid for %s"
+                WRMSG( HHC00348, "E", val, kw );
+                return -1;
+            }
+            else if (cmd)
+                cckd_command_fspbench( val );
+        }
         // Start garbage collector
         else if (CMD( kw, GCSTART, 7 ))
         {
@@ -6278,6 +7659,21 @@ int   rc;
                 cckd64_gcstart();
             }
         }
+        // Garbage collection step time
+        else if (CMD( kw, GCSTEP, 6 ))
+        {
+            if (val < CCKD_MIN_GCSTEP || val > CCKD_MAX_GCSTEP)
+            {
+                // "CCKD file: value %d invalid for %s"
+                WRMSG( HHC00348, "E", val, kw );
+                return -1;
+            }
+            else
+            {
+                cckdblk.gcstep = val;
+                opts = 1;
+            }
+        }
         // Check for null linux tracks
         else if (CMD( kw, LINUXNULL, 5 ))
         {
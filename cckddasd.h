@@ -91,7 +91,9 @@ int     cfba64_write_block(DEVBLK *dev, int blkgrp, int off,
 int     cfba64_used(DEVBLK *dev);
 /*-------------------------------------------------------------------*/
 int     cckd_read_trk(DEVBLK *dev, int trk, int ra, BYTE *unitstat);
-void    cckd_readahead(DEVBLK *dev, int trk);
+void    cckd_readahead(DEVBLK *dev, int trk, int dir, int n, int strm);
+int     cckd_ra_stream(DEVBLK *dev, int trk, int useful, int *dir, int *strm);
+void    cckd_ra_wasted(U16 devnum, U32 flag);
 int     cckd_readahead_scan(int *answer, int ix, int i, void *data);
 void*   cckd_ra(void* arg);
 void    cckd_flush_cache(DEVBLK *dev);
@@ -100,11 +102,13 @@ void    cckd_flush_cache_all();
 void    cckd_purge_cache(DEVBLK *dev);
 int     cckd_purge_cache_scan(int *answer, int ix, int i, void *data);
 void*   cckd_writer(void *arg);
+int     cckd_writer_next();
 int     cckd_writer_scan(int *o, int ix, int i, void *data);
 void    cckd_writer_write( int writer, int o );
 off_t   cckd_get_space(DEVBLK *dev, int *size, int flags);
 void    cckd_rel_space(DEVBLK *dev, off_t pos, int len, int size);
 void    cckd_flush_space(DEVBLK *dev);
+void    cckd_fsp_build(DEVBLK *dev);
 int     cckd_read_chdr(DEVBLK *dev);
 int     cckd_write_chdr(DEVBLK *dev);
 int     cckd_read_l1(DEVBLK *dev);
@@ -137,8 +141,11 @@ void    cckd_lock_devchain(int flag);
 void    cckd_unlock_devchain();
 void    cckd_gcstart();
 void*   cckd_gcol(void* arg);
-void    cckd_gcol_dev( DEVBLK* dev, struct timeval* tv_now );
+int     cckd_gcol_dev( DEVBLK* dev, struct timeval* tv_now );
 int     cckd_gc_percolate(DEVBLK *dev, unsigned int size);
+int     cckd_gc_pace(U64 start, unsigned int bytes);
+U64     cckd_usecs();
+void    cckd_lat_record(S64 *hist, U64 usecs);
 int     cckd_gc_l2(DEVBLK *dev, BYTE *buf);
 DEVBLK *cckd_find_device_by_devnum (U16 devnum);
 /*-------------------------------------------------------------------*/
@@ -157,6 +164,7 @@ void    cckd64_writer_write( int writer, int o );
 S64     cckd64_get_space(DEVBLK *dev, int *size, int flags);
 void    cckd64_rel_space(DEVBLK *dev, U64 pos, int len, int size);
 void    cckd64_flush_space(DEVBLK *dev);
+void    cckd64_fsp_build(DEVBLK *dev);
 int     cckd64_read_chdr(DEVBLK *dev);
 int     cckd64_write_chdr(DEVBLK *dev);
 int     cckd64_read_l1(DEVBLK *dev);
@@ -189,7 +197,7 @@ int     cckd64_sf_new(DEVBLK *dev);
 //id    cckd64_unlock_devchain();
 void    cckd64_gcstart();
 //id*   cckd64_gcol(void* arg);
-void    cckd64_gcol_dev( DEVBLK* dev, struct timeval* tv_now );
+int     cckd64_gcol_dev( DEVBLK* dev, struct timeval* tv_now );
 int     cckd64_gc_percolate(DEVBLK *dev, unsigned int size);
 int     cckd64_gc_l2(DEVBLK *dev, BYTE *buf);
 //VBLK *cckd64_find_device_by_devnum (U16 devnum);
@@ -197,10 +205,14 @@ int     cckd64_gc_l2(DEVBLK *dev, BYTE *buf);
 BYTE   *cckd_uncompress(DEVBLK *dev, BYTE *from, int len, int maxlen, int trk);
 int     cckd_uncompress_zlib(DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen);
 int     cckd_uncompress_bzip2(DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen);
+int     cckd_uncompress_zstd(DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen);
+int     cckd_uncompress_lz4(DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen);
 int     cckd_compress(DEVBLK *dev, BYTE **to, BYTE *from, int len, int comp, int parm);
 int     cckd_compress_none(DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm);
 int     cckd_compress_zlib(DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm);
 int     cckd_compress_bzip2(DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm);
+int     cckd_compress_zstd(DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm);
+int     cckd_compress_lz4(DEVBLK *dev, BYTE **to, BYTE *from, int len, int parm);
 /*-------------------------------------------------------------------*/
 BYTE   *cckd64_uncompress(DEVBLK *dev, BYTE *from, int len, int maxlen, int trk);
 //t     cckd64_uncompress_zlib(DEVBLK *dev, BYTE *to, BYTE *from, int len, int maxlen);
@@ -214,6 +226,8 @@ CCKD_DLL_IMPORT   int     cckd_command(char *op, int cmd);
                   void    cckd_command_help();
                   void    cckd_command_opts();
                   void    cckd_command_stats();
+                  void    cckd_command_fspbench( int nfree );
+                  void    cckd_command_compbench( int ntrks );
                   void    cckd_trace( const char* func, int line,
                                       DEVBLK* dev, char* fmt, ...);
 CCKD_DLL_IMPORT   void    cckd_print_itrace();
@@ -456,6 +456,10 @@ int             rc;                     /* Return code               */
     CCKD_TRACE( "file[%d] fd[%d] read, off 0x%16.16"PRIx64" len %d",
                 sfx, cckd->fd[ sfx ], off, len );
 
+#if !defined( _MSVC_ )
+    /* Read the data at the specified offset */
+    rc = pread( cckd->fd[ sfx ], buf, len, off );
+#else
     /* Seek to specified offset */
     if (lseek( cckd->fd[ sfx ], off, SEEK_SET ) < 0)
     {
@@ -468,6 +472,7 @@ int             rc;                     /* Return code               */
 
     /* Read the data */
     rc = read( cckd->fd[ sfx ], buf, len );
+#endif
     if (rc < (int)len)
     {
         if (rc < 0)
@@ -503,6 +508,10 @@ int             rc = 0;                 /* Return code               */
     CCKD_TRACE( "file[%d] fd[%d] write, off 0x%16.16"PRIx64" len %d",
                 sfx, cckd->fd[ sfx ], off, len );
 
+#if !defined( _MSVC_ )
+    /* Write the data at the specified offset */
+    rc = pwrite( cckd->fd[ sfx ], buf, len, off );
+#else
     /* Seek to specified offset */
     if (lseek( cckd->fd[ sfx ], off, SEEK_SET ) < 0)
     {
@@ -515,6 +524,7 @@ int             rc = 0;                 /* Return code               */
 
     /* Write the data */
     rc = write( cckd->fd[ sfx ], buf, len );
+#endif
     if (rc < (int)len)
     {
         if (rc < 0)
@@ -934,11 +944,15 @@ int             fnd;                    /* Cache index for hit       */
 int             lru;                    /* Oldest unused cache index */
 int             len;                    /* Length of track image     */
 int             maxlen;                 /* Length for buffer         */
-int             curtrk = -1;            /* Current track (at entry)  */
+int             radir;                  /* Readahead direction       */
+int             rastrm;                 /* Readahead stream index    */
+int             ran = 0;                /* Number tracks to readahead*/
+int             useful;                 /* 1=Hit was read ahead      */
 U16             devnum;                 /* Device number             */
 U32             oldtrk;                 /* Stolen track number       */
 U32             flag;                   /* Cache flag                */
 BYTE           *buf;                    /* Read buffer               */
+U64             rdstart;                /* Time read started         */
 
     if (!dev->cckd64)
         return cckd_read_trk( dev, trk, ra, unitstat );
@@ -957,7 +971,6 @@ BYTE           *buf;                    /* Read buffer               */
     /* Inactivate the old entry */
     if (!ra)
     {
-        curtrk = dev->bufcur;
         if (dev->cache >= 0)
             cache_setflag(CACHE_DEVBUF, dev->cache, ~CCKD_CACHE_ACTIVE, 0);
         dev->bufcur = dev->cache = -1;
@@ -977,6 +990,7 @@ cckd_read_trk_retry:
         }
 
         /* Mark the new entry active */
+        useful = !(cache_getflag(CACHE_DEVBUF, fnd) & CCKD_CACHE_USED);
         cache_setflag(CACHE_DEVBUF, fnd, ~0, CCKD_CACHE_ACTIVE | CCKD_CACHE_USED);
         cache_setage(CACHE_DEVBUF, fnd);
 
@@ -997,6 +1011,10 @@ cckd_read_trk_retry:
 
         cckdblk.stats_switches++;  cckd->switches++;
         cckdblk.stats_cachehits++; cckd->cachehits++;
+        if (useful)
+        {
+            cckdblk.stats_rauseful++; cckd->rauseful++;
+        }
 
         /* if read/write is in progress then wait for it to finish */
         while (cache_getflag(CACHE_DEVBUF, fnd) & CCKD_CACHE_IOBUSY)
@@ -1014,11 +1032,13 @@ cckd_read_trk_retry:
                         ra, fnd, trk);
         }
 
+        ran = cckd_ra_stream (dev, trk, useful, &radir, &rastrm);
+
         release_lock (&cckd->cckdiolock);
 
         /* Asynchrously schedule readaheads */
-        if (curtrk > 0 && trk > curtrk && trk <= curtrk + 2)
-            cckd_readahead (dev, trk);
+        if (ran > 0)
+            cckd_readahead (dev, trk, radir, ran, rastrm);
 
         return fnd;
 
@@ -1054,10 +1074,9 @@ cckd_read_trk_retry:
     {
         CCKD_TRACE( "%d rdtrk[%d] %d dropping %4.4X:%d from cache",
                     ra, lru, trk, devnum, oldtrk);
-        if (!(cache_getflag(CACHE_DEVBUF, lru) & CCKD_CACHE_USED))
-        {
-            cckdblk.stats_readaheadmisses++;  cckd->misses++;
-        }
+        flag = cache_getflag(CACHE_DEVBUF, lru);
+        if ((flag & DEVBUF_TYPE_COMP) && !(flag & CCKD_CACHE_USED))
+            cckd_ra_wasted (devnum, flag);
     }
 
     /* Initialize the entry */
@@ -1080,19 +1099,26 @@ cckd_read_trk_retry:
 
     cache_unlock (CACHE_DEVBUF);
 
-    if (!ra) release_lock (&cckd->cckdiolock);
+    if (!ra)
+    {
+        ran = cckd_ra_stream (dev, trk, 0, &radir, &rastrm);
+        release_lock (&cckd->cckdiolock);
+    }
 
     /* Asynchronously schedule readaheads */
-    if (!ra && curtrk > 0 && trk > curtrk && trk <= curtrk + 2)
-        cckd_readahead (dev, trk);
+    if (ran > 0)
+        cckd_readahead (dev, trk, radir, ran, rastrm);
 
     /* Clear the buffer if batch mode */
     if (dev->batch) memset(buf, 0, maxlen);
 
     /* Read the track image */
+    rdstart = cckd_usecs();
     obtain_lock (&cckd->filelock);
     len = cckd64_read_trkimg (dev, buf, trk, unitstat);
     release_lock (&cckd->filelock);
+    if (!ra)
+        cckd_lat_record (cckdblk.stats_rdlat, cckd_usecs() - rdstart);
     cache_setval (CACHE_DEVBUF, lru, len);
 
     obtain_lock (&cckd->cckdiolock);
@@ -1275,6 +1301,7 @@ BYTE*           bufp;                   /* Buffer to be written      */
 int             len, bufl;              /* Buffer lengths            */
 int             comp;                   /* Compression algorithm     */
 int             parm;                   /* Compression parameter     */
+BYTE            modlvl;                 /* Header modlvl needed      */
 U32             flag;                   /* Cache flag                */
 BYTE            buf2[ 64*1024 ];        /* 64K Compress buffer       */
 
@@ -1292,9 +1319,13 @@ BYTE            buf2[ 64*1024 ];        /* 64K Compress buffer       */
     buf  = cache_getbuf( CACHE_DEVBUF, o, 0 );
     len  = cckd_trklen( dev, buf );
 
-    comp = len < CCKD_COMPRESS_MIN ? CCKD_COMPRESS_NONE :
-         cckdblk.comp == 0xff ? cckd->cdevhdr[ cckd->sfn ].cmp_algo
-                              : cckdblk.comp;
+    comp = cckdblk.comp == 0xff ? cckd->cdevhdr[ cckd->sfn ].cmp_algo
+                                : cckdblk.comp;
+
+    /* Small images are only worth compressing with a dictionary */
+    if (len < CCKD_COMPRESS_MIN
+        && !(comp == CCKD_COMPRESS_ZLIB && cckd->cdevhdr[ cckd->sfn ].cdh_dictlen))
+        comp = CCKD_COMPRESS_NONE;
 
     parm = cckdblk.compparm < 0 ? cckd->cdevhdr[ cckd->sfn ].cmp_parm
                                 : cckdblk.compparm;
@@ -1348,6 +1379,26 @@ BYTE            buf2[ 64*1024 ];        /* 64K Compress buffer       */
             cckd64_write_chdr( dev );
         }
 
+        /* Older releases cannot read zstd or lz4 track images, nor
+           zlib track images compressed with a preset dictionary */
+        modlvl = CCKD_MODLVL;
+        if (bufl > CKD_NULLTRK_FMTMAX)
+        {
+            if (bufp[0] & (CCKD_COMPRESS_ZSTD | CCKD_COMPRESS_LZ4))
+                modlvl = CCKD_MODLVL_ZSTDLZ4;
+            else if (1
+                && (bufp[0] & CCKD_COMPRESS_ZLIB)
+                && bufl > CKD_TRKHDR_SIZE + 1
+                && (bufp[ CKD_TRKHDR_SIZE + 1 ] & 0x20)  /* FDICT */
+            )
+                modlvl = CCKD_MODLVL_DICT;
+        }
+        if (cckd->cdevhdr[ cckd->sfn ].cdh_vrm[2] < modlvl)
+        {
+            cckd->cdevhdr[ cckd->sfn ].cdh_vrm[2] = modlvl;
+            cckd64_write_chdr( dev );
+        }
+
         /* Write the track image */
         cckd64_write_trkimg( dev, bufp, bufl, trk, CCKD_SIZE_ANY );
     }
@@ -1497,6 +1548,230 @@ U64             fpos;
 } /* end function cckd_chk_space */
 #endif // defined( DEBUG_FREESPACE )
 
+/*-------------------------------------------------------------------*/
+/* Free space index (see cckddasd.c)                                 */
+/*-------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------*/
+/* Return the treap priority of free space entry `i'                 */
+/*-------------------------------------------------------------------*/
+static U32 cckd64_fsp_pri(int i)
+{
+U32             x;                      /* Hash value                */
+
+    x = (U32)i * 0x9E3779B1;
+    x ^= x >> 16;
+    x *= 0x85EBCA6B;
+    x ^= x >> 13;
+    return x;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return whether free space `i' goes before `t' in tree `k'         */
+/*-------------------------------------------------------------------*/
+static int cckd64_fsp_before(CCKD64_IFREEBLK *ifb, int k, int i, int t)
+{
+    if (k == CCKD_FSP_SIZE && ifb[i].ifb_len != ifb[t].ifb_len)
+        return ifb[i].ifb_len < ifb[t].ifb_len;
+    return ifb[i].ifb_off < ifb[t].ifb_off;
+}
+
+/*-------------------------------------------------------------------*/
+/* Insert free space `i' into the subtree of tree `k' rooted at `t'  */
+/*-------------------------------------------------------------------*/
+static int cckd64_fsp_ins(CCKD64_IFREEBLK *ifb, int k, int t, int i)
+{
+int             d;                      /* Direction (0=lower)       */
+int             c;                      /* Child to rotate up        */
+
+    if (t < 0)
+    {
+        ifb[i].ifb_child[k][0] = ifb[i].ifb_child[k][1] = -1;
+        return i;
+    }
+
+    d = !cckd64_fsp_before(ifb, k, i, t);
+    c = ifb[t].ifb_child[k][d] = cckd64_fsp_ins(ifb, k, ifb[t].ifb_child[k][d], i);
+    if (cckd64_fsp_pri(c) > cckd64_fsp_pri(t))
+    {
+        ifb[t].ifb_child[k][d] = ifb[c].ifb_child[k][!d];
+        ifb[c].ifb_child[k][!d] = t;
+        return c;
+    }
+    return t;
+}
+
+/*-------------------------------------------------------------------*/
+/* Join subtrees `a' and `b' of tree `k', all of `a' before `b'      */
+/*-------------------------------------------------------------------*/
+static int cckd64_fsp_join(CCKD64_IFREEBLK *ifb, int k, int a, int b)
+{
+    if (a < 0) return b;
+    if (b < 0) return a;
+
+    if (cckd64_fsp_pri(a) > cckd64_fsp_pri(b))
+    {
+        ifb[a].ifb_child[k][1] = cckd64_fsp_join(ifb, k, ifb[a].ifb_child[k][1], b);
+        return a;
+    }
+    ifb[b].ifb_child[k][0] = cckd64_fsp_join(ifb, k, a, ifb[b].ifb_child[k][0]);
+    return b;
+}
+
+/*-------------------------------------------------------------------*/
+/* Remove free space `i' from the subtree of tree `k' rooted at `t'  */
+/*-------------------------------------------------------------------*/
+static int cckd64_fsp_del(CCKD64_IFREEBLK *ifb, int k, int t, int i)
+{
+int             d;                      /* Direction (0=lower)       */
+
+    if (t < 0)
+        return t;
+    if (t == i)
+        return cckd64_fsp_join(ifb, k, ifb[t].ifb_child[k][0], ifb[t].ifb_child[k][1]);
+    d = !cckd64_fsp_before(ifb, k, i, t);
+    ifb[t].ifb_child[k][d] = cckd64_fsp_del(ifb, k, ifb[t].ifb_child[k][d], i);
+    return t;
+}
+
+/*-------------------------------------------------------------------*/
+/* Add or remove a free space in the offset tree                     */
+/*-------------------------------------------------------------------*/
+static void cckd64_fsp_off_add(CCKD64_EXT *cckd, int i)
+{
+    cckd->free_root[CCKD_FSP_OFFSET] = cckd64_fsp_ins(cckd->ifb,
+        CCKD_FSP_OFFSET, cckd->free_root[CCKD_FSP_OFFSET], i);
+}
+
+static void cckd64_fsp_off_del(CCKD64_EXT *cckd, int i)
+{
+    cckd->free_root[CCKD_FSP_OFFSET] = cckd64_fsp_del(cckd->ifb,
+        CCKD_FSP_OFFSET, cckd->free_root[CCKD_FSP_OFFSET], i);
+}
+
+/*-------------------------------------------------------------------*/
+/* Add a free space to the size tree if it is not pending, or        */
+/* remove it.  The length and offset must not change in between.     */
+/*-------------------------------------------------------------------*/
+static void cckd64_fsp_size_add(CCKD64_EXT *cckd, int i)
+{
+    if ((cckd->ifb[i].ifb_sized = !cckd->ifb[i].ifb_pending))
+        cckd->free_root[CCKD_FSP_SIZE] = cckd64_fsp_ins(cckd->ifb,
+            CCKD_FSP_SIZE, cckd->free_root[CCKD_FSP_SIZE], i);
+}
+
+static void cckd64_fsp_size_del(CCKD64_EXT *cckd, int i)
+{
+    if (cckd->ifb[i].ifb_sized)
+        cckd->free_root[CCKD_FSP_SIZE] = cckd64_fsp_del(cckd->ifb,
+            CCKD_FSP_SIZE, cckd->free_root[CCKD_FSP_SIZE], i);
+    cckd->ifb[i].ifb_sized = 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the last free space before offset `pos', or -1             */
+/*-------------------------------------------------------------------*/
+static int cckd64_fsp_prev(CCKD64_EXT *cckd, U64 pos)
+{
+int             t, p = -1;              /* Free space indexes        */
+
+    for (t = cckd->free_root[CCKD_FSP_OFFSET]; t >= 0; )
+    {
+        if (cckd->ifb[t].ifb_off < pos)
+        {
+            p = t;
+            t = cckd->ifb[t].ifb_child[CCKD_FSP_OFFSET][1];
+        }
+        else
+            t = cckd->ifb[t].ifb_child[CCKD_FSP_OFFSET][0];
+    }
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+/* Find the free space that best fits `len' bytes                    */
+/*                                                                   */
+/* A free space fits if it is exactly `len' bytes or if it leaves    */
+/* room for a free block after `len' bytes.  The smallest fitting    */
+/* free space at or above the level 2 table bounds is chosen, the    */
+/* lowest in the file if there are several.  Returns -1 if none.     */
+/*-------------------------------------------------------------------*/
+static int cckd64_fsp_best(CCKD64_EXT *cckd, U64 len)
+{
+CCKD64_IFREEBLK  *ifb = cckd->ifb;        /* -> free space entries     */
+int             t, best;                /* Free space indexes        */
+U64             minlen;                 /* Minimum length            */
+U64             minoff;                 /* Minimum offset at minlen  */
+
+    minlen = len;
+    minoff = cckd->L2_bounds;
+    for ( ; ; )
+    {
+        /* Find the first free space at or after (minlen, minoff) */
+        best = -1;
+        for (t = cckd->free_root[CCKD_FSP_SIZE]; t >= 0; )
+        {
+            if (ifb[t].ifb_len > minlen
+             || (ifb[t].ifb_len == minlen && ifb[t].ifb_off >= minoff))
+            {
+                best = t;
+                t = ifb[t].ifb_child[CCKD_FSP_SIZE][0];
+            }
+            else
+                t = ifb[t].ifb_child[CCKD_FSP_SIZE][1];
+        }
+        if (best < 0)
+            return -1;
+
+        /* Skip lengths that leave no room for a free block, and
+           free spaces of this length below the level 2 bounds */
+        if (ifb[best].ifb_len != len
+         && ifb[best].ifb_len < len + CCKD64_FREEBLK_SIZE)
+            minlen = len + CCKD64_FREEBLK_SIZE;
+        else if (ifb[best].ifb_off < cckd->L2_bounds)
+            minlen = ifb[best].ifb_len;
+        else
+            return best;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the largest free space that is not pending                 */
+/*-------------------------------------------------------------------*/
+static U64 cckd64_fsp_largest(CCKD64_EXT *cckd)
+{
+int             t;                      /* Free space index          */
+
+    if ((t = cckd->free_root[CCKD_FSP_SIZE]) < 0)
+        return 0;
+    while (cckd->ifb[t].ifb_child[CCKD_FSP_SIZE][1] >= 0)
+        t = cckd->ifb[t].ifb_child[CCKD_FSP_SIZE][1];
+    return cckd->ifb[t].ifb_len;
+}
+
+/*-------------------------------------------------------------------*/
+/* Build the free space index from the free space chain              */
+/*-------------------------------------------------------------------*/
+void cckd64_fsp_build(DEVBLK *dev)
+{
+CCKD64_EXT       *cckd;                   /* -> cckd extension         */
+U64             fpos;                   /* Free space offset         */
+int             i;                      /* Free space index          */
+
+    cckd = dev->cckd_ext;
+
+    cckd->free_root[CCKD_FSP_OFFSET] = cckd->free_root[CCKD_FSP_SIZE] = -1;
+
+    fpos = cckd->cdevhdr[cckd->sfn].free_off;
+    for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
+    {
+        cckd->ifb[i].ifb_off = fpos;
+        cckd64_fsp_off_add(cckd, i);
+        cckd64_fsp_size_add(cckd, i);
+        fpos = cckd->ifb[i].ifb_offnxt;
+    }
+}
+
 /*-------------------------------------------------------------------*/
 /* Get file space                                                    */
 /*-------------------------------------------------------------------*/
@@ -1558,20 +1833,24 @@ cckd_get_space_atend:
         return fpos;
     }
 
-    /* Scan free space chain */
-    fpos = cckd->cdevhdr[sfx].free_off;
-    for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
+    /* Level 2 tables go in the first free space that fits, keeping
+       them towards the beginning of the file; track images go in
+       the free space that fits best */
+    if (flags & CCKD_L2SPACE)
     {
-        if (cckd->ifb[i].ifb_pending == 0
-         && ((U64)len2 <= cckd->ifb[i].ifb_len || (U64)len == cckd->ifb[i].ifb_len)
-         && ((flags & CCKD_L2SPACE) || (U64)fpos >= cckd->L2_bounds))
-            break;
-        fpos = cckd->ifb[i].ifb_offnxt;
+        for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
+            if (cckd->ifb[i].ifb_pending == 0
+             && ((U64)len2 <= cckd->ifb[i].ifb_len || (U64)len == cckd->ifb[i].ifb_len))
+                break;
     }
+    else
+        i = cckd64_fsp_best (cckd, len);
 
     /* This can happen if largest comes before L2_bounds */
     if (i < 0) goto cckd_get_space_atend;
 
+    fpos = cckd->ifb[i].ifb_off;
+
     flen = cckd->ifb[i].ifb_len;
     p = cckd->ifb[i].ifb_idxprv;
     n = cckd->ifb[i].ifb_idxnxt;
@@ -1584,17 +1863,21 @@ cckd_get_space_atend:
         *size = (int)flen;
 
     /* Remove the new space from free space */
+    cckd64_fsp_size_del (cckd, i);
     if (*size < (int)flen)
     {
         cckd->ifb[i].ifb_len -= *size;
+        cckd->ifb[i].ifb_off += *size;
         if (p >= 0)
             cckd->ifb[p].ifb_offnxt += *size;
         else
             cckd->cdevhdr[sfx].free_off += *size;
+        cckd64_fsp_size_add (cckd, i);
     }
     else
     {
         cckd->cdevhdr[sfx].free_num--;
+        cckd64_fsp_off_del (cckd, i);
 
         /* Remove the free space entry from the chain */
         if (p >= 0)
@@ -1620,14 +1903,7 @@ cckd_get_space_atend:
 
     /* Find the largest free space if we got the largest */
     if ((U64)flen >= cckd->cdevhdr[sfx].free_largest)
-    {
-        int i;
-        cckd->cdevhdr[sfx].free_largest = 0;
-        for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
-            if (cckd->ifb[i].ifb_len > cckd->cdevhdr[sfx].free_largest
-             && cckd->ifb[i].ifb_pending == 0)
-                cckd->cdevhdr[sfx].free_largest = cckd->ifb[i].ifb_len;
-    }
+        cckd->cdevhdr[sfx].free_largest = cckd64_fsp_largest (cckd);
 
     /* Update free space stats */
     cckd->cdevhdr[sfx].cdh_used += len;
@@ -1649,7 +1925,7 @@ void cckd64_rel_space(DEVBLK *dev, U64 pos, int len, int size)
 {
 CCKD64_EXT     *cckd;                   /* -> cckd extension         */
 int             sfx;                    /* Shadow file index         */
-U64             ppos, npos;             /* Prev/next free offsets    */
+U64             ppos;                   /* Prev free offset          */
 int             i, p, n;                /* Free space indexes        */
 int             pending;                /* Calculated pending value  */
 U64             fsize = size;           /* Free space size           */
@@ -1673,16 +1949,10 @@ U64             fsize = size;           /* Free space size           */
 
     CCKD_CHK_SPACE(dev);
 
-    /* Scan free space chain */
-    ppos = -1;
-    npos = cckd->cdevhdr[sfx].free_off;
-    for (p = -1, n = cckd->free_idx1st; n >= 0; n = cckd->ifb[n].ifb_idxnxt)
-    {
-        if (pos < npos) break;
-        ppos = npos;
-        npos = cckd->ifb[n].ifb_offnxt;
-        p = n;
-    }
+    /* Find the free spaces either side in the free space chain */
+    p = cckd64_fsp_prev (cckd, pos);
+    n = p >= 0 ? cckd->ifb[p].ifb_idxnxt : cckd->free_idx1st;
+    ppos = p >= 0 ? cckd->ifb[p].ifb_off : (U64)-1;
 
     /* Calculate the `pending' value */
     pending = cckdblk.freepend >= 0 ? cckdblk.freepend : 1 + (1 - cckdblk.fsync);
@@ -1690,8 +1960,10 @@ U64             fsize = size;           /* Free space size           */
     /* If possible use previous adjacent free space otherwise get an available one */
     if (p >= 0 && ppos + cckd->ifb[p].ifb_len == pos && cckd->ifb[p].ifb_pending == pending)
     {
+        cckd64_fsp_size_del (cckd, p);
         cckd->ifb[p].ifb_len += size;
         fsize = cckd->ifb[p].ifb_len;
+        cckd64_fsp_size_add (cckd, p);
     }
     else
     {
@@ -1719,6 +1991,9 @@ U64             fsize = size;           /* Free space size           */
         cckd->ifb[i].ifb_idxnxt = n;
         cckd->ifb[i].ifb_len = size;
         cckd->ifb[i].ifb_pending = pending;
+        cckd->ifb[i].ifb_off = pos;
+        cckd64_fsp_off_add (cckd, i);
+        cckd64_fsp_size_add (cckd, i);
 
         /* Update the previous entry */
         if (p >= 0)
@@ -1783,6 +2058,7 @@ U64             ppos, pos;              /* Free space offsets        */
         cckd->cdevhdr[sfx].free_num = 0;
         cckd->cdevhdr[sfx].free_off = 0;
         cckd->free_idx1st = cckd->free_idxlast = cckd->free_idxavail = -1;
+        cckd64_fsp_build (dev);
     }
 
     pos = cckd->cdevhdr[sfx].free_off;
@@ -1792,6 +2068,7 @@ U64             ppos, pos;              /* Free space offsets        */
     for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
     {
         /* Decrement the pending count */
+        cckd64_fsp_size_del (cckd, i);
         if (cckd->ifb[i].ifb_pending)
             --cckd->ifb[i].ifb_pending;
 
@@ -1802,6 +2079,8 @@ U64             ppos, pos;              /* Free space offsets        */
             if (cckd->ifb[n].ifb_pending > cckd->ifb[i].ifb_pending + 1
              || cckd->ifb[n].ifb_pending < cckd->ifb[i].ifb_pending)
                 break;
+            cckd64_fsp_size_del (cckd, n);
+            cckd64_fsp_off_del (cckd, n);
             cckd->ifb[i].ifb_offnxt  = cckd->ifb[n].ifb_offnxt;
             cckd->ifb[i].ifb_len += cckd->ifb[n].ifb_len;
             cckd->ifb[i].ifb_idxnxt = cckd->ifb[n].ifb_idxnxt;
@@ -1812,6 +2091,7 @@ U64             ppos, pos;              /* Free space offsets        */
                 cckd->ifb[n].ifb_idxprv = i;
 
         }
+        cckd64_fsp_size_add (cckd, i);
         ppos = pos;
         pos = cckd->ifb[i].ifb_offnxt;
         cckd->cdevhdr[sfx].free_num++;
@@ -1836,6 +2116,8 @@ U64             ppos, pos;              /* Free space offsets        */
                     sfx, ppos, cckd->ifb[i].ifb_len);
 
         /* Remove the entry from the chain */
+        cckd64_fsp_size_del (cckd, i);
+        cckd64_fsp_off_del (cckd, i);
         if (p >= 0)
         {
             cckd->ifb[p].ifb_offnxt = 0;
@@ -1857,13 +2139,7 @@ U64             ppos, pos;              /* Free space offsets        */
         cckd->cdevhdr[sfx].free_total -= cckd->ifb[i].ifb_len;
         cckd->cdevhdr[sfx].free_num--;
         if (cckd->ifb[i].ifb_len >= cckd->cdevhdr[sfx].free_largest)
-        {
-            cckd->cdevhdr[sfx].free_largest = 0;
-            for (i = cckd->free_idx1st; i >= 0; i = cckd->ifb[i].ifb_idxnxt)
-                if (cckd->ifb[i].ifb_len > cckd->cdevhdr[sfx].free_largest
-                 && cckd->ifb[i].ifb_pending == 0)
-                    cckd->cdevhdr[sfx].free_largest = cckd->ifb[i].ifb_len;
-        }
+            cckd->cdevhdr[sfx].free_largest = cckd64_fsp_largest (cckd);
 
         /* Truncate the file */
         cckd64_ftruncate (dev, sfx, cckd->cdevhdr[sfx].cdh_size);
@@ -1896,6 +2172,16 @@ int             sfx;                    /* File index                */
     if (cckd64_read (dev, sfx, CKD_DEVHDR_SIZE, &cckd->cdevhdr[sfx], CCKD64_DEVHDR_SIZE) < 0)
         return -1;
 
+    /* Refuse images with track images this release cannot read */
+    if (!CCKD_VRM_SUPPORTED( cckd->cdevhdr[sfx].cdh_vrm ))
+    {
+        // "%1d:%04X CCKD file %s: header level %u.%u.%u is not supported"
+        WRMSG( HHC00386, "E", LCSS_DEVNUM, cckd_sf_name( dev, sfx ),
+               cckd->cdevhdr[sfx].cdh_vrm[0], cckd->cdevhdr[sfx].cdh_vrm[1],
+               cckd->cdevhdr[sfx].cdh_vrm[2] );
+        return -1;
+    }
+
     /* Check endian format */
     cckd->swapend[sfx] = 0;
     if ((cckd->cdevhdr[sfx].cdh_opts & CCKD_OPT_BIGEND) != cckd_def_opt_bigend())
@@ -1943,10 +2229,12 @@ int             sfx;                    /* File index                */
 
     CCKD_TRACE( "file[%d] write_chdr", sfx);
 
-    /* Set version.release.modlvl */
+    /* Set version.release.modlvl, keeping a higher modlvl that
+       marks an image as having zstd, lz4 or dictionary tracks */
     cckd->cdevhdr[sfx].cdh_vrm[0] = CCKD_VERSION;
     cckd->cdevhdr[sfx].cdh_vrm[1] = CCKD_RELEASE;
-    cckd->cdevhdr[sfx].cdh_vrm[2] = CCKD_MODLVL;
+    if (cckd->cdevhdr[sfx].cdh_vrm[2] < CCKD_MODLVL)
+        cckd->cdevhdr[sfx].cdh_vrm[2] = CCKD_MODLVL;
 
     if (cckd64_write (dev, sfx, CCKD64_DEVHDR_POS, &cckd->cdevhdr[sfx], CCKD64_DEVHDR_SIZE) < 0)
         return -1;
@@ -2219,6 +2507,9 @@ CCKD64_FREEBLK  freeblk;                /* First freeblk read        */
 
     /* Set minimum free space size */
     cckd->free_minsize = CCKD_MIN_FREESIZE( cckd->free_count );
+
+    /* Build the free space index */
+    cckd64_fsp_build (dev);
     return 0;
 
 } /* end function cckd_read_fsp */
@@ -4023,7 +4314,7 @@ S64             free_count=0;           /* Total number free spaces  */
     WRMSG (HHC00333, "I", LCSS_DEVNUM);
 
     if (cckd->readaheads || cckd->misses)
-    // "%1d:%04X                                                      readaheads   misses"
+    // "%1d:%04X                                                      readaheads   misses   useful"
     WRMSG (HHC00334, "I", LCSS_DEVNUM);
 
     // "%1d:%04X ------------------------------------------------------------------------"
@@ -4044,9 +4335,9 @@ S64             free_count=0;           /* Total number free spaces  */
     );
 
     if (cckd->readaheads || cckd->misses)
-    // "%1d:%04X                                                         %7.7d  %7.7d"
+    // "%1d:%04X                                                         %7.7d  %7.7d  %7.7d"
     WRMSG (HHC00337, "I", LCSS_DEVNUM,
-            cckd->readaheads, cckd->misses);
+            cckd->readaheads, cckd->misses, cckd->rauseful);
 
     /* base file statistics */
 
@@ -4161,10 +4452,14 @@ void cckd64_gcstart()
 
 /*-------------------------------------------------------------------*/
 /* Perform garbage collection for a given CCKD64 device              */
+/*                                                                   */
+/* Returns 1 if the collection step was cut short by the step time   */
+/* limit or the i/o budget and the cycle should be resumed shortly.  */
 /*-------------------------------------------------------------------*/
-void cckd64_gcol_dev( DEVBLK* dev, struct timeval* tv_now )
+int cckd64_gcol_dev( DEVBLK* dev, struct timeval* tv_now )
 {
 int             rc;                     /* Return code               */
+int             more;                   /* 1=Cycle not complete      */
 CCKD64_EXT     *cckd;                   /* -> cckd extension         */
 U64             size, fsiz;             /* File size, free size      */
 int             gc;                     /* Garbage collection state  */
@@ -4176,10 +4471,7 @@ int             gctab[5]= {             /* default gcol parameters   */
                             256};       /* none       0%   -   6.3%  */
 
     if (!dev->cckd64)
-    {
-        cckd_gcol_dev( dev, tv_now );
-        return;
-    }
+        return cckd_gcol_dev( dev, tv_now );
 
     cckd = dev->cckd_ext;
 
@@ -4189,14 +4481,14 @@ int             gctab[5]= {             /* default gcol parameters   */
         if (cckd->merging || cckd->stopping)
         {
             release_lock (&cckd->cckdiolock);
-            return;
+            return 0;
         }
 
         /* Bypass if not opened read-write */
         if (cckd->open[cckd->sfn] != CCKD_OPEN_RW)
         {
             release_lock (&cckd->cckdiolock);
-            return;
+            return 0;
         }
 
         /* Free newbuf if it hasn't been used */
@@ -4210,7 +4502,7 @@ int             gctab[5]= {             /* default gcol parameters   */
         {
             if (cckd->updated) cckd64_flush_cache (dev);
             release_lock (&cckd->cckdiolock);
-            return;
+            return 0;
         }
 
         /* Determine garbage state */
@@ -4237,11 +4529,16 @@ int             gctab[5]= {             /* default gcol parameters   */
             size = cckd->cdevhdr[cckd->sfn].cdh_used >> SHIFT_1K;
         if (size < 64)
             size = 64;
+
+        /* Resume a cycle whose last step was cut short */
+        if (cckd->gcleft)
+            size = cckd->gcleft;
     }
     release_lock (&cckd->cckdiolock);
 
     /* Call the garbage collector */
     cckd64_gc_percolate (dev, (unsigned int)size);
+    more = cckd->gcleft != 0;
 
     /* Schedule any updated tracks to be written */
     obtain_lock (&cckd->cckdiolock);
@@ -4270,8 +4567,8 @@ int             gctab[5]= {             /* default gcol parameters   */
         release_lock (&cckd->filelock);
     }
 
-    /* Flush the free space */
-    if (cckd->cdevhdr[cckd->sfn].free_num)
+    /* Flush the free space once the cycle is complete */
+    if (!more && cckd->cdevhdr[cckd->sfn].free_num)
     {
         obtain_lock (&cckd->filelock);
         {
@@ -4279,6 +4576,8 @@ int             gctab[5]= {             /* default gcol parameters   */
         }
         release_lock (&cckd->filelock);
     }
+
+    return more;
 }
 
 /*-------------------------------------------------------------------*/
@@ -4299,12 +4598,15 @@ int             trk;                    /* Track number              */
 int             L1idx, l2x;             /* Table Indexes             */
 CCKD64_L2ENT    l2;                     /* Copied level 2 entry      */
 BYTE            buf[256*1024];          /* Buffer                    */
+U64             start, held;            /* Step, lock start times    */
 
     if (!dev->cckd64)
         return cckd_gc_percolate( dev, size );
 
     cckd = dev->cckd_ext;
     size = size << SHIFT_1K;
+    start = cckd_usecs();
+    cckd->gcleft = 0;
 
     /* Debug */
     OBTAIN_TRACE_LOCK();
@@ -4339,6 +4641,7 @@ BYTE            buf[256*1024];          /* Buffer                    */
     while (moved < size && after < 4)
     {
         obtain_lock (&cckd->filelock);
+        held = cckd_usecs();
         sfx = cckd->sfn;
 
         /* Exit if no more free space */
@@ -4499,6 +4802,17 @@ BYTE            buf[256*1024];          /* Buffer                    */
         cckdblk.stats_gcolbytes += i;
 
         release_lock (&cckd->filelock);
+        cckd_lat_record (cckdblk.stats_gclat, cckd_usecs() - held);
+
+        /* End the step if it has used its time or the i/o budget,
+           leaving the rest of the cycle for the next step */
+        if (moved < size && after < 4 && cckd_gc_pace (start, (unsigned int)i))
+        {
+            cckd->gcleft = (unsigned int)((size - moved + 1023) >> SHIFT_1K);
+            CCKD_TRACE( "gcperc step ended, moved %u left %uK",
+                        (unsigned int)moved, cckd->gcleft);
+            break;
+        }
 
     } /* while (moved < size) */
 
@@ -4694,7 +5008,6 @@ CCKD64_EXT     *cckd;
 BYTE           *to = NULL;                /* Uncompressed buffer     */
 int             newlen;                   /* Uncompressed length     */
 BYTE            comp;                     /* Compression type        */
-static char    *compress[] = {"none", "zlib", "bzip2"};
 
     cckd = dev->cckd_ext;
 
@@ -4727,6 +5040,14 @@ static char    *compress[] = {"none", "zlib", "bzip2"};
         to = cckd->newbuf;
         newlen = cckd_uncompress_bzip2 (dev, to, from, len, maxlen);
         break;
+    case CCKD_COMPRESS_ZSTD:
+        to = cckd->newbuf;
+        newlen = cckd_uncompress_zstd (dev, to, from, len, maxlen);
+        break;
+    case CCKD_COMPRESS_LZ4:
+        to = cckd->newbuf;
+        newlen = cckd_uncompress_lz4 (dev, to, from, len, maxlen);
+        break;
     default:
         newlen = -1;
         break;
@@ -4784,12 +5105,34 @@ static char    *compress[] = {"none", "zlib", "bzip2"};
         return to;
     }
 
+    /* zstd compression */
+    to = cckd->newbuf;
+    newlen = cckd_uncompress_zstd  (dev, to, from, len, maxlen);
+    newlen = cckd64_validate       (dev, to, trk, newlen);
+    if (newlen > 0)
+    {
+        cckd->newbuf = from;
+        cckd->bufused = 1;
+        return to;
+    }
+
+    /* lz4 compression */
+    to = cckd->newbuf;
+    newlen = cckd_uncompress_lz4   (dev, to, from, len, maxlen);
+    newlen = cckd64_validate       (dev, to, trk, newlen);
+    if (newlen > 0)
+    {
+        cckd->newbuf = from;
+        cckd->bufused = 1;
+        return to;
+    }
+
     /* Unable to uncompress */
     WRMSG (HHC00343, "E",
             LCSS_DEVNUM, cckd->sfn, cckd_sf_name(dev, cckd->sfn), trk,
             from[0], from[1], from[2], from[3], from[4]);
     if (comp & ~cckdblk.comps)
         WRMSG (HHC00344, "E",
-                LCSS_DEVNUM, cckd->sfn, cckd_sf_name(dev, cckd->sfn), compress[comp]);
+                LCSS_DEVNUM, cckd->sfn, cckd_sf_name(dev, cckd->sfn), compname[comp]);
     return NULL;
 }
@@ -57,6 +57,8 @@ static void           *bulk      = NULL;    /* bulk data buffer      */
 static int             fd        = 0;       /* File descriptor       */
 static int             debug     = 0;       /* disable debug code    */
 static int             pausesnap = 0;       /* 1 = pause after snap  */
+static BYTE           *dict      = NULL;    /* preset dictionary     */
+static int             dictlen   = 0;       /* preset dictionary len */
 
 /*-------------------------------------------------------------------*/
 /* Common ErrExit function                                           */
@@ -192,7 +194,7 @@ static int decomptrk
     char*  emsg                 /* addr of 81 byte msg buf or NULL   */
 )
 {
-#if defined( HAVE_ZLIB ) || defined( CCKD_BZIP2 )
+#if defined( HAVE_ZLIB ) || defined( CCKD_BZIP2 ) || defined( CCKD_LZ4 )
     int             rc;         /* Return code                       */
 #endif
     unsigned int    bufl;       /* Buffer length                     */
@@ -200,7 +202,11 @@ static int decomptrk
     unsigned int    ubufl;      /* when size_t != unsigned int       */
 #endif
 
-#if !defined( HAVE_ZLIB ) && !defined( CCKD_BZIP2 )
+#if defined( CCKD_ZSTD )
+    size_t          zstdlen;    /* zstd return value                 */
+#endif
+
+#if !defined( HAVE_ZLIB ) && !defined( CCKD_BZIP2 ) && !defined( CCKD_ZSTD ) && !defined( CCKD_LZ4 )
     UNREFERENCED(heads);
     UNREFERENCED(trk);
     UNREFERENCED(emsg);
@@ -221,10 +227,21 @@ static int decomptrk
     case CCKD_COMPRESS_ZLIB:
         memcpy (obuf, ibuf, CKD_TRKHDR_SIZE);
         bufl = obuflen - CKD_TRKHDR_SIZE;
-        rc = uncompress(&obuf[ CKD_TRKHDR_SIZE ],
-                         (void *)&bufl,
-                         &ibuf[ CKD_TRKHDR_SIZE ],
-                         ibuflen);
+        if (dict)
+        {
+            rc = cckd_inflate_dict(&obuf[ CKD_TRKHDR_SIZE ],
+                                   (int)bufl,
+                                   &ibuf[ CKD_TRKHDR_SIZE ],
+                                   ibuflen - CKD_TRKHDR_SIZE,
+                                   dict, dictlen);
+            bufl = rc < 0 ? 0 : rc;
+            rc   = rc < 0 ? Z_DATA_ERROR : Z_OK;
+        }
+        else
+            rc = uncompress(&obuf[ CKD_TRKHDR_SIZE ],
+                             (void *)&bufl,
+                             &ibuf[ CKD_TRKHDR_SIZE ],
+                             ibuflen);
         if (rc != Z_OK)
         {
             if (emsg)
@@ -273,6 +290,65 @@ static int decomptrk
         break;
 #endif
 
+#if defined( CCKD_ZSTD )
+    case CCKD_COMPRESS_ZSTD:
+        memcpy(obuf, ibuf, CKD_TRKHDR_SIZE);
+        zstdlen = ZSTD_decompress
+        (
+            &obuf[ CKD_TRKHDR_SIZE ],
+            obuflen - CKD_TRKHDR_SIZE,
+            &ibuf[ CKD_TRKHDR_SIZE ],
+            ibuflen - CKD_TRKHDR_SIZE
+        );
+        if (ZSTD_isError(zstdlen))
+        {
+            if (emsg)
+            {
+                char msg[81];
+
+                MSGBUF(msg, "%s %d decompress error, %s;"
+                         "%2.2x%2.2x%2.2x%2.2x%2.2x",
+                         heads >= 0 ? "trk" : "blk", trk,
+                         ZSTD_getErrorName(zstdlen),
+                         ibuf[0], ibuf[1], ibuf[2], ibuf[3], ibuf[4]);
+                memcpy(emsg, msg, 81);
+            }
+            return -1;
+        }
+        bufl = (unsigned int)zstdlen;
+        bufl += CKD_TRKHDR_SIZE;
+        break;
+#endif
+
+#if defined( CCKD_LZ4 )
+    case CCKD_COMPRESS_LZ4:
+        memcpy(obuf, ibuf, CKD_TRKHDR_SIZE);
+        rc = LZ4_decompress_safe
+        (
+            (const char *)&ibuf[ CKD_TRKHDR_SIZE ],
+            (char *)&obuf[ CKD_TRKHDR_SIZE ],
+            ibuflen - CKD_TRKHDR_SIZE,
+            obuflen - CKD_TRKHDR_SIZE
+        );
+        if (rc < 0)
+        {
+            if (emsg)
+            {
+                char msg[81];
+
+                MSGBUF(msg, "%s %d decompress error, rc=%d;"
+                         "%2.2x%2.2x%2.2x%2.2x%2.2x",
+                         heads >= 0 ? "trk" : "blk", trk, rc,
+                         ibuf[0], ibuf[1], ibuf[2], ibuf[3], ibuf[4]);
+                memcpy(emsg, msg, 81);
+            }
+            return -1;
+        }
+        bufl = rc;
+        bufl += CKD_TRKHDR_SIZE;
+        break;
+#endif
+
     default:
         return -1;
 
@@ -757,6 +833,12 @@ char            pathname[ MAX_PATH ];   /* file path in host format  */
     swapend = (cckd_def_opt_bigend() !=
                ((cdevhdr.cdh_opts & CCKD_OPT_BIGEND) != 0));
 
+    /* Preset compression dictionary, if any */
+    dictlen = swapend ? SWAP16( cdevhdr.cdh_dictlen ) : cdevhdr.cdh_dictlen;
+    if (dictlen > CCKD_DICT_SIZE)
+        dictlen = 0;
+    dict = dictlen ? cdevhdr.cdh_dict : NULL;
+
     /*---------------------------------------------------------------*/
     /* display L1TAB - follows CDEVHDR                               */
     /*---------------------------------------------------------------*/
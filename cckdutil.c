@@ -41,7 +41,13 @@ DLL_EXPORT const char* comp_to_str( BYTE comp )
     {
         "none",
         "zlib",
-        "bzip2"
+        "bzip2",
+        "?????",
+        "zstd",
+        "?????",
+        "?????",
+        "?????",
+        "lz4"
     };
 
     return (comp < _countof( comp_types )) ?
@@ -73,6 +79,177 @@ DLL_EXPORT const char* spc_typ_to_str( BYTE spc_typ )
         spc_types[ spc_typ ] : "???????";
 }
 
+/*-------------------------------------------------------------------*/
+/* Inflate a zlib stream which may need a preset dictionary          */
+/*-------------------------------------------------------------------*/
+/* Returns the uncompressed length, or -1 if the stream is invalid   */
+/* or was compressed with a dictionary other than `dict'.            */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int cckd_inflate_dict( BYTE* to, int tolen, BYTE* from,
+                                  int fromlen, const BYTE* dict, int dictlen )
+{
+#if defined( HAVE_ZLIB )
+z_stream        z;                      /* zlib stream               */
+int             rc;                     /* Return code               */
+
+    memset( &z, 0, sizeof( z ));
+    z.next_in   = from;
+    z.avail_in  = fromlen;
+    z.next_out  = to;
+    z.avail_out = tolen;
+
+    if (inflateInit( &z ) != Z_OK)
+        return -1;
+
+    rc = inflate( &z, Z_FINISH );
+    if (rc == Z_NEED_DICT)
+    {
+        if (dict == NULL || dictlen <= 0
+         || inflateSetDictionary( &z, dict, dictlen ) != Z_OK)
+        {
+            inflateEnd( &z );
+            return -1;
+        }
+        rc = inflate( &z, Z_FINISH );
+    }
+    inflateEnd( &z );
+
+    return rc == Z_STREAM_END ? (int) z.total_out : -1;
+#else
+    UNREFERENCED( to );
+    UNREFERENCED( tolen );
+    UNREFERENCED( from );
+    UNREFERENCED( fromlen );
+    UNREFERENCED( dict );
+    UNREFERENCED( dictlen );
+    return -1;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* Train a preset compression dictionary from sample track images    */
+/*-------------------------------------------------------------------*/
+/* `samples' holds `nsamples' uncompressed images (without the track */
+/* header) back to back; `lens' holds their lengths.                 */
+/*                                                                   */
+/* Every DICT_KMER byte string is scored by the number of samples    */
+/* it occurs in.  The DICT_SEG byte segment with the highest total   */
+/* score is added to the dictionary and the scores of its strings    */
+/* are zeroed so the next segment covers something new.  This        */
+/* repeats until the dictionary is full or no segment is shared by   */
+/* enough samples.                                                   */
+/* zlib codes short distances more cheaply, so segments are placed   */
+/* from the end of the dictionary backwards, best first.             */
+/*                                                                   */
+/* Returns the dictionary length, which may be zero.                 */
+/*-------------------------------------------------------------------*/
+#define DICT_KMER       6               /* Scored string length      */
+#define DICT_SEG        32              /* Dictionary segment length */
+#define DICT_HBITS      16              /* Hash table size (bits)    */
+
+static inline U32 dict_hash( const BYTE* p )
+{
+    U64 v = ((U64)fetch_fw( p ) << 16) | fetch_hw( p + 4 );
+    return (U32)((v * 0x9E3779B97F4A7C15ULL) >> (64 - DICT_HBITS));
+}
+
+DLL_EXPORT int cckd_dict_train( BYTE* dict, int dictsize, const BYTE* samples,
+                                const int* lens, int nsamples )
+{
+U32            *cnt;                    /* Sample count per hash     */
+U32            *seen;                   /* Last sample per hash      */
+U16            *hash;                   /* Hash at each position     */
+int             total;                  /* Total sample bytes        */
+int             used = 0;               /* Dictionary bytes used     */
+int             s, i, j, off;           /* Indexes                   */
+U64             score, best;            /* Segment scores            */
+int             bestoff;                /* Best segment offset       */
+int             minscore;               /* Minimum useful score      */
+
+    for (total = 0, s = 0; s < nsamples; s++)
+        total += lens[s];
+
+    if (dictsize < DICT_SEG || nsamples < 2 || total < DICT_SEG)
+        return 0;
+
+    cnt  = calloc( 1 << DICT_HBITS, sizeof( U32 ));
+    seen = calloc( 1 << DICT_HBITS, sizeof( U32 ));
+    hash = calloc( total,           sizeof( U16 ));
+    if (!cnt || !seen || !hash)
+    {
+        free( cnt );
+        free( seen );
+        free( hash );
+        return 0;
+    }
+
+    /* Count the samples each string occurs in */
+    for (off = 0, s = 0; s < nsamples; off += lens[s++])
+    {
+        for (i = 0; i + DICT_KMER <= lens[s]; i++)
+        {
+            U32 h = dict_hash( samples + off + i );
+            hash[off + i] = (U16) h;
+            if (seen[h] != (U32)(s + 1))
+            {
+                seen[h] = s + 1;
+                cnt[h]++;
+            }
+        }
+    }
+
+    /* A segment is only worth adding if its strings are, on
+       average, shared by at least two samples                   */
+    minscore = 2 * (DICT_SEG - DICT_KMER + 1);
+
+    while (used + DICT_SEG <= dictsize)
+    {
+        best = 0;
+        bestoff = -1;
+
+        /* Find the segment with the highest score (sliding sum) */
+        for (off = 0, s = 0; s < nsamples; off += lens[s++])
+        {
+            if (lens[s] < DICT_SEG)
+                continue;
+            score = 0;
+            for (i = 0; i < DICT_SEG - DICT_KMER + 1; i++)
+                score += cnt[hash[off + i]];
+            for (i = 0; ; i++)
+            {
+                if (score > best)
+                {
+                    best = score;
+                    bestoff = off + i;
+                }
+                if (i + DICT_SEG >= lens[s])
+                    break;
+                score -= cnt[hash[off + i]];
+                score += cnt[hash[off + i + DICT_SEG - DICT_KMER + 1]];
+            }
+        }
+
+        if (bestoff < 0 || best < (U64)minscore)
+            break;
+
+        /* Add the segment and retire its strings */
+        used += DICT_SEG;
+        memcpy( dict + dictsize - used, samples + bestoff, DICT_SEG );
+        for (j = 0; j < DICT_SEG - DICT_KMER + 1; j++)
+            cnt[hash[bestoff + j]] = 0;
+    }
+
+    /* Move the dictionary to the start of the buffer */
+    if (used && used < dictsize)
+        memmove( dict, dict + dictsize - used, used );
+
+    free( cnt );
+    free( seen );
+    free( hash );
+
+    return used;
+}
+
 /*-------------------------------------------------------------------*/
 /* Toggle the endianess of a compressed file                         */
 /*-------------------------------------------------------------------*/
@@ -351,6 +528,8 @@ DLL_EXPORT void cckd_swapend_chdr( CCKD_DEVHDR* cdevhdr )
     cdevhdr->free_num     = SWAP32( cdevhdr->free_num     );
     cdevhdr->free_imbed   = SWAP32( cdevhdr->free_imbed   );
     cdevhdr->cmp_parm     = SWAP16( cdevhdr->cmp_parm     );
+    cdevhdr->cdh_dictlen  = SWAP16( cdevhdr->cdh_dictlen  );
+    cdevhdr->cdh_dictid   = SWAP32( cdevhdr->cdh_dictid   );
 }
 
 /*-------------------------------------------------------------------*/
@@ -814,7 +993,8 @@ comp_restart:
     cdevhdr.free_imbed = 0;
     cdevhdr.cdh_vrm[0] = CCKD_VERSION;
     cdevhdr.cdh_vrm[1] = CCKD_RELEASE;
-    cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
+    if (cdevhdr.cdh_vrm[2] < CCKD_MODLVL)
+        cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
 
     /*---------------------------------------------------------------
      * Update the lookup tables
@@ -1056,6 +1236,8 @@ BYTE           *l2errs=NULL;            /* l2 error table            */
 BYTE           *rcvtab=NULL;            /* recovered tracks          */
 CKD_DEVHDR      devhdr;                 /* device header             */
 CCKD_DEVHDR     cdevhdr;                /* compressed device header  */
+BYTE           *dict;                   /* preset dictionary         */
+int             dictlen;                /* preset dictionary length  */
 CCKD_DEVHDR     cdevhdr2;               /* compressed device header 2*/
 CCKD_L1ENT     *l1=NULL;                /* -> level 1 table          */
 CCKD_L2ENT      l2ent;                  /* level 2 entry             */
@@ -1095,6 +1277,16 @@ BYTE            buf[4*65536];           /* buffer                    */
 #else
     compmask[CCKD_COMPRESS_BZIP2] = 2;
 #endif
+#if defined( CCKD_ZSTD )
+    compmask[CCKD_COMPRESS_ZSTD] = 0;
+#else
+    compmask[CCKD_COMPRESS_ZSTD] = 4;
+#endif
+#if defined( CCKD_LZ4 )
+    compmask[CCKD_COMPRESS_LZ4] = 0;
+#else
+    compmask[CCKD_COMPRESS_LZ4] = 8;
+#endif
 
     /*---------------------------------------------------------------
      * Header checks
@@ -1146,6 +1338,19 @@ BYTE            buf[4*65536];           /* buffer                    */
     if ((rc = read (fd, &cdevhdr, len)) != len)
         goto cdsk_read_error;
 
+    /* Refuse images with track images this release cannot read */
+    if (!CCKD_VRM_SUPPORTED( cdevhdr.cdh_vrm ))
+    {
+        // "%1d:%04X CCKD file %s: header level %u.%u.%u is not supported"
+        if (dev->batch)
+            FWRMSG( stdout, HHC00386, "E", LCSS_DEVNUM, dev->filename,
+                    cdevhdr.cdh_vrm[0], cdevhdr.cdh_vrm[1], cdevhdr.cdh_vrm[2] );
+        else
+            WRMSG( HHC00386, "E", LCSS_DEVNUM, dev->filename,
+                   cdevhdr.cdh_vrm[0], cdevhdr.cdh_vrm[1], cdevhdr.cdh_vrm[2] );
+        goto cdsk_error;
+    }
+
     /* Endianess check */
     if ((cdevhdr.cdh_opts & CCKD_OPT_BIGEND) != cckd_def_opt_bigend())
     {
@@ -1176,6 +1381,10 @@ BYTE            buf[4*65536];           /* buffer                    */
         cckd_swapend_chdr (&cdevhdr);
     }
 
+    /* Preset compression dictionary, if any */
+    dictlen = cdevhdr.cdh_dictlen <= CCKD_DICT_SIZE ? cdevhdr.cdh_dictlen : 0;
+    dict    = dictlen ? cdevhdr.cdh_dict : NULL;
+
     /* ckd checks */
     if (ckddasd)
     {
@@ -1844,7 +2053,7 @@ cdsk_space_check:
             /* Validate the space if check level 3 */
             if (level > 2)
             {
-                if (!cdsk_valid_trk (trk, buf, heads, len))
+                if (!cdsk_valid_trk (trk, buf, heads, len, dict, dictlen))
                 {
                     if(dev->batch)
                         // "%1d:%04X CCKD file %s: %s[%d] offset 0x%16.16"PRIX64" len %"PRId64" validation error"
@@ -1962,6 +2171,11 @@ cdsk_recovery:
                     else if (comp == CCKD_COMPRESS_BZIP2
                      && (buf[i+5] != 'B' || buf[i+6] != 'Z'))
                         continue;
+
+                    /* Quick validation for zstd */
+                    else if (comp == CCKD_COMPRESS_ZSTD
+                     && fetch_fw (buf + i + 5) != 0x28B52FFD)
+                        continue;
                     /*
                      * If we are in `borrowed space' then start over
                      * with the current position at the beginning
@@ -1973,7 +2187,7 @@ cdsk_recovery:
                     if (comp == CCKD_COMPRESS_NONE)
                     {
                         l = len - i;
-                        if ((l = cdsk_valid_trk (trk, buf+i, heads, -l)))
+                        if ((l = cdsk_valid_trk (trk, buf+i, heads, -l, dict, dictlen)))
                             goto cdsk_ckd_recover;
                         else
                              continue;
@@ -1982,9 +2196,9 @@ cdsk_recovery:
                     /* Check short `length' */
                     if (flen == (U32)len && (l = len - i) <= 1024)
                     {
-                        if (cdsk_valid_trk (trk, buf+i, heads, l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (trk, buf+i, heads, --l));
+                            while (cdsk_valid_trk (trk, buf+i, heads, --l, dict, dictlen));
                             l++;
                             goto cdsk_ckd_recover;
                         }
@@ -2017,13 +2231,17 @@ cdsk_recovery:
                         else if (buf[j] == CCKD_COMPRESS_BZIP2
                          && (buf[j+5] != 'B' || buf[j+6] != 'Z'))
                                 continue;
+                        /* check zstd compressed header */
+                        else if (buf[j] == CCKD_COMPRESS_ZSTD
+                         && fetch_fw (buf + j + 5) != 0x28B52FFD)
+                                continue;
 
                         /* check to possible trkhdr */
                         l = j - i;
-                        if (cdsk_valid_trk (trk, buf+i, heads, l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, l, dict, dictlen))
                         {
 #if 0
-                            while (cdsk_valid_trk (trk, buf+i, heads, --l));
+                            while (cdsk_valid_trk (trk, buf+i, heads, --l, dict, dictlen));
                             l++;
 #endif
                             goto cdsk_ckd_recover;
@@ -2034,9 +2252,9 @@ cdsk_recovery:
                     /* Check `length' */
                     if (flen == (U32)len && (l = len - i) <= (int)trksz)
                     {
-                        if (cdsk_valid_trk (trk, buf+i, heads, l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (trk, buf+i, heads, --l));
+                            while (cdsk_valid_trk (trk, buf+i, heads, --l, dict, dictlen));
                             l++;
                             goto cdsk_ckd_recover;
                         }
@@ -2047,7 +2265,7 @@ cdsk_recovery:
                     {
                         if (l > (int)trksz)
                             break;
-                        if (cdsk_valid_trk (trk, buf+i, heads, l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, l, dict, dictlen))
                             goto cdsk_ckd_recover;
                     } /* for all lengths */
 
@@ -2186,6 +2404,11 @@ cdsk_ckd_recover:
                     else if (comp == CCKD_COMPRESS_BZIP2
                      && (buf[i+5] != 'B' || buf[i+6] != 'Z'))
                         continue;
+
+                    /* Quick validation for zstd */
+                    else if (comp == CCKD_COMPRESS_ZSTD
+                     && fetch_fw (buf + i + 5) != 0x28B52FFD)
+                        continue;
                     /*
                      * If we are in `borrowed space' then start over
                      * with the current position at the beginning
@@ -2218,9 +2441,9 @@ cdsk_ckd_recover:
                     /* Check short `length' */
                     if (flen == (U32)len && (l = len - i) <= 1024)
                     {
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (blkgrp, buf+i, heads, --l));
+                            while (cdsk_valid_trk (blkgrp, buf+i, heads, --l, dict, dictlen));
                             l++;
                             goto cdsk_fba_recover;
                         }
@@ -2246,13 +2469,17 @@ cdsk_ckd_recover:
                         else if (buf[j] == CCKD_COMPRESS_BZIP2
                          && (buf[j+5] != 'B' || buf[j+6] != 'Z'))
                                 continue;
+                        /* check zstd compressed header */
+                        else if (buf[j] == CCKD_COMPRESS_ZSTD
+                         && fetch_fw (buf + j + 5) != 0x28B52FFD)
+                                continue;
 
                         /* check to possible trkhdr */
                         l = j - i;
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l, dict, dictlen))
                         {
 #if 0
-                            while (cdsk_valid_trk (blkgrp, buf+i, heads, --l));
+                            while (cdsk_valid_trk (blkgrp, buf+i, heads, --l, dict, dictlen));
                             l++;
 #endif
                             goto cdsk_fba_recover;
@@ -2264,9 +2491,9 @@ cdsk_ckd_recover:
                     l = len - i;
                     if (flen == (U32)len && l <= (int)blkgrpsz)
                     {
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (blkgrp, buf+i, heads, --l));
+                            while (cdsk_valid_trk (blkgrp, buf+i, heads, --l, dict, dictlen));
                             l++;
                             goto cdsk_fba_recover;
                         }
@@ -2277,7 +2504,7 @@ cdsk_ckd_recover:
                     {
                         if (l > (int)blkgrpsz)
                             break;
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, l, dict, dictlen))
                             goto cdsk_fba_recover;
                     } /* for all lengths */
 
@@ -2607,7 +2834,8 @@ cdsk_fsperr_retry:
 
         cdevhdr.cdh_vrm[0] = CCKD_VERSION;
         cdevhdr.cdh_vrm[1] = CCKD_RELEASE;
-        cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
+        if (cdevhdr.cdh_vrm[2] < CCKD_MODLVL)
+            cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
 
         cdevhdr.cdh_size        = cdevhdr.cdh_used         = cdevhdr.free_off =
         cdevhdr.free_total  = cdevhdr.free_largest =
@@ -2748,7 +2976,8 @@ cdsk_return_ok:
         /* Set version.release.modlvl */
         cdevhdr.cdh_vrm[0] = CCKD_VERSION;
         cdevhdr.cdh_vrm[1] = CCKD_RELEASE;
-        cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
+        if (cdevhdr.cdh_vrm[2] < CCKD_MODLVL)
+            cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
 
         off = CCKD_DEVHDR_POS;
         if (lseek (fd, CCKD_DEVHDR_POS, SEEK_SET) >= 0)
@@ -2895,7 +3124,8 @@ int i;
 /* 'len' indicates a buffer size containing the track image and the  */
 /* value returned is the actual track length. Returns 0 on error.    */
 /*-------------------------------------------------------------------*/
-int cdsk_valid_trk( int trk, BYTE* buf, int heads, int len )
+int cdsk_valid_trk( int trk, BYTE* buf, int heads, int len,
+                    const BYTE* dict, int dictlen )
 {
 CKD_TRKHDR      ha;                     /* Home Address              */
 CKD_RECHDR      rn;                     /* Record-n (r0, r1 ... rn)  */
@@ -2910,11 +3140,19 @@ uLongf          zlen;
 #if defined( CCKD_BZIP2 )
 unsigned int    bz2len;
 #endif
-#if defined( HAVE_ZLIB ) || defined( CCKD_BZIP2 )
+#if defined( CCKD_ZSTD )
+size_t          zstdlen;
+#endif
+#if defined( HAVE_ZLIB ) || defined( CCKD_BZIP2 ) || defined( CCKD_ZSTD ) || defined( CCKD_LZ4 )
 int             rc;                     /* Return code               */
 BYTE            buf2[64*1024];          /* Uncompressed buffer       */
 #endif
 
+#if !defined( HAVE_ZLIB )
+    UNREFERENCED( dict );
+    UNREFERENCED( dictlen );
+#endif
+
     /* Negative len only allowed for comp none */
     len2 = len > 0 ? len : -len;
 
@@ -2939,9 +3177,19 @@ BYTE            buf2[64*1024];          /* Uncompressed buffer       */
         bufp = (BYTE*) buf2;
         memcpy( buf2, &ha,      CKD_TRKHDR_SIZE );
         zlen = sizeof( buf2 ) - CKD_TRKHDR_SIZE;
-        rc = uncompress( buf2 + CKD_TRKHDR_SIZE, &zlen,
-                         buf  + CKD_TRKHDR_SIZE,
-                         len  - CKD_TRKHDR_SIZE ); if (rc != Z_OK) return 0;
+        if (dict)
+        {
+            rc = cckd_inflate_dict( buf2 + CKD_TRKHDR_SIZE, (int) zlen,
+                                    buf  + CKD_TRKHDR_SIZE,
+                                    len  - CKD_TRKHDR_SIZE, dict, dictlen ); if (rc < 0) return 0;
+            zlen = rc;
+        }
+        else
+        {
+            rc = uncompress( buf2 + CKD_TRKHDR_SIZE, &zlen,
+                             buf  + CKD_TRKHDR_SIZE,
+                             len  - CKD_TRKHDR_SIZE ); if (rc != Z_OK) return 0;
+        }
         bufl =     (int) zlen + CKD_TRKHDR_SIZE;
         break;
 #endif
@@ -2959,6 +3207,31 @@ BYTE            buf2[64*1024];          /* Uncompressed buffer       */
         break;
 #endif
 
+#if defined( CCKD_ZSTD )
+    case CCKD_COMPRESS_ZSTD:
+        if (len < 0) return 0;
+        bufp = (BYTE*) buf2;
+        memcpy( buf2, &ha, CKD_TRKHDR_SIZE );
+        zstdlen = ZSTD_decompress( buf2 + CKD_TRKHDR_SIZE, sizeof( buf2 ) - CKD_TRKHDR_SIZE,
+                                   buf  + CKD_TRKHDR_SIZE, len - CKD_TRKHDR_SIZE );
+        if (ZSTD_isError( zstdlen )) return 0;
+        bufl = (int) zstdlen + CKD_TRKHDR_SIZE;
+        break;
+#endif
+
+#if defined( CCKD_LZ4 )
+    case CCKD_COMPRESS_LZ4:
+        if (len < 0) return 0;
+        bufp = (BYTE*) buf2;
+        memcpy( buf2, &ha, CKD_TRKHDR_SIZE );
+        rc = LZ4_decompress_safe( (const char*) &buf [ CKD_TRKHDR_SIZE ],
+                                  (char*)       &buf2[ CKD_TRKHDR_SIZE ],
+                                  len - CKD_TRKHDR_SIZE,
+                                  (int) sizeof( buf2 ) - CKD_TRKHDR_SIZE ); if (rc < 0) return 0;
+        bufl = rc + CKD_TRKHDR_SIZE;
+        break;
+#endif
+
     default:
         return 0; // (error: unsupported compression algorithm!)
 
@@ -281,6 +281,8 @@ DLL_EXPORT void cckd64_swapend_chdr( CCKD64_DEVHDR* cdevhdr )
     cdevhdr->free_num     = SWAP64( cdevhdr->free_num     );
     cdevhdr->free_imbed   = SWAP64( cdevhdr->free_imbed   );
     cdevhdr->cmp_parm     = SWAP16( cdevhdr->cmp_parm     );
+    cdevhdr->cdh_dictlen  = SWAP16( cdevhdr->cdh_dictlen  );
+    cdevhdr->cdh_dictid   = SWAP32( cdevhdr->cdh_dictid   );
 }
 
 /*-------------------------------------------------------------------*/
@@ -744,7 +746,8 @@ comp_restart:
     cdevhdr.free_imbed = 0;
     cdevhdr.cdh_vrm[0] = CCKD_VERSION;
     cdevhdr.cdh_vrm[1] = CCKD_RELEASE;
-    cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
+    if (cdevhdr.cdh_vrm[2] < CCKD_MODLVL)
+        cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
 
     /*---------------------------------------------------------------
      * Update the lookup tables
@@ -986,6 +989,8 @@ BYTE           *l2errs=NULL;            /* l2 error table            */
 BYTE           *rcvtab=NULL;            /* recovered tracks          */
 CKD_DEVHDR      devhdr;                 /* device header             */
 CCKD64_DEVHDR   cdevhdr;                /* compressed device header  */
+BYTE           *dict;                   /* preset dictionary         */
+int             dictlen;                /* preset dictionary length  */
 CCKD64_DEVHDR   cdevhdr2;               /* compressed device header 2*/
 CCKD64_L1ENT   *l1=NULL;                /* -> level 1 table          */
 CCKD64_L2ENT    l2ent;                  /* level 2 entry             */
@@ -1025,6 +1030,16 @@ BYTE            buf[4*65536];           /* buffer                    */
 #else
     compmask[CCKD_COMPRESS_BZIP2] = 2;
 #endif
+#if defined( CCKD_ZSTD )
+    compmask[CCKD_COMPRESS_ZSTD] = 0;
+#else
+    compmask[CCKD_COMPRESS_ZSTD] = 4;
+#endif
+#if defined( CCKD_LZ4 )
+    compmask[CCKD_COMPRESS_LZ4] = 0;
+#else
+    compmask[CCKD_COMPRESS_LZ4] = 8;
+#endif
 
     /*---------------------------------------------------------------
      * Header checks
@@ -1076,6 +1091,19 @@ BYTE            buf[4*65536];           /* buffer                    */
     if ((U64)(rc = read (fd, &cdevhdr, (unsigned int) len)) != len)
         goto cdsk_read_error;
 
+    /* Refuse images with track images this release cannot read */
+    if (!CCKD_VRM_SUPPORTED( cdevhdr.cdh_vrm ))
+    {
+        // "%1d:%04X CCKD file %s: header level %u.%u.%u is not supported"
+        if (dev->batch)
+            FWRMSG( stdout, HHC00386, "E", LCSS_DEVNUM, dev->filename,
+                    cdevhdr.cdh_vrm[0], cdevhdr.cdh_vrm[1], cdevhdr.cdh_vrm[2] );
+        else
+            WRMSG( HHC00386, "E", LCSS_DEVNUM, dev->filename,
+                   cdevhdr.cdh_vrm[0], cdevhdr.cdh_vrm[1], cdevhdr.cdh_vrm[2] );
+        goto cdsk_error;
+    }
+
     /* Endianess check */
     if ((cdevhdr.cdh_opts & CCKD_OPT_BIGEND) != cckd_def_opt_bigend())
     {
@@ -1106,6 +1134,10 @@ BYTE            buf[4*65536];           /* buffer                    */
         cckd64_swapend_chdr (&cdevhdr);
     }
 
+    /* Preset compression dictionary, if any */
+    dictlen = cdevhdr.cdh_dictlen <= CCKD_DICT_SIZE ? cdevhdr.cdh_dictlen : 0;
+    dict    = dictlen ? cdevhdr.cdh_dict : NULL;
+
     /* ckd checks */
     if (ckddasd)
     {
@@ -1774,7 +1806,7 @@ cdsk_space_check:
             /* Validate the space if check level 3 */
             if (level > 2)
             {
-                if (!cdsk_valid_trk (trk, buf, heads, (int) len))
+                if (!cdsk_valid_trk (trk, buf, heads, (int) len, dict, dictlen))
                 {
                     if(dev->batch)
                         // "%1d:%04X CCKD file %s: %s[%d] offset 0x%16.16"PRIX64" len %"PRId64" validation error"
@@ -1904,6 +1936,11 @@ cdsk_recovery:
                     else if (comp == CCKD_COMPRESS_BZIP2
                      && (buf[i+5] != 'B' || buf[i+6] != 'Z'))
                         continue;
+
+                    /* Quick validation for zstd */
+                    else if (comp == CCKD_COMPRESS_ZSTD
+                     && fetch_fw (buf + i + 5) != 0x28B52FFD)
+                        continue;
                     /*
                      * If we are in `borrowed space' then start over
                      * with the current position at the beginning
@@ -1915,7 +1952,7 @@ cdsk_recovery:
                     if (comp == CCKD_COMPRESS_NONE)
                     {
                         l = len - i;
-                        if ((l = cdsk_valid_trk (trk, buf+i, heads, (int) -l)))
+                        if ((l = cdsk_valid_trk (trk, buf+i, heads, (int) -l, dict, dictlen)))
                             goto cdsk_ckd_recover;
                         else
                              continue;
@@ -1924,9 +1961,9 @@ cdsk_recovery:
                     /* Check short `length' */
                     if (flen == len && (l = len - i) <= 1024)
                     {
-                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (trk, buf+i, heads, (int) --l));
+                            while (cdsk_valid_trk (trk, buf+i, heads, (int) --l, dict, dictlen));
                             l++;
                             goto cdsk_ckd_recover;
                         }
@@ -1973,13 +2010,17 @@ cdsk_recovery:
                         else if (buf[j] == CCKD_COMPRESS_BZIP2
                          && (buf[j+5] != 'B' || buf[j+6] != 'Z'))
                                 continue;
+                        /* check zstd compressed header */
+                        else if (buf[j] == CCKD_COMPRESS_ZSTD
+                         && fetch_fw (buf + j + 5) != 0x28B52FFD)
+                                continue;
 
                         /* check to possible trkhdr */
                         l = j - i;
-                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l, dict, dictlen))
                         {
 #if 0
-                            while (cdsk_valid_trk (trk, buf+i, heads, (int) --l));
+                            while (cdsk_valid_trk (trk, buf+i, heads, (int) --l, dict, dictlen));
                             l++;
 #endif
                             goto cdsk_ckd_recover;
@@ -1990,9 +2031,9 @@ cdsk_recovery:
                     /* Check `length' */
                     if (flen == len && (l = (S64)len - i) <= (S64)trksz)
                     {
-                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (trk, buf+i, heads, (int) --l));
+                            while (cdsk_valid_trk (trk, buf+i, heads, (int) --l, dict, dictlen));
                             l++;
                             goto cdsk_ckd_recover;
                         }
@@ -2003,7 +2044,7 @@ cdsk_recovery:
                     {
                         if (l > (S64)trksz)
                             break;
-                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (trk, buf+i, heads, (int) l, dict, dictlen))
                             goto cdsk_ckd_recover;
                     } /* for all lengths */
 
@@ -2142,6 +2183,11 @@ cdsk_ckd_recover:
                     else if (comp == CCKD_COMPRESS_BZIP2
                      && (buf[i+5] != 'B' || buf[i+6] != 'Z'))
                         continue;
+
+                    /* Quick validation for zstd */
+                    else if (comp == CCKD_COMPRESS_ZSTD
+                     && fetch_fw (buf + i + 5) != 0x28B52FFD)
+                        continue;
                     /*
                      * If we are in `borrowed space' then start over
                      * with the current position at the beginning
@@ -2174,9 +2220,9 @@ cdsk_ckd_recover:
                     /* Check short `length' */
                     if (flen == len && (l = len - i) <= 1024)
                     {
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (blkgrp, buf+i, heads, (int) --l));
+                            while (cdsk_valid_trk (blkgrp, buf+i, heads, (int) --l, dict, dictlen));
                             l++;
                             goto cdsk_fba_recover;
                         }
@@ -2202,13 +2248,17 @@ cdsk_ckd_recover:
                         else if (buf[j] == CCKD_COMPRESS_BZIP2
                          && (buf[j+5] != 'B' || buf[j+6] != 'Z'))
                                 continue;
+                        /* check zstd compressed header */
+                        else if (buf[j] == CCKD_COMPRESS_ZSTD
+                         && fetch_fw (buf + j + 5) != 0x28B52FFD)
+                                continue;
 
                         /* check to possible trkhdr */
                         l = j - i;
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l, dict, dictlen))
                         {
 #if 0
-                            while (cdsk_valid_trk (blkgrp, buf+i, heads, (int) --l));
+                            while (cdsk_valid_trk (blkgrp, buf+i, heads, (int) --l, dict, dictlen));
                             l++;
 #endif
                             goto cdsk_fba_recover;
@@ -2220,9 +2270,9 @@ cdsk_ckd_recover:
                     l = len - i;
                     if (flen == len && l <= (S64)blkgrpsz)
                     {
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l, dict, dictlen))
                         {
-                            while (cdsk_valid_trk (blkgrp, buf+i, heads, (int) --l));
+                            while (cdsk_valid_trk (blkgrp, buf+i, heads, (int) --l, dict, dictlen));
                             l++;
                             goto cdsk_fba_recover;
                         }
@@ -2233,7 +2283,7 @@ cdsk_ckd_recover:
                     {
                         if (l > (S64)blkgrpsz)
                             break;
-                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l))
+                        if (cdsk_valid_trk (blkgrp, buf+i, heads, (int) l, dict, dictlen))
                             goto cdsk_fba_recover;
                     } /* for all lengths */
 
@@ -2564,7 +2614,8 @@ cdsk_fsperr_retry:
 
         cdevhdr.cdh_vrm[0] = CCKD_VERSION;
         cdevhdr.cdh_vrm[1] = CCKD_RELEASE;
-        cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
+        if (cdevhdr.cdh_vrm[2] < CCKD_MODLVL)
+            cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
 
         cdevhdr.cdh_size        = cdevhdr.cdh_used         = cdevhdr.free_off =
         cdevhdr.free_total  = cdevhdr.free_largest =
@@ -2705,7 +2756,8 @@ cdsk_return_ok:
         /* Set version.release.modlvl */
         cdevhdr.cdh_vrm[0] = CCKD_VERSION;
         cdevhdr.cdh_vrm[1] = CCKD_RELEASE;
-        cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
+        if (cdevhdr.cdh_vrm[2] < CCKD_MODLVL)
+            cdevhdr.cdh_vrm[2] = CCKD_MODLVL;
 
         off = CCKD64_DEVHDR_POS;
         if (lseek (fd, CCKD64_DEVHDR_POS, SEEK_SET) >= 0)
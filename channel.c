@@ -72,6 +72,22 @@ DISABLE_GCC_UNUSED_SET_WARNING;
                                                     || ( tracethis ))
 #endif
 
+/*-------------------------------------------------------------------*/
+/* Obtain the I/O interrupt queue lock, counting contention          */
+/*-------------------------------------------------------------------*/
+
+#ifndef OBTAIN_IOINTQLK
+#define OBTAIN_IOINTQLK()                                           \
+    do {                                                            \
+        if (try_obtain_lock( &sysblk.iointqlk ) != 0)               \
+        {                                                           \
+            obtain_lock( &sysblk.iointqlk );                        \
+            sysblk.iointqwaits++;                                   \
+        }                                                           \
+        sysblk.iointqlocks++;                                       \
+    } while (0)
+#endif
+
 #ifndef SKIP_CH9UC
 #define SKIP_CH9UC( dev, chanstat, unitstat )                       \
                                                                     \
@@ -513,7 +529,7 @@ static INLINE void
 queue_io_interrupt_and_update_status_locked(DEVBLK* dev, int clrbsy)
 {
     /* Get the I/O interrupt queue lock */
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
 
     /* Ensure the interrupt is queued/dequeued per pending flag */
     if (dev->scsw.flag3 & SCSW3_SC_PEND)
@@ -1137,7 +1153,7 @@ testio (REGS *regs, DEVBLK *dev, BYTE ibyte)
             cc = 1;     /* CSW stored */
 
             /* Obtain I/O interrupt queue lock */
-            obtain_lock(&sysblk.iointqlk);
+            OBTAIN_IOINTQLK();
 
             /* Dequeue the interrupt */
             DEQUEUE_IO_INTERRUPT_QLOCKED(ioint);
@@ -1626,7 +1642,7 @@ test_subchan (REGS *regs, DEVBLK *dev, IRB *irb)
 #endif
 
     /* Obtain the I/O interrupt queue lock */
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
 
     /* Perform core of TEST SUBCHANNEL work */
     cc = test_subchan_locked (regs, dev, irb, &ioint, &scsw);
@@ -1667,7 +1683,7 @@ void
 perform_clear_subchan (DEVBLK *dev)
 {
     /* Dequeue pending interrupts */
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
     DEQUEUE_IO_INTERRUPT_QLOCKED(&dev->ioint);
     dev->scsw.flag3 &= ~SCSW3_SC_PEND;
     dev->pending = 0;
@@ -2142,7 +2158,7 @@ device_reset (DEVBLK *dev)
         }
     }
 
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
     DEQUEUE_IO_INTERRUPT_QLOCKED(&dev->ioint);
     DEQUEUE_IO_INTERRUPT_QLOCKED(&dev->pciioint);
     DEQUEUE_IO_INTERRUPT_QLOCKED(&dev->attnioint);
@@ -2393,6 +2409,88 @@ TID     tid;                            /* Thread ID                 */
 }
 
 
+/*-------------------------------------------------------------------*/
+/* Dequeue the next I/O request for a device thread                  */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/* Normally the request at the head of the I/O queue is taken. But   */
+/* if a request for a device the thread serviced previously is       */
+/* queued within the same priority partition (and of the same kind,  */
+/* resume or start) as the head of the queue, that one is taken      */
+/* instead, so the device's control blocks and buffers are likely    */
+/* still in the host cache. Only the first DEVT_AFFINITY_SCAN        */
+/* entries are examined, and the head of the queue is passed over    */
+/* at most DEVT_AFFINITY_SKIPS times in succession so that it cannot */
+/* be starved by devices that keep matching their previous threads.  */
+/*                                                                   */
+/* Locks:                                                            */
+/*                                                                   */
+/* sysblk->ioqlock must be held.                                     */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+#ifndef DEVT_AFFINITY_SCAN
+#define DEVT_AFFINITY_SCAN      8
+#endif
+#ifndef DEVT_AFFINITY_SKIPS
+#define DEVT_AFFINITY_SKIPS     4
+#endif
+
+static DEVBLK*
+dequeue_device_ioq (TID tid)
+{
+DEVBLK  *dev = sysblk.ioq;              /* -> Device to be serviced  */
+DEVBLK **pdev = &sysblk.ioq;            /* -> Pointer to dev in ioq  */
+DEVBLK **p;                             /* Queue scan pointer        */
+int      n;                             /* Entries scanned           */
+U64      waitus;                        /* Time request was queued   */
+
+    if (equal_threads( dev->lasttid, tid ))
+        sysblk.devtaffine++;
+    else if (sysblk.devtskips < DEVT_AFFINITY_SKIPS)
+    {
+        for (p = &dev->nextioq, n = 1;
+             *p && n < DEVT_AFFINITY_SCAN;
+             p = &(*p)->nextioq, n++)
+        {
+            /* Stay within the head of queue's partition */
+            if (0
+                || (*p)->priority != dev->priority
+                || ((*p)->scsw.flag2 & SCSW2_AC_RESUM)
+                    != (dev->scsw.flag2 & SCSW2_AC_RESUM)
+            )
+                break;
+
+            if (equal_threads( (*p)->lasttid, tid ))
+            {
+                pdev = p;
+                dev  = *p;
+                sysblk.devtaffine++;
+                break;
+            }
+        }
+    }
+
+    /* Count the times in succession the head has been passed over */
+    if (pdev == &sysblk.ioq)
+        sysblk.devtskips = 0;
+    else
+        sysblk.devtskips++;
+
+    /* Remove the request from the I/O queue */
+    *pdev = dev->nextioq;
+    dev->nextioq = 0;
+
+    /* Update queue wait statistics */
+    waitus = (U64) ETOD_high64_to_usecs( (S64)(host_tod() - dev->ioqtod) );
+    sysblk.devtdisp++;
+    sysblk.devtwaitus += waitus;
+    if (waitus > sysblk.devtwaitmax)
+        sysblk.devtwaitmax = waitus;
+
+    return dev;
+}
+
+
 /*-------------------------------------------------------------------*/
 /* Execute a queued I/O                                              */
 /*-------------------------------------------------------------------*/
@@ -2400,6 +2498,7 @@ DLL_EXPORT void *
 device_thread (void *arg)
 {
 DEVBLK *dev;
+TID     tid = thread_id();              /* Our thread id             */
 int     current_priority;               /* Current thread priority   */
 int     rc = 0;                         /* Return code               */
 u_int   waitcount = 0;                  /* Wait counter              */
@@ -2420,15 +2519,14 @@ u_int   waitcount = 0;                  /* Wait counter              */
 
     while (1)
     {
-        while ((dev=sysblk.ioq)  &&
+        while (sysblk.ioq  &&
                !sysblk.shutdown)
         {
             /* Reset local wait count */
             waitcount = 0;
 
-            /* Set next IOQ entry and zero pointer in current DEVBLK */
-            sysblk.ioq = dev->nextioq;
-            dev->nextioq = 0;
+            /* Take the next request off the I/O queue */
+            dev = dequeue_device_ioq( tid );
 
             /* Decrement waiting IOQ count */
             sysblk.devtunavail = MAX(0, sysblk.devtunavail - 1);
@@ -2437,7 +2535,7 @@ u_int   waitcount = 0;                  /* Wait counter              */
             create_device_thread();
 
             /* Set thread id */
-            dev->tid = thread_id();
+            dev->tid = dev->lasttid = tid;
 
             /* Set thread name */
             {
@@ -2548,6 +2646,9 @@ ScheduleIORequest ( DEVBLK *dev )
     /* Determine if the device is resuming */
     device_resume = (dev->scsw.flag2 & SCSW2_AC_RESUM);
 
+    /* Note when the request was queued */
+    dev->ioqtod = host_tod();
+
     /* Lock the I/O request queue */
     obtain_lock( &sysblk.ioqlock );
 
@@ -2611,6 +2712,8 @@ ScheduleIORequest ( DEVBLK *dev )
              * decremented once a thread grabs this request.
              */
             sysblk.devtunavail = count;
+            if (count > sysblk.devtqhwm)
+                sysblk.devtqhwm = count;
 
             /* Create another device thread, if needed, to service this
              * I/O
@@ -2833,7 +2936,7 @@ ARCH_DEP(raise_pci) (DEVBLK *dev,       /* -> Device block           */
     store_hw (dev->pciscsw.count, 0);
 
     /* Queue the PCI pending interrupt */
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
     QUEUE_IO_INTERRUPT_QLOCKED(&dev->pciioint,FALSE);
 
     /* Update interrupt status */
@@ -3351,16 +3454,16 @@ do {                                                                   \
                     {
                         iobufptr = iobuf + dev->curblkrem + midawrem -
                                    midawlen;
-                        if (!midawlen                        ||
-                            (iobufptr + midawlen) > iobufend ||
+                        if (!midawlen                              ||
+                            (iobufptr + midawlen) > (iobufend + 1) ||
                             iobufptr < iobufstart)
                         {
                             *chanstat = CSW_CDC;
                             return;
                         }
                     }
-                    else if (!midawlen                     ||
-                             (iobuf + midawlen) > iobufend ||
+                    else if (!midawlen                           ||
+                             (iobuf + midawlen) > (iobufend + 1) ||
                              iobuf < iobufstart)
                     {
                             set_chanstat(CSW_CDC);
@@ -3909,7 +4012,7 @@ ARCH_DEP( device_attention )( DEVBLK* dev, BYTE unitstat )
 
     /* We already have INTLOCK and dev->lock held, so now
        we only need to acquire the interrupt queue lock. */
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
 
     /* Set SCSW for attention interrupt                              */
     /* SA22-7201-05:                                                 */
@@ -5112,6 +5215,11 @@ prefetch:
             residual = count;
             more = bufpos = unitstat = chanstat = 0;
 
+            /* A data-chained read may continue from the data which
+               the handler left in its own buffer for the previous CCW */
+            if (!(dev->chained & CCW_FLAGS_CD))
+                dev->iodirect = NULL;
+
             /* Pass the CCW to the device handler for execution */
             dev->iobuf.length = iobuf->size;
             dev->iobuf.data = iobuf->data;
@@ -5226,12 +5334,20 @@ prefetch:
                    )
             )
             {
+                /* The data is in the I/O buffer unless the device
+                   handler left it in its own buffer to save a copy */
+                BYTE *iodata  = dev->iodirect ? dev->iodirect
+                                              : iobuf->data;
+                BYTE *ioend   = dev->iodirect ? dev->iodirect + count
+                                                - residual - 1
+                                              : iobuf->end;
+
                 /* Copy data from I/O buffer to main storage */
                 ARCH_DEP(copy_iobuf) (dev, dev->code, flags, addr,
                                       count - residual, ccwkey,
                                       idawfmt, idapmask,
-                                      iobuf->data,
-                                      iobuf->start, iobuf->end,
+                                      iodata,
+                                      iodata, ioend,
                                       &chanstat, &residual, &prefetch);
 
                 /* Update number of bytes in channel buffer */
@@ -5427,7 +5543,9 @@ breakchain:
                  IS_CCW_RDBACK(dev->code)))
             {
                 memcpy(area, "=>", 2);
-                format_data(area + 2, sizeof(area)-2, iobuf->data, MIN(count, 16));
+                format_data(area + 2, sizeof(area)-2,
+                            dev->iodirect ? dev->iodirect : iobuf->data,
+                            MIN(count, 16));
             }
             else
                 area[0] = '\0';
@@ -5780,7 +5898,26 @@ retry:
     */
     dev = NULL;
 
-    obtain_lock( &sysblk.iointqlk );
+#if defined( FEATURE_CHANNEL_SUBSYSTEM )
+    /* Quick exit without locking the queue if no interrupt is queued
+       for any subclass enabled in CR6 and no other CPU is waiting to
+       be woken for one.  (The queue still being non-empty there is
+       no need to update our IC_IOPENDING state either.)
+    */
+    if (1
+        && !SIE_MODE( regs )
+        && !sysblk.waiting_mask
+        && sysblk.iointq != NULL
+        && !(sysblk.iointisc & (regs->CR_L(6) >> 24))
+    )
+    {
+        sysblk.iointqquick++;
+        *pdev = NULL;
+        return 0;
+    }
+#endif
+
+    OBTAIN_IOINTQLK();
     {
         for (io = sysblk.iointq; io != NULL; io = io->next)
         {
@@ -5891,7 +6028,7 @@ retry:
         /* Verify that the interrupt for this device still exists and that
            TEST SUBCHANNEL has to be issued to clear an existing interrupt.
          */
-        obtain_lock( &sysblk.iointqlk );
+        OBTAIN_IOINTQLK();
         {
             for (io2 = sysblk.iointq; io2 != NULL && io2 != io; io2 = io2->next);
 
@@ -6120,7 +6257,7 @@ DEVLIST *pZoneDevs = NULL;              /* devices in requested zone */
 
     /* Remove from our list those devices
        without a pending interrupt queued */
-    obtain_lock(&sysblk.iointqlk);
+    OBTAIN_IOINTQLK();
     for (pDEVLIST = pZoneDevs, pPrevDEVLIST = NULL; pDEVLIST;)
     {
         /* Search interrupt queue for this device */
@@ -6246,7 +6383,7 @@ void call_execute_ccw_chain (int arch_mode, void* pDevBlk)
 
 DLL_EXPORT void Queue_IO_Interrupt( IOINT* io, U8 clrbsy, const char* location )
 {
-    obtain_lock( &sysblk.iointqlk );
+    OBTAIN_IOINTQLK();
     Queue_IO_Interrupt_QLocked( io, clrbsy, location );
     release_lock( &sysblk.iointqlk );
 }
@@ -6278,8 +6415,12 @@ IOINT* prev;
         io->next     = prev->next;
         prev->next   = io;
         io->priority = io->dev->priority;
+        io->iscmask  = 0x80 >> ((io->dev->pmcw.flag4 & PMCW4_ISC) >> 3);
     }
 
+    /* Note its interruption subclass as queued */
+    sysblk.iointisc |= io->iscmask;
+
     /* Update device flags according to interrupt type */
          if (io->pending)     io->dev->pending     = 1;
     else if (io->pcipending)  io->dev->pcipending  = 1;
@@ -6309,7 +6450,7 @@ IOINT* prev;
 DLL_EXPORT int Dequeue_IO_Interrupt( IOINT* io, const char* location )
 {
 int rc;
-    obtain_lock( &sysblk.iointqlk );
+    OBTAIN_IOINTQLK();
     rc = Dequeue_IO_Interrupt_QLocked( io, location );
     release_lock( &sysblk.iointqlk );
     return rc;
@@ -6345,6 +6486,14 @@ int rc = -1;        /* No I/O interrupts were queued for this device */
             break;    /* I/O interrupt successfully dequeued */
         }
     }
+
+    /* Recalculate the subclasses of the remaining interrupts */
+    if (rc == 0)
+    {
+        sysblk.iointisc = 0;
+        for (prev = sysblk.iointq; prev != NULL; prev = prev->next)
+            sysblk.iointisc |= prev->iscmask;
+    }
 #if 0 // (debugging example)
     if (sysblk.fishtest && io->dev->devnum == 0x0604)
         TRACE("+++ %s interrupt %sDEQueued for %4.4X @ %s\n",
@@ -6365,7 +6514,7 @@ int rc = -1;        /* No I/O interrupts were queued for this device */
 
 DLL_EXPORT void Update_IC_IOPENDING()
 {
-    obtain_lock( &sysblk.iointqlk );
+    OBTAIN_IOINTQLK();
     Update_IC_IOPENDING_QLocked();
     release_lock( &sysblk.iointqlk );
 }
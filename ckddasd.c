@@ -266,6 +266,7 @@ BYTE            serial[12+1] = {0};     /* Dasd serial number        */
     sfxchar = *sfxptr;
 
     /* process the remaining arguments */
+    dev->dasdmmap = 0;
     for (i = 1; i < argc; i++)
     {
         if (strcasecmp ("lazywrite", argv[i]) == 0)
@@ -306,6 +307,11 @@ BYTE            serial[12+1] = {0};     /* Dasd serial number        */
             dev->ckdfakewr = 1;
             continue;
         }
+        if (strcasecmp ("mmap", argv[i]) == 0)
+        {
+            dev->dasdmmap = 1;
+            continue;
+        }
         if (strlen (argv[i]) > 3 &&
             memcmp ("sf=", argv[i], 3) == 0)
         {
@@ -642,8 +648,23 @@ BYTE            serial[12+1] = {0};     /* Dasd serial number        */
     /* default for device cache is on */
     dev->devcache = TRUE;
 
-    if (!cckd) return 0;
-    else return cckd_dasd_init_handler(dev, argc, argv);
+    if (!cckd)
+    {
+        /* Map the image files if requested */
+        if (dev->dasdmmap && !dev->dasdcopy)
+            ckd_dasd_mmap (dev);
+        return 0;
+    }
+
+    /* Compressed images are always read through the cache */
+    if (dev->dasdmmap)
+    {
+        // "%1d:%04X CKD file %s: mmap not used: %s"
+        WRMSG( HHC00443, "W", LCSS_DEVNUM,
+               dev->filename, "compressed image" );
+        dev->dasdmmap = 0;
+    }
+    return cckd_dasd_init_handler(dev, argc, argv);
 
 } /* end function ckd_dasd_init_handler */
 
@@ -711,6 +732,70 @@ DEVBLK         *dev = data;             /* -> device block           */
 }
 
 
+/*-------------------------------------------------------------------*/
+/* Unmap the CKD image files                                         */
+/*-------------------------------------------------------------------*/
+static void ckd_dasd_munmap (DEVBLK *dev)
+{
+int     i;                              /* Index                     */
+
+    for (i = 0; i < CKD_MAXFILES; i++)
+    {
+#if !defined( _MSVC_ )
+        if (dev->dasdmap[i])
+            munmap (dev->dasdmap[i], dev->dasdmapsz[i]);
+#endif
+        dev->dasdmap[i] = NULL;
+        dev->dasdmapsz[i] = 0;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Map the CKD image files into storage                              */
+/*                                                                   */
+/* Track images are then read in place rather than being copied      */
+/* into a cache buffer.  Updates are still made to a cache buffer    */
+/* and written back with write(), which the shared mapping sees.     */
+/* If any file cannot be mapped the device uses read() as before.    */
+/*-------------------------------------------------------------------*/
+void ckd_dasd_mmap (DEVBLK *dev)
+{
+#if !defined( _MSVC_ )
+int             i;                      /* Index                     */
+struct stat     statbuf;                /* File information          */
+void           *p;                      /* -> Mapped file            */
+
+    for (i = 0; i < dev->ckdnumfd; i++)
+    {
+        if (fstat (dev->ckdfd[i], &statbuf) < 0)
+            p = MAP_FAILED;
+        else if ((U64)statbuf.st_size > (U64)SIZE_MAX)
+        {
+            errno = EFBIG;
+            p = MAP_FAILED;
+        }
+        else
+            p = mmap (NULL, (size_t)statbuf.st_size, PROT_READ,
+                      MAP_SHARED, dev->ckdfd[i], 0);
+        if (p == MAP_FAILED)
+        {
+            // "%1d:%04X CKD file %s: mmap not used: %s"
+            WRMSG( HHC00443, "W", LCSS_DEVNUM,
+                   dev->filename, strerror( errno ));
+            ckd_dasd_munmap (dev);
+            return;
+        }
+        dev->dasdmap[i] = p;
+        dev->dasdmapsz[i] = (size_t)statbuf.st_size;
+    }
+#else
+    // "%1d:%04X CKD file %s: mmap not used: %s"
+    WRMSG( HHC00443, "W", LCSS_DEVNUM,
+           dev->filename, "not supported on this platform" );
+#endif
+} /* end function ckd_dasd_mmap */
+
+
 static int ckd_dasd_read_track (DEVBLK *dev, int trk, BYTE *unitstat);
 /*-------------------------------------------------------------------*/
 /* Close the device                                                  */
@@ -734,7 +819,8 @@ BYTE    unitstat;                       /* Unit Status               */
             WRMSG( HHC00417, "I", LCSS_DEVNUM,
                    dev->filename, dev->cachehits, dev->cachemisses, dev->cachewaits );
 
-    /* Close all of the CKD image files */
+    /* Unmap and close all of the CKD image files */
+    ckd_dasd_munmap (dev);
     for (i = 0; i < dev->ckdnumfd; i++)
         if (dev->ckdfd[i] > 2)
             close (dev->ckdfd[i]);
@@ -797,6 +883,7 @@ int             cyl = 0;                /* Cylinder                  */
 int             head = 0;               /* Head                      */
 U64             offset;                 /* File offsets              */
 int             i,o,f;                  /* Indexes                   */
+int             prevtrk;                /* Previous track            */
 CKD_TRKHDR     *trkhdr;                 /* -> New track header       */
 
     // "%1d:%04X CKD file %s: read trk %d cur trk %d"
@@ -873,6 +960,7 @@ CKD_TRKHDR     *trkhdr;                 /* -> New track header       */
     /* Make the previous cache entry inactive */
     if (dev->cache >= 0)
         cache_setflag(CACHE_DEVBUF, dev->cache, ~CKD_CACHE_ACTIVE, 0);
+    prevtrk = dev->bufcur;
     dev->bufcur = dev->cache = -1;
 
     /* Return on special case when called by the close handler */
@@ -882,6 +970,48 @@ CKD_TRKHDR     *trkhdr;                 /* -> New track header       */
         return 0;
     }
 
+    /* Use the track image in place if the image files are mapped */
+    if (dev->dasdmap[0])
+    {
+        cache_unlock (CACHE_DEVBUF);
+
+        /* Set the file descriptor */
+        for (f = 0; f < dev->ckdnumfd; f++)
+            if (trk < dev->ckdhitrk[f]) break;
+        dev->fd = dev->ckdfd[f];
+
+        /* Calculate the track offset */
+        dev->ckdtrkoff = (U64)(CKD_DEVHDR_SIZE +
+             ((U64)(trk - (f ? dev->ckdhitrk[f-1] : 0))) * dev->ckdtrksz);
+
+        /* Validate the track header */
+        trkhdr = (CKD_TRKHDR*)(dev->dasdmap[f] + dev->ckdtrkoff);
+        if (0
+            || trkhdr->bin              != 0
+            || fetch_hw( trkhdr->cyl  ) != cyl
+            || fetch_hw( trkhdr->head ) != head
+        )
+        {
+            // "%1d:%04X CKD file %s: invalid track header for cyl %d head %d %02X %02X%02X %02X%02X"
+            WRMSG( HHC00418, "E", LCSS_DEVNUM,
+                   dev->filename, cyl, head, trkhdr->bin,
+                   trkhdr->cyl[0], trkhdr->cyl[1],
+                   trkhdr->head[0], trkhdr->head[1] );
+            ckd_build_sense (dev, 0, SENSE1_ITF, 0, 0, 0);
+            *unitstat = CSW_CE | CSW_DE | CSW_UC;
+            return -1;
+        }
+
+        dev->buf = (BYTE*)trkhdr;
+        dev->bufcur = trk;
+        dev->bufoff = 0;
+        dev->bufoffhi = dev->ckdtrksz;
+        dev->buflen = ckd_trklen (dev, dev->buf);
+        dev->bufsize = dev->ckdtrksz;
+
+        return 0;
+    }
+
 ckd_read_track_retry:
 
     /* Search the cache */
@@ -955,6 +1085,19 @@ ckd_read_track_retry:
     // "%1d:%04X CKD file %s: read trk %d reading file %d offset %"PRId64" len %d"
     LOGDEVTR( HHC00429, "I", dev->filename, trk, f+1, dev->ckdtrkoff, dev->ckdtrksz );
 
+#if defined( POSIX_FADV_WILLNEED )
+    /* If reading sequentially have the host start reading the
+       following tracks asynchronously while we read this one */
+    if (trk == prevtrk + 1 && dev->dasdcopy == 0
+        && (trk >= dev->bufrahint || trk + DEVBUF_HOST_RA < dev->bufrahint))
+    {
+        posix_fadvise( dev->fd, (off_t)(dev->ckdtrkoff + dev->ckdtrksz),
+                       (off_t) DEVBUF_HOST_RA * dev->ckdtrksz,
+                       POSIX_FADV_WILLNEED );
+        dev->bufrahint = trk + DEVBUF_HOST_RA / 2;
+    }
+#endif
+
     /* Seek to the track image offset */
     offset = dev->ckdtrkoff;
     offset = lseek (dev->fd, offset, SEEK_SET);
@@ -1040,6 +1183,46 @@ ckd_read_track_retry:
 } /* end function ckdread_read_track */
 
 
+/*-------------------------------------------------------------------*/
+/* Copy the current mapped track image into a cache buffer           */
+/*-------------------------------------------------------------------*/
+static
+void ckd_dasd_copy_track (DEVBLK *dev)
+{
+int             i, o;                   /* Indexes                   */
+BYTE           *mapbuf = dev->buf;      /* -> Mapped track image     */
+
+    cache_lock (CACHE_DEVBUF);
+
+ckd_copy_track_retry:
+
+    /* A stale entry may remain from an earlier update of the track */
+    i = cache_lookup (CACHE_DEVBUF, CKD_CACHE_SETKEY(dev->devnum, dev->bufcur), &o);
+    if (i < 0)
+    {
+        /* Wait if no available cache entry */
+        if (o < 0)
+        {
+            dev->cachewaits++;
+            cache_wait(CACHE_DEVBUF);
+            goto ckd_copy_track_retry;
+        }
+        i = o;
+        cache_setkey (CACHE_DEVBUF, i, CKD_CACHE_SETKEY(dev->devnum, dev->bufcur));
+    }
+
+    /* Make this cache entry active */
+    cache_setflag(CACHE_DEVBUF, i, 0, CKD_CACHE_ACTIVE|DEVBUF_TYPE_CKD);
+    cache_setage (CACHE_DEVBUF, i);
+    dev->buf = cache_getbuf(CACHE_DEVBUF, i, dev->ckdtrksz);
+    cache_unlock (CACHE_DEVBUF);
+
+    memcpy (dev->buf, mapbuf, dev->ckdtrksz);
+    dev->cache = i;
+    dev->bufsize = cache_getlen(CACHE_DEVBUF, dev->cache);
+
+} /* end function ckd_dasd_copy_track */
+
 /*-------------------------------------------------------------------*/
 /* Update a track image                                              */
 /*-------------------------------------------------------------------*/
@@ -1081,6 +1264,10 @@ int             rc;                     /* Return code               */
         return -1;
     }
 
+    /* A mapped track image is read-only so update a copy of it */
+    if (dev->cache < 0 && dev->dasdmap[0])
+        ckd_dasd_copy_track (dev);
+
     /* Copy the data into the buffer */
     if (buf) memcpy (dev->buf + off, buf, len);
 
@@ -1885,7 +2072,11 @@ CKD_RECHDR      rechdr;                 /* Record header             */
             *unitstat = CSW_CE | CSW_DE | CSW_UC;
             return -1;
         }
-        memcpy (buf, &dev->buf[dev->bufoff], dev->ckdcurdl);
+        /* Without a buffer the channel copies from the track image */
+        if (buf)
+            memcpy (buf, &dev->buf[dev->bufoff], dev->ckdcurdl);
+        else
+            dev->iodirect = &dev->buf[dev->bufoff];
         dev->bufoff += dev->ckdcurdl;
     }
 
@@ -2150,7 +2341,10 @@ BYTE            trk_ovfl;               /* == 1 if track ovfl write  */
        in the buffer which was not used by the previous CCW */
     if (chained & CCW_FLAGS_CD)
     {
-        memmove (iobuf, iobuf + dev->ckdpos, dev->ckdrem);
+        if (dev->iodirect)
+            dev->iodirect += dev->ckdpos;
+        else
+            memmove (iobuf, iobuf + dev->ckdpos, dev->ckdrem);
         num = (count < dev->ckdrem) ? count : dev->ckdrem;
         *residual = count - num;
         if (count < dev->ckdrem) *more = 1;
@@ -2398,8 +2592,10 @@ BYTE            trk_ovfl;               /* == 1 if track ovfl write  */
         if (count < size) *more = 1;
         offset = 0;
 
-        /* Read data field */
-        rc = ckd_read_data (dev, code, iobuf, unitstat);
+        /* Read data field, leaving it in the track image for the
+           channel unless the record overflows onto the next track */
+        rc = ckd_read_data (dev, code, dev->ckdtrkof ? iobuf : NULL,
+                            unitstat);
         if (rc < 0) break;
 
         /* If track overflow, keep reading */
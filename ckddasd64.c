@@ -125,6 +125,7 @@ BYTE            serial[12+1] = {0};     /* Dasd serial number        */
     sfxchar = *sfxptr;
 
     /* process the remaining arguments */
+    dev->dasdmmap = 0;
     for (i = 1; i < argc; i++)
     {
         if (strcasecmp ("lazywrite", argv[i]) == 0)
@@ -165,6 +166,11 @@ BYTE            serial[12+1] = {0};     /* Dasd serial number        */
             dev->ckdfakewr = 1;
             continue;
         }
+        if (strcasecmp ("mmap", argv[i]) == 0)
+        {
+            dev->dasdmmap = 1;
+            continue;
+        }
         if (strlen (argv[i]) > 3 &&
             memcmp ("sf=", argv[i], 3) == 0)
         {
@@ -501,7 +507,22 @@ BYTE            serial[12+1] = {0};     /* Dasd serial number        */
     /* default for device cache is on */
     dev->devcache = TRUE;
 
-    if (!cckd) return 0;
-    else return cckd64_dasd_init_handler(dev, argc, argv);
+    if (!cckd)
+    {
+        /* Map the image files if requested */
+        if (dev->dasdmmap && !dev->dasdcopy)
+            ckd_dasd_mmap (dev);
+        return 0;
+    }
+
+    /* Compressed images are always read through the cache */
+    if (dev->dasdmmap)
+    {
+        // "%1d:%04X CKD file %s: mmap not used: %s"
+        WRMSG( HHC00443, "W", LCSS_DEVNUM,
+               dev->filename, "compressed image" );
+        dev->dasdmmap = 0;
+    }
+    return cckd64_dasd_init_handler(dev, argc, argv);
 
 } /* end function ckd64_dasd_init_handler */
@@ -174,6 +174,23 @@
   "Sets the instruction address or address range where you wish to halt\n"      \
   "execution.  This command is synonymous with the \"s+\" command.\n"
 
+#define cache_cmd_desc          "Display or set cache replacement policy"
+#define cache_cmd_help          \
+                                \
+  "Format: \"cache [DEVBUF|L2 [CLOCK|2Q]]\"\n"                                  \
+  "\n"                                                                          \
+  "Displays or sets the replacement policy used when a cache entry must\n"      \
+  "be stolen for a new track image (DEVBUF) or cckd level 2 table (L2).\n"      \
+  "\n"                                                                          \
+  "CLOCK, the default, approximates least recently used replacement.\n"         \
+  "2Q is scan resistant: a newly cached item stays in a small\n"                \
+  "probationary queue and only enters the main cache if it is referenced\n"     \
+  "again soon after being replaced, so that a single sequential pass\n"         \
+  "over a dataset does not displace the cache's working set.\n"                 \
+  "\n"                                                                          \
+  "With no operands the current policies are displayed.  The hit ratio\n"       \
+  "achieved under each policy is reported by the cachestats command.\n"
+
 #define cachestats_cmd_desc     "Cache stats command"
 
 #define cckd_cmd_desc           "Compressed CKD command"
@@ -190,14 +207,18 @@
   "                    single comma and no intervening blanks. The list of\n"   \
   "                    supported cckd options are:\n"                           \
                                                                          "\n"   \
-  "  comp=n        Override compression                  (-1,0,1,2)\n"          \
+  "  comp=n        Override compression              (-1,0,1,2,4,8)\n"          \
+  "  compbench=n   Benchmark track compression        (10 ... 1000)\n"          \
   "  compparm=n    Override compression parm             (-1 ... 9)\n"          \
   "  debug=n       Enable CCW tracing debug messages       (0 or 1)\n"          \
   "  freepend=n    Set free pending cycles               (-1 ... 4)\n"          \
+  "  fspbench=n    Benchmark free space             (100 .. 100000)\n"          \
   "  fsync=n       Enable fsync                            (0 or 1)\n"          \
   "  gcint=n       Set garbage collector interval (sec)  ( 0 .. 60)\n"          \
   "  gcparm=n      Set garbage collector parameter       (-8 ... 8)\n"          \
+  "  gcrate=n      Set garbage collector i/o KB/sec    (0=no limit)\n"          \
   "  gcstart=n     Start garbage collector                 (0 or 1)\n"          \
+  "  gcstep=n      Set garbage collector step msecs    (0 ... 1000)\n"          \
   "  linuxnull=n   Check for null linux tracks             (0 or 1)\n"          \
   "  nosfd=n       Disable stats report at close           (0 or 1)\n"          \
   "  nostress=n    Disable stress writes                   (0 or 1)\n"          \
@@ -459,7 +480,13 @@
   "to address a threading issue (possibly related to the cygwin Pthreads\n"     \
   "implementation) on Windows systems.\n"                                       \
   "\n"                                                                          \
-  "The default for Windows is 8. The default for all other systems is 0.\n"
+  "The default for Windows is 8. The default for all other systems is 0.\n"     \
+  "\n"                                                                          \
+  "Without an argument the current thread counts are displayed along with\n"    \
+  "statistics on the number of queued I/O requests and how long they had\n"     \
+  "to wait for a thread. When choosing the next request to service, an\n"       \
+  "idle thread prefers one for a device it serviced previously provided\n"      \
+  "it is of the same priority as the request at the head of the queue.\n"
 
 #define diag8_cmd_desc          "Set DIAG 8 instruction options"
 #define diag8_cmd_help          \
@@ -812,7 +839,8 @@
 #define mainsize_cmd_desc       "Define/Display mainsize parameter"
 #define mainsize_cmd_help       \
                                 \
-  "Format: mainsize [ mmmm | nnnS [ lOCK | unlOCK ] ]\n"                        \
+  "Format: mainsize [ mmmm | nnnS [ lOCK | unlOCK ] [ HUGEpages |\n"            \
+  "                                                  NOHUGEpages ] ]\n"         \
   "        mmmm    - define main storage size mmmm Megabytes\n"                 \
   "\n"                                                                          \
   "        nnnS    - define main storage size nnn S where S is the\n"           \
@@ -828,6 +856,9 @@
   "        lOCK    - attempt to lock storage (pages lock by host OS)\n"         \
   "        unlOCK  - leave storage unlocked (pagable by host OS)\n"             \
   "\n"                                                                          \
+  "     HUGEpages  - back storage with host huge pages if possible\n"           \
+  "   NOHUGEpages  - back storage with ordinary host pages (default)\n"         \
+  "\n"                                                                          \
   "      (none)    - display current mainsize value\n"                          \
   "\n"                                                                          \
   " Note: Multipliers 'T', 'P', and 'E' are not available on 32bit machines\n"
@@ -973,6 +1004,18 @@
   "Windows in its adapter binding order or for newer versions of CTCI-WIN\n"    \
   "(3.6.0) what you defined as your default CTCI-WIN host network adapter.\n"
 
+#define numa_cmd_desc           "Display or set host NUMA placement"
+#define numa_cmd_help           \
+                                \
+  "Format: \"numa [PIN|NOPIN] [INTERLEAVE|LOCAL]\". PIN restricts each\n"       \
+  "CPU thread to the host CPUs of one host NUMA node, assigning emulated\n"     \
+  "CPUs to nodes round robin, so that CPU threads no longer migrate\n"          \
+  "between sockets. INTERLEAVE spreads main and expanded storage evenly\n"      \
+  "across all nodes. LOCAL (the default) leaves each page on the node of\n"     \
+  "the thread which first touches it. Enter \"numa\" by itself to display\n"    \
+  "the host's nodes and CPUs, where a sample of main storage currently\n"       \
+  "resides, and which node each CPU is pinned to.\n"
+
 #define numcpu_cmd_desc         "Set numcpu parameter"
 //#define numvec_cmd_desc         "Set numvec parameter"
 #define osa_cmd_desc            "(Synonym for 'qeth')"
@@ -1229,6 +1272,17 @@
 
 #define restart_cmd_desc        "Generate restart interrupt"
 #define resume_cmd_desc         "Resume hercules"
+#define resume_cmd_help         \
+                                \
+  "Format: \"resume [filename] [INCREMENTAL]\". Restores the state saved\n"     \
+  "by a previous suspend command from the named file (default\n"                \
+  "hercules.srf.gz). The configuration must match the one the file was\n"       \
+  "created with. Main storage is expanded by several threads at once.\n"        \
+  "If the file was created by an incremental suspend then the storage\n"        \
+  "of its base file is restored first. With INCREMENTAL the frames of\n"        \
+  "main storage that are changed from then on are noted, at some cost\n"        \
+  "to every store, so that \"suspend filename INCREMENTAL\" can later\n"        \
+  "write only those frames to a new file based on this one.\n"
 
 #if defined(HAVE_OBJECT_REXX) || defined(HAVE_REGINA_REXX)
 #define rexx_cmd_desc           "Modify/Display Hercules's Rexx settings"
@@ -1568,6 +1622,22 @@
 
 #define store_cmd_desc          "Store CPU status at absolute zero"
 #define suspend_cmd_desc        "Suspend hercules"
+#define suspend_cmd_help        \
+                                \
+  "Format: \"suspend [filename] [INCREMENTAL] [LIVE]\". Stops all CPUs,\n"      \
+  "saves the state of the system to the named file (default\n"                  \
+  "hercules.srf.gz) and then shuts hercules down. Main storage is\n"            \
+  "compressed by several threads at once and frames containing only\n"          \
+  "zeroes are left out. INCREMENTAL, which can only be used after a\n"          \
+  "\"resume filename INCREMENTAL\" command, saves only the frames of\n"         \
+  "main storage changed since the resume. The new file then refers to\n"        \
+  "the resumed file by name, which must still be available (and not be\n"       \
+  "replaced) when the new file is resumed. LIVE copies main storage\n"          \
+  "while the CPUs are still running, then copies the frames changed\n"          \
+  "meanwhile again until few enough are left, and only then stops the\n"        \
+  "CPUs to save the rest. Changes are noted only for the duration of a\n"       \
+  "LIVE suspend unless they already were since the resume.\n"                   \
+  "The time the CPUs were stopped for is reported.\n"
 #define symptom_cmd_desc        "Alias for traceopt"
 #define sysclear_cmd_desc       "System Clear Reset manual operation"
 #define sysclear_cmd_help       \
@@ -1721,6 +1791,21 @@
   "to your chosen HERCPRIO and TODPRIO priority settings.\n"
 
 #define tlb_cmd_desc            "Display TLB tables"
+#define tlbways_cmd_desc        "Display or set TLB associativity and statistics"
+#define tlbways_cmd_help        \
+                                \
+  "Format: \"tlbways [1|2|4|RESET]\". Sets the associativity of each\n"         \
+  "CPU's TLB (Translation-Lookaside Buffer), which has 1024 sets of\n"          \
+  "the specified number of ways each. The default is 1 (a direct-mapped\n"      \
+  "1024 entry TLB). Guests with large working sets may benefit from more\n"     \
+  "ways. All CPUs must be stopped to change the setting, which purges\n"        \
+  "all TLBs. RESET resets the statistics. Enter \"tlbways\" by itself to\n"     \
+  "display the current setting and, for each CPU's lookups which were\n"        \
+  "not satisfied by the most recently used entry of their set, the\n"           \
+  "number found in another way (hits) and not found (misses), the\n"            \
+  "evictions of valid entries (counted only with more than one way) and\n"      \
+  "the hits in the separate 64 entry TLB of EDAT-1 large (1M) frames.\n"
+
 #define toddrag_cmd_desc        "Display or set TOD clock drag factor"
 #define traceopt_cmd_desc       "Instruction and/or CCW trace display option"
 #define traceopt_cmd_help       \
@@ -1764,7 +1849,7 @@
 #define xpndsize_cmd_desc       "Define/Display xpndsize parameter"
 #define xpndsize_cmd_help       \
                                 \
-  "Format: xpndsize [ mmmm | nnnS [ lOCK | unlOCK ] ]\n"                                \
+  "Format: xpndsize [ mmmm | nnnS [ lOCK | unlOCK ] [ HUGEpages | NOHUGEpages ] ]\n"    \
   "        mmmm    - define expanded storage size mmmm Megabytes\n"                     \
   "\n"                                                                                  \
   "        nnnS    - define expanded storage size nnn S where S is the multiplier\n"    \
@@ -1777,6 +1862,9 @@
   "        lOCK    - attempt to lock storage (pages lock by host OS)\n"                 \
   "        unlOCK  - leave storage unlocked (pagable by host OS)\n"                     \
   "\n"                                                                                  \
+  "     HUGEpages  - back storage with host huge pages if possible\n"                   \
+  "   NOHUGEpages  - back storage with ordinary host pages (default)\n"                 \
+  "\n"                                                                                  \
   " Note: Multiplier 'T' is not available on 32bit machines\n"                          \
   "       Expanded storage is limited to 1G on 32bit machines\n"
 
@@ -1856,6 +1944,7 @@ COMMAND( "b",                       trace_cmd,              SYSCMDNOPER,
 COMMAND( "b?",                      trace_cmd,              SYSCMDNOPER,        bquest_cmd_desc,        NULL                )
 COMMAND( "b+",                      trace_cmd,              SYSCMDNOPER,        bplus_cmd_desc,         NULL                )
 
+COMMAND( "cache",                   EXTCMD(cache_cmd),      SYSCMDNOPER,        cache_cmd_desc,         cache_cmd_help      )
 COMMAND( "cachestats",              EXTCMD(cachestats_cmd), SYSCMDNOPER,        cachestats_cmd_desc,    NULL                )
 COMMAND( "clocks",                  clocks_cmd,             SYSCMDNOPER,        clocks_cmd_desc,        NULL                )
 COMMAND( "codepage",                codepage_cmd,           SYSCMDNOPER,        codepage_cmd_desc,      codepage_cmd_help   )
@@ -1878,6 +1967,7 @@ COMMAND( "loadtext",                loadtext_cmd,           SYSCMDNOPER,
 COMMAND( "maxcpu",                  maxcpu_cmd,             SYSCMDNOPER,        maxcpu_cmd_desc,        NULL                )
 CMDABBR( "mounted_tape_reinit",  9, mounted_tape_reinit_cmd,SYSCMDNOPER,        mtapeinit_cmd_desc,     mtapeinit_cmd_help  )
 COMMAND( "netdev",                  netdev_cmd,             SYSCMDNOPER,        netdev_cmd_desc,        netdev_cmd_help     )
+COMMAND( "numa",                    numa_cmd,               SYSCMDNOPER,        numa_cmd_desc,          numa_cmd_help       )
 COMMAND( "numcpu",                  numcpu_cmd,             SYSCMDNOPER,        numcpu_cmd_desc,        NULL                )
 //COMMAND( "numvec",                  numvec_cmd,             SYSCMDNOPER,        numvec_cmd_desc,        NULL                )
 COMMAND( "osa",                     qeth_cmd,               SYSCMDNOPER,        osa_cmd_desc,           qeth_cmd_help       )
@@ -1891,7 +1981,7 @@ COMMAND( "qd",                      qd_cmd,                 SYSCMDNOPER,
 COMMAND( "qeth",                    qeth_cmd,               SYSCMDNOPER,        qeth_cmd_desc,          qeth_cmd_help       )
 COMMAND( "quiet",                   quiet_cmd,              SYSCMDNOPER,        quiet_cmd_desc,         quiet_cmd_help      )
 COMMAND( "r",                       abs_or_r_cmd,           SYSCMDNOPER,        r_cmd_desc,             r_cmd_help          )
-COMMAND( "resume",                  resume_cmd,             SYSCMDNOPER,        resume_cmd_desc,        NULL                )
+COMMAND( "resume",                  resume_cmd,             SYSCMDNOPER,        resume_cmd_desc,        resume_cmd_help     )
 
 COMMAND( "s-",                      trace_cmd,              SYSCMDNOPER,        sminus_cmd_desc,        NULL                )
 COMMAND( "s",                       trace_cmd,              SYSCMDNOPER,        s_cmd_desc,             s_cmd_help          )
@@ -1901,7 +1991,7 @@ COMMAND( "s+",                      trace_cmd,              SYSCMDNOPER,
 COMMAND( "savecore",                savecore_cmd,           SYSCMDNOPER,        savecore_cmd_desc,      savecore_cmd_help   )
 COMMAND( "script",                  script_cmd,             SYSCMDNOPER,        script_cmd_desc,        script_cmd_help     )
 COMMAND( "sh",                      sh_cmd,                 SYSCMDNOPER,        sh_cmd_desc,            sh_cmd_help         )
-COMMAND( "suspend",                 suspend_cmd,            SYSCMDNOPER,        suspend_cmd_desc,       NULL                )
+COMMAND( "suspend",                 suspend_cmd,            SYSCMDNOPER,        suspend_cmd_desc,       suspend_cmd_help    )
 COMMAND( "symptom",                 traceopt_cmd,           SYSCMDNOPER,        symptom_cmd_desc,       NULL                )
 
 COMMAND( "t-",                      trace_cmd,              SYSCMDNOPER,        tminus_cmd_desc,        NULL                )
@@ -1914,6 +2004,7 @@ COMMAND( "txf",                     txf_cmd,                SYSCMDNOPER,
 COMMAND( "t+-",                     auto_trace_cmd,         SYSCMDNOPER,        auto_trace_desc,        auto_trace_help     )
 COMMAND( "timerint",                timerint_cmd,           SYSCMDNOPER,        timerint_cmd_desc,      timerint_cmd_help   )
 COMMAND( "tlb",                     tlb_cmd,                SYSCMDNOPER,        tlb_cmd_desc,           NULL                )
+COMMAND( "tlbways",                 tlbways_cmd,            SYSCMDNOPER,        tlbways_cmd_desc,       tlbways_cmd_help    )
 COMMAND( "toddrag",                 toddrag_cmd,            SYSCMDNOPER,        toddrag_cmd_desc,       NULL                )
 COMMAND( "traceopt",                traceopt_cmd,           SYSCMDNOPER,        traceopt_cmd_desc,      traceopt_cmd_help   )
 COMMAND( "u",                       u_cmd,                  SYSCMDNOPER,        u_cmd_desc,             u_cmd_help          )
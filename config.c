@@ -158,6 +158,98 @@ int configure_memfree( int mfree )
     return 0;
 }
 
+/*-------------------------------------------------------------------*/
+/* alloc_storage - obtain zeroed main or expanded storage            */
+/*-------------------------------------------------------------------*/
+/* When huge pages are requested the storage is first sought from    */
+/* the host's reserved pool of 2M huge pages (MAP_HUGETLB with       */
+/* MAP_HUGE_2MB, as the host's default huge page size need not be    */
+/* 2M), and failing that from an ordinary anonymous mapping which    */
+/* the host is asked to back with transparent huge pages             */
+/* (MADV_HUGEPAGE), so that far fewer host TLB entries are needed    */
+/* to map guest storage.  If both fail we quietly fall back to       */
+/* ordinary storage.  *how is set to the HUGEPAGES_xxx value         */
+/* obtained, which must be passed back to free_storage along with    */
+/* the same size.                                                    */
+/*-------------------------------------------------------------------*/
+#if defined( MAP_HUGETLB ) && !defined( MAP_HUGE_2MB ) && defined( MAP_HUGE_SHIFT )
+  #define MAP_HUGE_2MB  (21 << MAP_HUGE_SHIFT)
+#endif
+
+static BYTE* alloc_storage( U64 size, bool huge, BYTE* how )
+{
+#if !defined( _MSVC_ )
+    void*  p;
+
+    if (huge)
+    {
+        size = (size + (HUGEPAGE_SIZE - 1)) & ~(HUGEPAGE_SIZE - 1);
+
+#if defined( MAP_HUGETLB ) && defined( MAP_HUGE_2MB )
+        p = mmap( NULL, (size_t) size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB,
+                  -1, 0 );
+
+        if (p != MAP_FAILED)
+        {
+            *how = HUGEPAGES_HUGETLB;
+            return p;
+        }
+#endif
+#if defined( MADV_HUGEPAGE )
+        p = mmap( NULL, (size_t) size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+        if (p != MAP_FAILED)
+        {
+            if (madvise( p, (size_t) size, MADV_HUGEPAGE ) == 0)
+            {
+                *how = HUGEPAGES_THP;
+                return p;
+            }
+            munmap( p, (size_t) size );
+        }
+#endif
+    }
+#else
+    UNREFERENCED( huge );
+#endif
+
+    *how = HUGEPAGES_NONE;
+    return calloc( (size_t) size, 1 );
+}
+
+/*-------------------------------------------------------------------*/
+/* free_storage - release storage obtained by alloc_storage          */
+/*-------------------------------------------------------------------*/
+static void free_storage( BYTE* addr, U64 size, BYTE how )
+{
+#if !defined( _MSVC_ )
+    if (how != HUGEPAGES_NONE)
+    {
+        size = (size + (HUGEPAGE_SIZE - 1)) & ~(HUGEPAGE_SIZE - 1);
+        munmap( addr, (size_t) size );
+        return;
+    }
+#else
+    UNREFERENCED( size );
+    UNREFERENCED( how );
+#endif
+    free( addr );
+}
+
+/*-------------------------------------------------------------------*/
+/* hugepages_msg - report huge page backing of storage               */
+/*-------------------------------------------------------------------*/
+static void hugepages_msg( const char* what, BYTE how )
+{
+    // "%s storage is backed by %s"
+    WRMSG( HHC01434, "I", what,
+        how == HUGEPAGES_HUGETLB ? "huge pages (MAP_HUGETLB)" :
+        how == HUGEPAGES_THP     ? "transparent huge pages (MADV_HUGEPAGE)" :
+                                   "ordinary pages; huge pages are not available" );
+}
+
 /*-------------------------------------------------------------------*/
 /*  adjust_mainsize   --   range check MAINSIZE by architecture      */
 /*-------------------------------------------------------------------*/
@@ -232,32 +324,50 @@ DISABLE_GCC_WARNING( "-Wint-to-pointer-cast" )
 
 static U64    config_allocmsize  = 0;
 static BYTE*  config_allocmaddr  = NULL;
+static U64    config_allocmlen   = 0;       /* bytes allocated       */
+static bool   config_allocmhuge  = false;   /* huge pages requested  */
+static BYTE   config_allocmhow   = HUGEPAGES_NONE;
 
 int configure_storage( U64 mainsize /* number of 4K pages */ )
 {
     BYTE*  mainstor;
     BYTE*  storkeys;
     BYTE*  dofree = NULL;
+    U64    freelen = 0;
+    BYTE   freehow = HUGEPAGES_NONE;
     char*  mfree  = NULL;
     U64    storsize;
     U32    skeysize;
+    U64    alignsize;
 
     /* Ensure all CPUs have been stopped */
     if (are_any_cpus_started())
         return HERRCPUONL;
 
+    /* Changes since the last resume can no longer be tracked */
+    sysblk.srframes = 0;
+    free( sysblk.srdirty );
+    free( sysblk.srbase  );
+    sysblk.srdirty = NULL;
+    sysblk.srabs   = NULL;
+    sysblk.srbase  = NULL;
+
     /* Release storage and return if deconfiguring */
     if (mainsize == ~0ULL)
     {
         if (config_allocmaddr)
-            free( config_allocmaddr );
+            free_storage( config_allocmaddr, config_allocmlen, config_allocmhow );
 
         sysblk.storkeys = 0;
         sysblk.mainstor = 0;
         sysblk.mainsize = 0;
+        sysblk.mainstor_huge = HUGEPAGES_NONE;
 
         config_allocmsize = 0;
         config_allocmaddr = NULL;
+        config_allocmlen  = 0;
+        config_allocmhuge = false;
+        config_allocmhow  = HUGEPAGES_NONE;
 
         return 0;
     }
@@ -303,23 +413,38 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
     skeysize += (_4K-1);
     skeysize >>= SHIFT_4K;
 
+    /* With huge pages MAINSTOR must start on a huge page boundary
+       too, so round the storage key array up to whole huge pages */
+    if (sysblk.huge_mainstor)
+    {
+        alignsize = HUGEPAGE_SIZE;
+        skeysize += (HUGEPAGE_SIZE >> SHIFT_4K) - 1;
+        skeysize &= ~((HUGEPAGE_SIZE >> SHIFT_4K) - 1);
+    }
+    else
+        alignsize = _4K;
+
     /* Add number of pages needed for our storage key array */
     storsize += skeysize;
 
     /* New memory is obtained only if the requested and calculated size
      * is larger than the last allocated size, or if the request is for
-     * less than 2M of memory.
+     * less than 2M of memory, or if huge pages were requested or not.
      */
     if (0
         || (storsize > config_allocmsize)
         || (storsize < config_allocmsize && mainsize <= DEF_MAINSIZE_PAGES)
+        || (sysblk.huge_mainstor != config_allocmhuge)
     )
     {
+        U64   alloclen = (storsize << SHIFT_4K) + alignsize;
+        BYTE  how;
+
         if (config_mfree && mainsize > DEF_MAINSIZE_PAGES)
             mfree = malloc( config_mfree );
 
         /* Obtain storage with pagesize hint for cleanest allocation */
-        storkeys = calloc( (size_t)(storsize + 1), _4K );
+        storkeys = alloc_storage( alloclen, sysblk.huge_mainstor, &how );
 
         if (mfree)
             free( mfree );
@@ -342,14 +467,26 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
         /* Previously allocated storage to be freed, update actual
          * storage pointers and adjust new storage to page boundary.
          */
-        dofree = config_allocmaddr;
+        dofree  = config_allocmaddr;
+        freelen = config_allocmlen;
+        freehow = config_allocmhow;
 
         config_allocmsize = storsize;
         config_allocmaddr = storkeys;
+        config_allocmlen  = alloclen;
+        config_allocmhuge = sysblk.huge_mainstor;
+        config_allocmhow  = how;
 
         sysblk.main_clear = 1;
+        sysblk.mainstor_huge = how;
+
+        if (sysblk.huge_mainstor)
+            hugepages_msg( "Main", how );
 
-        storkeys = (BYTE*)(((U64)storkeys + (_4K-1)) & ~0x0FFFULL);
+        if (sysblk.numaintlv)
+            set_storage_numa_policy( config_allocmaddr, alloclen, true );
+
+        storkeys = (BYTE*)(((U64)storkeys + (alignsize-1)) & ~(alignsize-1));
     }
     else
     {
@@ -375,7 +512,7 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
      *         allocation.
      */
     if (dofree)
-        free( dofree );
+        free_storage( dofree, freelen, freehow );
 
     /* Initial power-on reset for main storage */
     storage_clear();  /* only clears if needed */
@@ -418,12 +555,61 @@ int configure_storage( U64 mainsize /* number of 4K pages */ )
     return 0;
 }
 
+/*-------------------------------------------------------------------*/
+/*-------------------------------------------------------------------*/
+/* configure_numa - set host NUMA placement of CPUs and storage      */
+/*-------------------------------------------------------------------*/
+/* When pinned each CPU thread is restricted to the host CPUs of one */
+/* NUMA node, assigning emulated CPUs to nodes round robin, so that  */
+/* threads no longer migrate across sockets.  Main and expanded      */
+/* storage are either interleaved across all nodes or left with the  */
+/* host's default first-touch placement.  Returns the first error.   */
+/*-------------------------------------------------------------------*/
+int configure_numa( bool pin, bool interleave )
+{
+    int  i, rc, err = 0;
+
+    OBTAIN_INTLOCK( NULL );
+    {
+        for (i=0; i < sysblk.maxcpu; i++)
+        {
+            if (IS_CPU_ONLINE( i ) && (pin || sysblk.numapin))
+            {
+                rc = set_thread_numa_node( sysblk.cputid[i],
+                                           pin ? HOST_NUMA_NODE( i ) : -1 );
+                if (rc && !err)
+                    err = rc;
+            }
+        }
+        sysblk.numapin = pin;
+    }
+    RELEASE_INTLOCK( NULL );
+
+    if (interleave != sysblk.numaintlv)
+    {
+        if (sysblk.mainstor && (rc = set_storage_numa_policy(
+            sysblk.mainstor, sysblk.mainsize, interleave )) && !err)
+            err = rc;
+
+        if (sysblk.xpndstor && (rc = set_storage_numa_policy(
+            sysblk.xpndstor, (U64) sysblk.xpndsize << XSTORE_PAGESHIFT,
+            interleave )) && !err)
+            err = rc;
+
+        sysblk.numaintlv = interleave;
+    }
+
+    return err;
+}
+
 /*-------------------------------------------------------------------*/
 /* configure_xstorage - configure EXPANDED storage                   */
 /*-------------------------------------------------------------------*/
 
 static U64    config_allocxsize  = 0;
 static BYTE*  config_allocxaddr  = NULL;
+static bool   config_allocxhuge  = false;   /* huge pages requested  */
+static BYTE   config_allocxhow   = HUGEPAGES_NONE;
 
 int configure_xstorage( U64 xpndsize )
 {
@@ -431,6 +617,8 @@ int configure_xstorage( U64 xpndsize )
 
     BYTE*  xpndstor;
     BYTE*  dofree = NULL;
+    U64    freesize = 0;
+    BYTE   freehow  = HUGEPAGES_NONE;
     char*  mfree  = NULL;
 
     /* Ensure all CPUs have been stopped */
@@ -441,27 +629,38 @@ int configure_xstorage( U64 xpndsize )
     if (!xpndsize || xpndsize == ~0ULL)
     {
         if (config_allocxaddr)
-            free(config_allocxaddr);
+            free_storage( config_allocxaddr,
+                (config_allocxsize + 1) << SHIFT_MEGABYTE, config_allocxhow );
 
         sysblk.xpndsize = 0;
         sysblk.xpndstor = 0;
+        sysblk.xpndstor_huge = HUGEPAGES_NONE;
 
         config_allocxsize = 0;
         config_allocxaddr = NULL;
+        config_allocxhuge = false;
+        config_allocxhow  = HUGEPAGES_NONE;
 
         return 0;
     }
 
     /* New memory is obtained only if the requested and calculated size
-     * is larger than the last allocated size.
+     * is larger than the last allocated size, or if huge pages were
+     * requested or not.
      */
-    if (xpndsize > config_allocxsize)
+    if (0
+        || (xpndsize > config_allocxsize)
+        || (sysblk.huge_xpndstor != config_allocxhuge)
+    )
     {
+        BYTE  how;
+
         if (config_mfree)
             mfree = malloc( config_mfree );
 
         /* Obtain expanded storage, hinting to megabyte boundary */
-        xpndstor = calloc( (size_t)(xpndsize + 1), ONE_MEGABYTE );
+        xpndstor = alloc_storage( (xpndsize + 1) << SHIFT_MEGABYTE,
+                                  sysblk.huge_xpndstor, &how );
 
         if (mfree)
             free( mfree );
@@ -484,12 +683,24 @@ int configure_xstorage( U64 xpndsize )
         /* Previously allocated storage to be freed, update actual
          * storage pointers and adjust new storage to megabyte boundary.
          */
-        dofree = config_allocxaddr;
+        dofree   = config_allocxaddr;
+        freesize = (config_allocxsize + 1) << SHIFT_MEGABYTE;
+        freehow  = config_allocxhow;
 
         config_allocxsize = xpndsize;
         config_allocxaddr = xpndstor;
+        config_allocxhuge = sysblk.huge_xpndstor;
+        config_allocxhow  = how;
 
         sysblk.xpnd_clear = 1;
+        sysblk.xpndstor_huge = how;
+
+        if (sysblk.huge_xpndstor)
+            hugepages_msg( "Expanded", how );
+
+        if (sysblk.numaintlv)
+            set_storage_numa_policy( config_allocxaddr,
+                (xpndsize + 1) << SHIFT_MEGABYTE, true );
 
         xpndstor = (BYTE*)(((U64)xpndstor + (ONE_MEGABYTE - 1)) &
                            ~((U64)ONE_MEGABYTE - 1));
@@ -513,7 +724,7 @@ int configure_xstorage( U64 xpndsize )
      *         allocation.
      */
     if (dofree)
-        free( dofree );
+        free_storage( dofree, freesize, freehow );
 
     /* Initial power-on reset for expanded storage */
     xstorage_clear();
@@ -1113,7 +1324,7 @@ int deconfigure_cpu( int target_cpu )
     /* If CPU isn't already deconfigured... */
     if (IS_CPU_ONLINE( target_cpu ))
     {
-        int   ourcpu;
+        int   ourcpu  = -1;
         BYTE  arecpu  = are_cpu_thread( &ourcpu );
 
         /* If we're NOT trying to deconfigure ourselves */
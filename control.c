@@ -3575,8 +3575,10 @@ int     rc;                             /* return code from load_psw */
     memcpy( &newregs, regs, sysblk.regs_copy_len );
 
     /* Now INVALIDATE ALL TLB ENTRIES in our working copy.. */
-    memset( &newregs.tlb.vaddr, 0, TLBN * sizeof(DW) );
+    CLEAR_TLB( &newregs.tlb );
     newregs.tlbID = 1;
+    newregs.tlbxway = NULL;     /* (direct-mapped TLB in copy) */
+    newregs.tlbways = 1;
 
     /* Set the breaking event address register in the copy */
     SET_BEAR_REG( &newregs, newregs.ip - (likely( !newregs.execflag ) ? 2 :
@@ -2334,6 +2334,10 @@ int   rc;
     /* Set CPU thread priority */
     set_thread_priority( sysblk.cpuprio);
 
+    /* Pin CPU thread to its host NUMA node if requested */
+    if (sysblk.numapin)
+        set_thread_numa_node( thread_id(), HOST_NUMA_NODE( cpu ));
+
     /* Display thread started message on control panel */
 
     MSGBUF( thread_name, "Processor %s%02X", PTYPSTR( cpu ), cpu );
@@ -2369,6 +2373,34 @@ int   rc;
     return NULL;
 } /* end function cpu_thread */
 
+/*-------------------------------------------------------------------*/
+/* Allocate the TLB ways beyond way 0 (REGS.tlb) for TLBWAYS         */
+/*-------------------------------------------------------------------*/
+/* The new ways start out empty.  Way 0 is left alone, so the caller */
+/* must purge it if the TLB was in use.  If the ways cannot be       */
+/* obtained the CPU keeps using a direct-mapped TLB and -1 is        */
+/* returned.                                                         */
+/*-------------------------------------------------------------------*/
+int resize_tlb( REGS* regs, int ways )
+{
+    TLB*  xway = NULL;
+    int   rc   = 0;
+
+    if (ways == regs->tlbways)
+        return 0;
+
+    if (ways > 1 && !(xway = calloc_aligned( (ways - 1) * sizeof( TLB ), 4096 )))
+        rc = -1;
+
+    if (regs->tlbxway)
+        free_aligned( regs->tlbxway );
+
+    regs->tlbxway = xway;
+    regs->tlbways = xway ? ways : 1;
+
+    return rc;
+}
+
 /*-------------------------------------------------------------------*/
 /* Initialize a CPU                                                  */
 /*-------------------------------------------------------------------*/
@@ -2402,6 +2434,13 @@ int i;
     regs->mainlim   = sysblk.mainsize - 1;
     regs->tod_epoch = get_tod_epoch();
 
+    /* Obtain the additional TLB ways if any (TLBWAYS) */
+    if (resize_tlb( regs, sysblk.tlbways ) != 0)
+    {
+        // "Processor %s%02X: error in function %s: %s"
+        WRMSG( HHC00813, "E", PTYPSTR( cpu ), cpu, "calloc()", strerror( errno ));
+    }
+
     /* Set initial CPU ID by REGS context.  Note that this
        must only be done AFTER regs->arch_mode has been set.
     */
@@ -2542,6 +2581,8 @@ static void *cpu_uninit (int cpu, REGS *regs)
 
     /* Free the REGS structure */
     FREE_TXFMAP( regs );
+    if (regs->tlbxway)
+        free_aligned( regs->tlbxway );
     free_aligned( regs );
 
     return NULL;
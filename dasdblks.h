@@ -513,7 +513,8 @@ DUT_DLL_IMPORT int valid_dsname( const char *pszdsname );
 
 DUT_DLL_IMPORT int ckd_tracklen( DEVBLK* dev, BYTE* buf );
 
-int cdsk_valid_trk( int trk, BYTE* buf, int heads, int len );
+int cdsk_valid_trk( int trk, BYTE* buf, int heads, int len,
+                    const BYTE* dict, int dictlen );
 
 #define DEFAULT_FBA_TYPE    0x3370
 
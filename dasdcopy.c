@@ -38,6 +38,7 @@
 int syntax( const char* pgm, const char* msgfmt, ... );
 void status (int, int);
 int nulltrk(BYTE *, int, int, int);
+int traindict(DEVBLK *, int, int, BYTE *);
 
 #define CKD      0x01
 #define CCKD     0x02
@@ -62,6 +63,7 @@ int             cyls=-1, blks=-1;       /* Size of output file       */
 int             lfs=0;                  /* 1=Create 1 large file     */
 int             alt=0;                  /* 1=Create alt cyls         */
 int             r=0;                    /* 1=Replace output file     */
+int             usedict=0;              /* 1=Train preset dictionary */
 int             in=0, out=0;            /* Input/Output file types   */
 int             fd;                     /* Input file descriptor     */
 char           *ifile, *ofile;          /* -> Input/Output file names*/
@@ -122,6 +124,18 @@ char            pathname[MAX_PATH];     /* file path in host format  */
 #ifdef CCKD_COMPRESS_BZIP2
         else if (strcmp(argv[0], "-bz2") == 0)
             comp = CCKD_COMPRESS_BZIP2;
+#endif
+#if defined( HAVE_ZLIB )
+        else if (strcmp(argv[0], "-dict") == 0)
+            usedict = 1;
+#endif
+#if defined( CCKD_ZSTD )
+        else if (strcmp(argv[0], "-zstd") == 0)
+            comp = CCKD_COMPRESS_ZSTD;
+#endif
+#if defined( CCKD_LZ4 )
+        else if (strcmp(argv[0], "-lz4") == 0)
+            comp = CCKD_COMPRESS_LZ4;
 #endif
         else if (strcmp(argv[0], "-0") == 0)
             comp = CCKD_COMPRESS_NONE;
@@ -295,6 +309,9 @@ char            pathname[MAX_PATH];     /* file path in host format  */
     if (lfs && (out & COMPMASK))          return syntax( pgm, "%s",
         "-lfs invalid if output is compressed" );
 
+    if (usedict && comp != CCKD_COMPRESS_ZLIB) return syntax( pgm, "%s",
+        "-dict requires zlib compression" );
+
     if (cyls >= 0 && (in & FBAMASK ))     return syntax( pgm, "%s",
         "-cyls invalid for fba input" );
 
@@ -413,6 +430,16 @@ char            pathname[MAX_PATH];     /* file path in host format  */
     }
     odev = &ocif->devblk;
 
+    /* Train and set the output file's preset dictionary */
+    if (usedict)
+    {
+        BYTE dict[CCKD_DICT_SIZE];
+        int  dictlen;
+
+        if ((dictlen = traindict (idev, ckddasd, n < max ? n : max, dict)) > 0)
+            cckd_set_dict (odev, dict, dictlen);
+    }
+
     /* Notify GUI of total #of tracks or blocks being copied... */
     EXTGUIMSG( "TRKS=%d\n", n );
 
@@ -603,6 +630,98 @@ BYTE           *pos;                    /* -> Next position in buffer*/
     return 0;
 }
 
+/*-------------------------------------------------------------------*/
+/* Train a preset compression dictionary from the input file         */
+/*-------------------------------------------------------------------*/
+#define DICT_SAMPLES      512           /* Max tracks/blkgrps sampled */
+#define DICT_SAMPLE_MAX   (8*1024*1024) /* Max bytes sampled          */
+
+int traindict (DEVBLK *idev, int ckddasd, int n, BYTE *dict)
+{
+BYTE           *samples;                /* Sample images             */
+int             lens[DICT_SAMPLES];     /* Sample image lengths      */
+int             nsamples = 0;           /* Number of samples         */
+int             total = 0;              /* Total sample bytes        */
+int             step;                   /* Sampling interval         */
+int             i, j, len;              /* Index, length             */
+BYTE           *p;                      /* -> image data             */
+BYTE            unitstat;               /* Unit status               */
+int             dictlen;                /* Dictionary length         */
+
+    if (!(samples = malloc (DICT_SAMPLE_MAX)))
+        return 0;
+
+    step = n > DICT_SAMPLES ? n / DICT_SAMPLES : 1;
+    for (i = 0; i < n && nsamples < DICT_SAMPLES; i += step)
+    {
+        if ((idev->hnd->read)(idev, i, &unitstat) < 0)
+            continue;
+
+        p = idev->buf + CKD_TRKHDR_SIZE;
+        if (ckddasd)
+        {
+            /* Null tracks are never written as images */
+            if ((len = ckd_tracklen (idev, idev->buf)) <= CKD_NULLTRK_SIZE0)
+                continue;
+            len -= CKD_TRKHDR_SIZE;
+        }
+        else
+        {
+            p = idev->buf;
+            len = idev->buflen;
+            for (j = 0; j < len && p[j] == 0; j++);
+            if (j == len)
+                continue;
+        }
+
+        if (total + len > DICT_SAMPLE_MAX)
+            break;
+        memcpy (samples + total, p, len);
+        lens[nsamples++] = len;
+        total += len;
+    }
+
+    dictlen = cckd_dict_train (dict, CCKD_DICT_SIZE, samples, lens, nsamples);
+    free (samples);
+
+    // "Preset dictionary of %d bytes trained from %d %ss"
+    WRMSG( HHC02596, "I", dictlen, nsamples, ckddasd ? "track" : "block group" );
+
+    return dictlen;
+}
+
+/*-------------------------------------------------------------------*/
+/* Append help for the optional compression algorithms               */
+/*-------------------------------------------------------------------*/
+#define DICT_HELP  "  -dict    zlib with a trained preset dictionary"
+#define ZSTD_HELP  "  -zstd    compress using zstd"
+#define LZ4_HELP   "  -lz4     compress using lz4"
+
+static void comphelp( char* buf, size_t bufsz, const char* id )
+{
+#if defined( HAVE_ZLIB ) || defined( CCKD_ZSTD ) || defined( CCKD_LZ4 )
+    char line[80];
+#endif
+
+#if defined( HAVE_ZLIB )
+    MSGBUF( line, "%s%s\n", id, DICT_HELP );
+    strlcat( buf, line, bufsz );
+#endif
+#if defined( CCKD_ZSTD )
+    MSGBUF( line, "%s%s\n", id, ZSTD_HELP );
+    strlcat( buf, line, bufsz );
+#endif
+#if defined( CCKD_LZ4 )
+    MSGBUF( line, "%s%s\n", id, LZ4_HELP );
+    strlcat( buf, line, bufsz );
+#endif
+#if !defined( HAVE_ZLIB ) && !defined( CCKD_ZSTD ) && !defined( CCKD_LZ4 )
+    UNREFERENCED( buf );
+    UNREFERENCED( bufsz );
+    UNREFERENCED( id );
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /* Display command syntax                                            */
 /*-------------------------------------------------------------------*/
@@ -613,7 +732,7 @@ int syntax( const char* pgm, const char* msgfmt, ... )
     int lfs   = 0;
 
     char zbuf  [80];
-    char bzbuf [80];
+    char bzbuf [320];
     char lfsbuf[80];
 
     zbuf  [0] = 0;
@@ -673,6 +792,7 @@ int syntax( const char* pgm, const char* msgfmt, ... )
     {
         if (zlib)  MSGBUF(  zbuf, "%s%s\n", HHC02435I,  Z_HELP );
         if (bzip2) MSGBUF( bzbuf, "%s%s\n", HHC02435I, BZ_HELP );
+        comphelp( bzbuf, sizeof( bzbuf ), HHC02435I );
         WRMSG(                              HHC02435, "I", zbuf, bzbuf );
     }
     else if (strcasecmp( pgm,             "cckd2ckd"     ) == 0)
@@ -684,6 +804,7 @@ int syntax( const char* pgm, const char* msgfmt, ... )
     {
         if (zlib)  MSGBUF(  zbuf, "%s%s\n", HHC02437I,  Z_HELP );
         if (bzip2) MSGBUF( bzbuf, "%s%s\n", HHC02437I, BZ_HELP );
+        comphelp( bzbuf, sizeof( bzbuf ), HHC02437I );
         WRMSG(                              HHC02437, "I", zbuf, bzbuf );
     }
     else if (strcasecmp( pgm,             "cfba2fba"     ) == 0)
@@ -695,6 +816,7 @@ int syntax( const char* pgm, const char* msgfmt, ... )
     {
         if (zlib)  MSGBUF(   zbuf, "%s%s\n", HHC02439I,   Z_HELP );
         if (bzip2) MSGBUF(  bzbuf, "%s%s\n", HHC02439I,  BZ_HELP );
+        comphelp( bzbuf, sizeof( bzbuf ), HHC02439I );
         if (lfs)   MSGBUF( lfsbuf, "%s%s\n", HHC02439I, LFS_HELP );
         WRMSG(                               HHC02439, "I", pgm, zbuf, bzbuf, lfsbuf,
             "CKD, CCKD, FBA, CFBA" );
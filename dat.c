@@ -1069,6 +1069,9 @@ U16     rfx, rsx, rtx;                  /* Region first/second/third
                                            index + 3 low-order zeros */
 U16     sx, px;                         /* Segment and page index,
                                            + 3 low-order zero bits   */
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+int     ltlbix = LTLBIX( vaddr );       /* Large frame TLB index     */
+#endif
 
     regs->dat.pvtaddr = regs->dat.protect = 0;
 
@@ -1093,6 +1096,21 @@ U16     sx, px;                         /* Segment and page index,
     }
     else
     {
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+        /* Look up the address in the large frame TLB, and if found
+           construct a fake 4K page table entry for the 4K TLB */
+        if (   ((vaddr & LTLB_PAGEMASK) | regs->tlbID) == regs->tlb.lvaddr[ltlbix]
+            && ((regs->tlb.lste[ltlbix] & ZSEGTAB_C) || regs->dat.asd == regs->tlb.lasd[ltlbix])
+            && !((regs->tlb.lste[ltlbix] & ZSEGTAB_C) && regs->dat.pvtaddr)
+            && !(acctype & ACC_NOTLB) )
+        {
+            ste = regs->tlb.lste[ltlbix];
+            pte = ((ste & ZSEGTAB_SFAA) | (vaddr & ~ZSEGTAB_SFAA)) & PAGEFRAME_PAGEMASK;
+            regs->dat.protect = regs->tlb.lprotect[ltlbix];
+            regs->tlblhits++;
+        }
+        else
+#endif /* defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 ) */
         /* If ASCE indicates a real-space then real addr = virtual addr */
         if (regs->dat.asd & ASCE_R)
         {
@@ -1382,6 +1400,12 @@ U16     sx, px;                         /* Segment and page index,
                     regs->tlb.protect[tlbix]   = regs->dat.protect;
                     regs->tlb.acc[tlbix]       = 0;
                     regs->tlb.main[tlbix]      = NULL;
+
+                    /* Also remember the whole frame in the large TLB */
+                    regs->tlb.lasd[ltlbix]     = regs->dat.asd;
+                    regs->tlb.lvaddr[ltlbix]   = (vaddr & LTLB_PAGEMASK) | regs->tlbID;
+                    regs->tlb.lste[ltlbix]     = ste;
+                    regs->tlb.lprotect[ltlbix] = regs->dat.protect;
                 }
 
                 /* Clear exception code and return with zero return code */
@@ -1682,7 +1706,8 @@ tran_excp_addr:
 /*-------------------------------------------------------------------*/
 void ARCH_DEP( purge_tlbe )( REGS* regs, RADR pfra )
 {
-int  i;
+int  i, w;
+TLB* tlb;
 RADR pte;
 RADR ptemask;
 
@@ -1704,9 +1729,20 @@ RADR ptemask;
 
     INVALIDATE_AIA(regs);
 
-    for (i = 0; i < TLBN; i++)
-        if ((regs->tlb.TLB_PTE(i) & ptemask) == pte)
-            regs->tlb.TLB_VADDR(i) &= TLBID_PAGEMASK;
+    for (w = 0; w < regs->tlbways; w++)
+    {
+        tlb = TLB_WAY( regs, w );
+        for (i = 0; i < TLBN; i++)
+            if ((tlb->TLB_PTE(i) & ptemask) == pte)
+                tlb->TLB_VADDR(i) &= TLBID_PAGEMASK;
+    }
+
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+    /* Also purge any large frame entry containing the page frame */
+    for (i = 0; i < LTLBN; i++)
+        if ((regs->tlb.lste[i] & ZSEGTAB_SFAA) == (pfra & ZSEGTAB_SFAA))
+            regs->tlb.lvaddr[i] &= LTLB_PAGEMASK;
+#endif
 
 #if defined( _FEATURE_SIE )
     /* Also clear the guest registers in the SIE copy */
@@ -1729,20 +1765,48 @@ RADR ptemask;
         /* but is now expanded with the additional test as below.    */
         /*                                                           */
         /*                         (Peter J. Jansen, 29-Jul-2016)    */
+        /*                                                           */
+        /* With TLBWAYS the host entry may be in any way of the set. */
         /*************************************************************/
 
-        for (i = 0; i < TLBN; i++)
-            if ((GUESTREGS->tlb.TLB_PTE(i) & ptemask) == pte ||
-                 (HOSTREGS->tlb.TLB_PTE(i) & ptemask) == pte)
-                GUESTREGS->tlb.TLB_VADDR(i) &= TLBID_PAGEMASK;
+        for (w = 0; w < GUESTREGS->tlbways; w++)
+        {
+            tlb = TLB_WAY( GUESTREGS, w );
+            for (i = 0; i < TLBN; i++)
+            {
+                int  hw, hit = (tlb->TLB_PTE(i) & ptemask) == pte;
+
+                for (hw = 0; !hit && hw < HOSTREGS->tlbways; hw++)
+                    hit = (TLB_WAY( HOSTREGS, hw )->TLB_PTE(i) & ptemask) == pte;
+
+                if (hit)
+                    tlb->TLB_VADDR(i) &= TLBID_PAGEMASK;
+            }
+        }
+
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+        for (i = 0; i < LTLBN; i++)
+            if ((GUESTREGS->tlb.lste[i] & ZSEGTAB_SFAA) == (pfra & ZSEGTAB_SFAA))
+                GUESTREGS->tlb.lvaddr[i] &= LTLB_PAGEMASK;
+#endif
     }
     else if (regs->guest)  /* For guests, clear any host entries */
     {
         INVALIDATE_AIA(HOSTREGS);
 
-        for (i = 0; i < TLBN; i++)
-            if ((HOSTREGS->tlb.TLB_PTE(i) & ptemask) == pte)
-                HOSTREGS->tlb.TLB_VADDR(i) &= TLBID_PAGEMASK;
+        for (w = 0; w < HOSTREGS->tlbways; w++)
+        {
+            tlb = TLB_WAY( HOSTREGS, w );
+            for (i = 0; i < TLBN; i++)
+                if ((tlb->TLB_PTE(i) & ptemask) == pte)
+                    tlb->TLB_VADDR(i) &= TLBID_PAGEMASK;
+        }
+
+#if defined( FEATURE_008_ENHANCED_DAT_FACILITY_1 )
+        for (i = 0; i < LTLBN; i++)
+            if ((HOSTREGS->tlb.lste[i] & ZSEGTAB_SFAA) == (pfra & ZSEGTAB_SFAA))
+                HOSTREGS->tlb.lvaddr[i] &= LTLB_PAGEMASK;
+#endif
     }
 #endif /* defined( _FEATURE_SIE ) */
 
@@ -1754,39 +1818,52 @@ RADR ptemask;
 /*-------------------------------------------------------------------*/
 void ARCH_DEP( invalidate_tlb )( REGS* regs, BYTE mask )
 {
-int  i;
+int  i, w;
+TLB* tlb;
 
     INVALIDATE_AIA(regs);
-    if (mask == 0)
-        memset(&regs->tlb.acc, 0, TLBN);
-    else
-        for (i = 0; i < TLBN; i++)
-            if ((regs->tlb.TLB_VADDR(i) & TLBID_BYTEMASK) == regs->tlbID)
-                regs->tlb.acc[i] &= mask;
+    for (w = 0; w < regs->tlbways; w++)
+    {
+        tlb = TLB_WAY( regs, w );
+        if (mask == 0)
+            memset(&tlb->acc, 0, TLBN);
+        else
+            for (i = 0; i < TLBN; i++)
+                if ((tlb->TLB_VADDR(i) & TLBID_BYTEMASK) == regs->tlbID)
+                    tlb->acc[i] &= mask;
+    }
 
 #if defined( _FEATURE_SIE )
     /* Also invalidate the guest registers in the SIE copy */
     if(regs->host && GUESTREGS)
     {
         INVALIDATE_AIA(GUESTREGS);
-        if (mask == 0)
-            memset(&GUESTREGS->tlb.acc, 0, TLBN);
-        else
-            for (i = 0; i < TLBN; i++)
-                if ((GUESTREGS->tlb.TLB_VADDR(i) & TLBID_BYTEMASK) == GUESTREGS->tlbID)
-                    GUESTREGS->tlb.acc[i] &= mask;
+        for (w = 0; w < GUESTREGS->tlbways; w++)
+        {
+            tlb = TLB_WAY( GUESTREGS, w );
+            if (mask == 0)
+                memset(&tlb->acc, 0, TLBN);
+            else
+                for (i = 0; i < TLBN; i++)
+                    if ((tlb->TLB_VADDR(i) & TLBID_BYTEMASK) == GUESTREGS->tlbID)
+                        tlb->acc[i] &= mask;
+        }
     }
     else
     /* Also invalidate the guest registers in the SIE copy */
     if(regs->guest)
     {
         INVALIDATE_AIA(HOSTREGS);
-        if (mask == 0)
-            memset(&HOSTREGS->tlb.acc, 0, TLBN);
-        else
-            for (i = 0; i < TLBN; i++)
-                if ((HOSTREGS->tlb.TLB_VADDR(i) & TLBID_BYTEMASK) == HOSTREGS->tlbID)
-                    HOSTREGS->tlb.acc[i] &= mask;
+        for (w = 0; w < HOSTREGS->tlbways; w++)
+        {
+            tlb = TLB_WAY( HOSTREGS, w );
+            if (mask == 0)
+                memset(&tlb->acc, 0, TLBN);
+            else
+                for (i = 0; i < TLBN; i++)
+                    if ((tlb->TLB_VADDR(i) & TLBID_BYTEMASK) == HOSTREGS->tlbID)
+                        tlb->acc[i] &= mask;
+        }
     }
 
 #endif /* defined( _FEATURE_SIE ) */
@@ -1819,7 +1896,12 @@ int  i;
 /*-------------------------------------------------------------------*/
 void ARCH_DEP( invalidate_tlbe )( REGS* regs, BYTE* main )
 {
-    int     i;                          /* index into TLB            */
+    int     i;                          /* index into TLB way        */
+    int     w;                          /* TLB way                   */
+#if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    int     j;                          /* TLB way                   */
+#endif
+    TLB     *tlb;                       /* -> TLB way                */
     int     shift;                      /* Number of bits to shift   */
     BYTE    *mainwid;                   /* mainstore with tlbid      */
 
@@ -1833,17 +1915,23 @@ void ARCH_DEP( invalidate_tlbe )( REGS* regs, BYTE* main )
 
     INVALIDATE_AIA_MAIN(regs, main);
     shift = regs->arch_mode == ARCH_370_IDX ? 11 : 12;
-    for (i = 0; i < TLBN; i++)
-        if (MAINADDR(regs->tlb.main[i],
-                     (regs->tlb.TLB_VADDR(i) | (i << shift)))
-                     == mainwid)
-        {
-            regs->tlb.acc[i] = 0;
+    for (w = 0; w < regs->tlbways; w++)
+    {
+        tlb = TLB_WAY( regs, w );
+        for (i = 0; i < TLBN; i++)
+            if (MAINADDR(tlb->main[i],
+                         (tlb->TLB_VADDR(i) | (i << shift)))
+                         == mainwid)
+            {
+                tlb->acc[i] = 0;
 #if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
-            if ((regs->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
-                regs->tlb.acc[i^1] = 0;
+                if ((regs->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
+                    /* (the other half may be in any way of its set) */
+                    for (j = 0; j < regs->tlbways; j++)
+                        TLB_WAY( regs, j )->acc[i^1] = 0;
 #endif
-        }
+            }
+    }
 
 #if defined( _FEATURE_SIE )
     /* Also clear the guest registers in the SIE copy */
@@ -1851,17 +1939,23 @@ void ARCH_DEP( invalidate_tlbe )( REGS* regs, BYTE* main )
     {
         INVALIDATE_AIA_MAIN(GUESTREGS, main);
         shift = GUESTREGS->arch_mode == ARCH_370_IDX ? 11 : 12;
-        for (i = 0; i < TLBN; i++)
-            if (MAINADDR(GUESTREGS->tlb.main[i],
-                         (GUESTREGS->tlb.TLB_VADDR(i) | (i << shift)))
-                         == mainwid)
-            {
-                GUESTREGS->tlb.acc[i] = 0;
+        for (w = 0; w < GUESTREGS->tlbways; w++)
+        {
+            tlb = TLB_WAY( GUESTREGS, w );
+            for (i = 0; i < TLBN; i++)
+                if (MAINADDR(tlb->main[i],
+                             (tlb->TLB_VADDR(i) | (i << shift)))
+                             == mainwid)
+                {
+                    tlb->acc[i] = 0;
 #if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
-                if ((GUESTREGS->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
-                    GUESTREGS->tlb.acc[i^1] = 0;
+                    if ((GUESTREGS->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
+                        /* (the other half may be in any way of its set) */
+                        for (j = 0; j < GUESTREGS->tlbways; j++)
+                            TLB_WAY( GUESTREGS, j )->acc[i^1] = 0;
 #endif
-            }
+                }
+        }
     }
 
     /* Also clear the host registers in the SIE copy */
@@ -1869,17 +1963,23 @@ void ARCH_DEP( invalidate_tlbe )( REGS* regs, BYTE* main )
     {
         INVALIDATE_AIA_MAIN(HOSTREGS, main);
         shift = HOSTREGS->arch_mode == ARCH_370_IDX ? 11 : 12;
-        for (i = 0; i < TLBN; i++)
-            if (MAINADDR(HOSTREGS->tlb.main[i],
-                         (HOSTREGS->tlb.TLB_VADDR(i) | (i << shift)))
-                         == mainwid)
-            {
-                HOSTREGS->tlb.acc[i] = 0;
+        for (w = 0; w < HOSTREGS->tlbways; w++)
+        {
+            tlb = TLB_WAY( HOSTREGS, w );
+            for (i = 0; i < TLBN; i++)
+                if (MAINADDR(tlb->main[i],
+                             (tlb->TLB_VADDR(i) | (i << shift)))
+                             == mainwid)
+                {
+                    tlb->acc[i] = 0;
 #if !defined( FEATURE_S390_DAT ) && !defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
-                if ((HOSTREGS->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
-                    HOSTREGS->tlb.acc[i^1] = 0;
+                    if ((HOSTREGS->CR(0) & CR0_PAGE_SIZE) == CR0_PAGE_SZ_4K)
+                        /* (the other half may be in any way of its set) */
+                        for (j = 0; j < HOSTREGS->tlbways; j++)
+                            TLB_WAY( HOSTREGS, j )->acc[i^1] = 0;
 #endif
-            }
+                }
+        }
     }
 
 #endif /* defined( _FEATURE_SIE ) */
@@ -2042,6 +2142,120 @@ static inline int ARCH_DEP( check_sa_per2 )( int arn, int acctype, REGS* regs )
 #endif /* defined( FEATURE_PER2 ) */
 
 
+/*-------------------------------------------------------------------*/
+/* Exchange the entries of a TLB set in two different ways           */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( tlb_swap )( TLB* a, TLB* b, int ix )
+{
+    DW     dw;
+    BYTE*  p;
+    BYTE   c;
+
+    dw = a->asd    [ix];  a->asd    [ix] = b->asd    [ix];  b->asd    [ix] = dw;
+    dw = a->vaddr  [ix];  a->vaddr  [ix] = b->vaddr  [ix];  b->vaddr  [ix] = dw;
+    dw = a->pte    [ix];  a->pte    [ix] = b->pte    [ix];  b->pte    [ix] = dw;
+    p  = a->main   [ix];  a->main   [ix] = b->main   [ix];  b->main   [ix] = p;
+    p  = a->storkey[ix];  a->storkey[ix] = b->storkey[ix];  b->storkey[ix] = p;
+    c  = a->skey   [ix];  a->skey   [ix] = b->skey   [ix];  b->skey   [ix] = c;
+    c  = a->common [ix];  a->common [ix] = b->common [ix];  b->common [ix] = c;
+    c  = a->protect[ix];  a->protect[ix] = b->protect[ix];  b->protect[ix] = c;
+    c  = a->acc    [ix];  a->acc    [ix] = b->acc    [ix];  b->acc    [ix] = c;
+}
+
+
+/*-------------------------------------------------------------------*/
+/* Select the TLB way to be used for a logical address               */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/* Called by logical_to_main_l before it translates an address, to   */
+/* ensure that way 0 of the address's TLB set, which is the only way */
+/* that maddr_l and translate_addr look at and that translate_addr   */
+/* and logical_to_main_l update, is the right entry:                 */
+/*                                                                   */
+/*   - If way 0 already holds the page, nothing needs to be done.    */
+/*                                                                   */
+/*   - If another way holds the page, that entry becomes way 0 and   */
+/*     those in front of it each move down one way.                  */
+/*                                                                   */
+/*   - Otherwise every entry moves down one way and the entry in     */
+/*     the last (least recently used) way, which is thus evicted,    */
+/*     moves to way 0 to be replaced by the new translation.         */
+/*                                                                   */
+/* Access register mode accesses never use the accelerated lookup    */
+/* and are left to translate_addr as before.                         */
+/*                                                                   */
+/* maddr_l does not count its own hits, so as to keep its inline     */
+/* lookup as short as it was.  The statistics are instead those of   */
+/* the lookups that missed way 0: a hit is an entry in another way   */
+/* which maddr_l would itself have used for the access (the same     */
+/* checks, including access type and key), and anything else is      */
+/* a miss which needs a new translation.  A direct-mapped TLB (one   */
+/* way) returns straight away after counting the miss, so that the   */
+/* default setting costs no more than a counter; its evictions are   */
+/* not counted.                                                      */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+static void ARCH_DEP( tlb_select_way )( REGS* regs, VADR addr, int arn,
+                                        int acctype, BYTE akey )
+{
+    int   ix      = TLBIX( addr );
+    int   aea_crn = (arn >= USE_ARMODE) ? 0 : regs->AEA_AR( arn );
+    int   ways    = regs->tlbways;
+    TLB*  tlb     = NULL;
+    int   w;
+
+    if (!aea_crn)
+        return;
+
+    /* A direct-mapped TLB has nothing to search or move */
+    if (ways == 1)
+    {
+        regs->tlbmisses++;
+        return;
+    }
+
+    /* Search the ways of the set for this page */
+    for (w=0; w < ways; w++)
+    {
+        tlb = TLB_WAY( regs, w );
+
+        if (1
+            && ((addr & TLBID_PAGEMASK) | regs->tlbID) == tlb->TLB_VADDR( ix )
+            && (0
+                || regs->CR( aea_crn ) == tlb->TLB_ASD( ix )
+                || (regs->AEA_COMMON( aea_crn ) & tlb->common[ ix ])
+               )
+        )
+            break;
+    }
+
+    if (w < ways)
+    {
+        if (1
+            && w > 0
+            && (acctype & tlb->acc[ ix ])
+            && (akey == 0 || akey == tlb->skey[ ix ])
+        )
+            regs->tlbhits++;
+        else
+            regs->tlbmisses++;
+    }
+    else
+    {
+        regs->tlbmisses++;
+
+        if ((tlb->TLB_VADDR( ix ) & TLBID_BYTEMASK) == regs->tlbID)
+            regs->tlbevicts++;
+
+        w = ways - 1;
+    }
+
+    /* Move the selected entry to way 0 */
+    for (; w > 0; w--)
+        ARCH_DEP( tlb_swap )( TLB_WAY( regs, w ), TLB_WAY( regs, w - 1 ), ix );
+}
+
+
 /*-------------------------------------------------------------------*/
 /* Convert logical address to absolute address and check protection  */
 /*                                                                   */
@@ -2085,6 +2299,9 @@ RADR    aaddr;                          /* Absolute address          */
 RADR    apfra;                          /* Abs page frame address    */
 int     ix = TLBIX(addr);               /* TLB index                 */
 
+    /* Make way 0 of the TLB set the entry to be used or replaced */
+    ARCH_DEP( tlb_select_way )( regs, addr, arn, acctype, akey );
+
     /* Convert logical address to real address */
     if ( (REAL_MODE(&regs->psw) || arn == USE_REAL_ADDR)
 #if defined( FEATURE_SIE )
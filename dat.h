@@ -71,7 +71,7 @@ inline void ARCH_DEP( purge_tlb )( REGS* regs )
 
     if (((++regs->tlbID) & TLBID_BYTEMASK) == 0)
     {
-        memset( &regs->tlb.vaddr, 0, TLBN * sizeof( DW ));
+        CLEAR_TLB_WAYS( regs );
         regs->tlbID = 1;
     }
 
@@ -83,7 +83,7 @@ inline void ARCH_DEP( purge_tlb )( REGS* regs )
 
         if (((++GUESTREGS->tlbID) & TLBID_BYTEMASK) == 0)
         {
-            memset( &GUESTREGS->tlb.vaddr, 0, TLBN * sizeof( DW ));
+            CLEAR_TLB_WAYS( GUESTREGS );
             GUESTREGS->tlbID = 1;
         }
     }
@@ -391,6 +391,13 @@ inline BYTE* ARCH_DEP( maddr_l )
     if (!maddr)
         maddr = ARCH_DEP( logical_to_main_l )( addr, arn, regs, acctype, akey, len );
 
+    /* Storage may be about to be changed: tell suspend/resume so that
+       an incremental suspend knows the frame must be written again. */
+    if (acctype & (ACC_WRITE | ACC_CHECK))
+    {
+        SR_STORE_MAIN( maddr );
+    }
+
 #if defined( FEATURE_073_TRANSACT_EXEC_FACILITY )
     if (FACILITY_ENABLED( 073_TRANSACT_EXEC, regs ))
     {
@@ -216,10 +216,29 @@ typedef struct PSW  PSW;
 /*      main, storkey, skey, read and write,                         */
 /*      and are used for accelerated address lookup (formerly AEA).  */
 /*                                                                   */
+/*  The TLB is TLB_SETS x TLBWAYS set-associative (TLBWAYS panel     */
+/*  command).  Each way is one of these structures, of which entry   */
+/*  n is set n.  Way 0 is REGS.tlb and holds the most recently used  */
+/*  entry of each set; the other ways in use are allocated for each  */
+/*  CPU by resize_tlb (see TLB_WAY) so that REGS does not grow with  */
+/*  the number of ways.  maddr_l only ever looks at way 0; on a miss */
+/*  the other ways are searched by logical_to_main_l (see            */
+/*  tlb_select_way).                                                 */
+/*                                                                   */
+/*  The l-prefixed fields are a separate small direct-mapped TLB of   */
+/*  EDAT-1 large (1M segment) frame translations, which translate_addr */
+/*  consults on a TLB miss before walking the DAT tables, so that a   */
+/*  miss anywhere within such a segment only costs a 4K TLB refill.   */
+/*                                                                   */
 /*-------------------------------------------------------------------*/
 
-#define TLBN            1024            /* Number TLB entries        */
-#define TLB_MASK        0x3FF           /* Mask for 1024 entries     */
+#define TLB_SETS        1024            /* Number TLB sets           */
+#define TLB_MASK        0x3FF           /* Mask for 1024 sets        */
+#define TLB_MAXWAYS     4               /* Maximum TLBWAYS value     */
+#define TLBN            TLB_SETS        /* Number TLB entries (way)  */
+#define LTLBN           64              /* Number large frame entries*/
+#define LTLB_MASK       0x3F            /* Mask for 64 entries       */
+#define LTLB_PAGEMASK   0xFFFFFFFFFC000000ULL /* lvaddr address bits */
 #define TLB_REAL_ASD_L  0xFFFFFFFF      /* ASD values for real mode  */
 #define TLB_REAL_ASD_G  0xFFFFFFFFFFFFFFFFULL
 #define TLB_HOST_ASD    0x800           /* Host entry for XC guest   */
@@ -246,9 +265,21 @@ struct  TLB {
     BYTE                common[TLBN];   /* 1=Page in common segment  */
     BYTE                protect[TLBN];  /* 1=Page in protected segmnt*/
     BYTE                acc[TLBN];      /* Access type flags         */
+
+    U64                 lasd[LTLBN];    /* Address space designator  */
+    U64                 lvaddr[LTLBN];  /* Virtual large frame addr  */
+    U64                 lste[LTLBN];    /* Segment table entry       */
+    BYTE                lprotect[LTLBN];/* 1=Frame is protected      */
 };
 typedef struct TLB  TLB;
 
+/* Invalidate all TLB entries regardless of their tlbID */
+#define CLEAR_TLB( _tlb )                                             \
+    do {                                                              \
+        memset( &(_tlb)->vaddr,  0, TLBN  * sizeof( DW ));            \
+        memset( &(_tlb)->lvaddr, 0, LTLBN * sizeof( U64 ));           \
+    } while (0)
+
 /*-------------------------------------------------------------------*/
 /*   Structure definition for DAT (Dynamic Address Translation)      */
 /*-------------------------------------------------------------------*/
@@ -6398,9 +6398,12 @@ int     m3;                             /* Mask                      */
 VADR    addr1, addr2, trtab;            /* Effective addresses       */
 GREG    len;
 BYTE    svalue, dvalue, tvalue;
-#ifdef FEATURE_024_ETF2_ENHANCEMENT_FACILITY
-bool    tccc;                   /* Test-Character-Comparison Control */
+BYTE   *src, *dst, *tab;                /* Mainstor addresses        */
+U32     i, k, n;                        /* Chunk lengths             */
+#if defined( HAVE_HOST_VEC_SCAN )
+BYTE    hit[256];                       /* Test value function bytes */
 #endif
+bool    tccc = false;           /* Test-Character-Comparison Control */
 
     RRF_M(inst, regs, r1, r2, m3);
 
@@ -6411,8 +6414,6 @@ bool    tccc;                   /* Test-Character-Comparison Control */
     /* Set Test-Character-Comparison Control */
     if (m3 & 0x01)
       tccc = true;
-    else
-      tccc = false;
 #endif
 
     /* Determine length */
@@ -6430,6 +6431,87 @@ bool    tccc;                   /* Test-Character-Comparison Control */
     if(!len)
         regs->psw.cc = 0;
 
+    /* Usual case: the table is within a single page. Translate up
+       to the first page boundary of either operand, which is where
+       the byte loop below would end the operation anyway */
+    if(len && NOCROSSPAGE(trtab, 256-1))
+    {
+        n = PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK);
+        n = MIN(n, PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK));
+        if(len < n) n = (U32) len;
+
+        ITIMER_SYNC(addr2, n-1, regs);
+        src = MADDRL(addr2, n, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+        tab = MADDRL(trtab, 256, 1, regs, ACCTYPE_READ, regs->psw.pkey);
+
+        /* The first operand is not accessed if the very first
+           translated byte is the test value */
+        if(!tccc && tab[src[0]] == tvalue)
+            k = 0;
+        else
+        {
+            dst = MADDRL(addr1, n, r1, regs, ACCTYPE_WRITE, regs->psw.pkey);
+
+            if((dst + n <= src || src + n <= dst || dst == src)
+             && (dst + n <= tab || tab + 256 <= dst))
+            {
+                /* Find the test value first, then translate the
+                   bytes before it as a block */
+                if(tccc)
+                    k = n;
+                else
+                {
+#if defined( HAVE_HOST_VEC_SCAN )
+                    for(i = 0; i < 256; i++)
+                        hit[i] = (tab[i] == tvalue);
+                    k = (U32) host_vec_trt(src, (int) n, hit);
+#else
+                    for(k = 0; k < n; k++)
+                        if(tab[src[k]] == tvalue)
+                            break;
+#endif
+                }
+                memmove(dst, src, k);
+#if defined( HAVE_HOST_VEC_SCAN )
+                host_vec_tr(dst, (int) k, tab);
+#else
+                for(i = 0; i < k; i++)
+                    dst[i] = tab[dst[i]];
+#endif
+            }
+            else
+            {
+                /* Overlapping operands see the bytes already stored */
+                for(k = 0; k < n; k++)
+                {
+                    dvalue = tab[src[k]];
+                    if(!tccc && dvalue == tvalue)
+                        break;
+                    dst[k] = dvalue;
+                }
+            }
+            if(k)
+            {
+                ITIMER_UPDATE(addr1, k-1, regs);
+            }
+        }
+
+        /* Adjust source addr, destination addr and length */
+        addr1 += k; addr1 &= ADDRESS_MAXWRAP(regs);
+        addr2 += k; addr2 &= ADDRESS_MAXWRAP(regs);
+        len -= k;
+
+        /* Update the registers */
+        SET_GR_A(r1, regs, addr1);
+        SET_GR_A(r1 + 1, regs, len);
+        SET_GR_A(r2, regs, addr2);
+
+        /* Exit with cc1 if the test value was found, otherwise with
+           cc3 at the cpu determined number of bytes or cc0 when done */
+        regs->psw.cc = k < n ? 1 : len ? 3 : 0;
+        return;
+    }
+
     while(len)
     {
         svalue = ARCH_DEP(vfetchb) (addr2, r2, regs);
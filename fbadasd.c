@@ -58,6 +58,55 @@ DISABLE_GCC_UNUSED_SET_WARNING;
 
 static int fba_read (DEVBLK *dev, BYTE *buf, int len, BYTE *unitstat);
 
+/*-------------------------------------------------------------------*/
+/* Map the FBA image file into storage                               */
+/*                                                                   */
+/* Block groups are then read in place rather than being copied      */
+/* into a cache buffer; updates are made to a copy which is written  */
+/* back with write() as before.                                      */
+/*-------------------------------------------------------------------*/
+static void fba_dasd_mmap (DEVBLK *dev)
+{
+#if !defined( _MSVC_ )
+struct stat     statbuf;                /* File information          */
+void           *p;                      /* -> Mapped file            */
+
+    /* Pages of a mapping beyond the end of the file cannot be read,
+       so a file shorter than the device (a block device, for one,
+       whose st_size is 0) is read normally */
+    if (fstat (dev->fd, &statbuf) < 0)
+        p = MAP_FAILED;
+    else if ((U64)statbuf.st_size < (U64)dev->fbaend)
+    {
+        // "%1d:%04X FBA file %s: mmap not used: %s"
+        WRMSG( HHC00522, "W", LCSS_DEVNUM,
+               dev->filename, "file is shorter than the device" );
+        return;
+    }
+    else if (dev->fbaend > (U64)SIZE_MAX)
+    {
+        errno = EFBIG;
+        p = MAP_FAILED;
+    }
+    else
+        p = mmap (NULL, (size_t)dev->fbaend, PROT_READ,
+                  MAP_SHARED, dev->fd, 0);
+    if (p == MAP_FAILED)
+    {
+        // "%1d:%04X FBA file %s: mmap not used: %s"
+        WRMSG( HHC00522, "W", LCSS_DEVNUM,
+               dev->filename, strerror( errno ));
+        return;
+    }
+    dev->dasdmap[0] = p;
+    dev->dasdmapsz[0] = (size_t)dev->fbaend;
+#else
+    // "%1d:%04X FBA file %s: mmap not used: %s"
+    WRMSG( HHC00522, "W", LCSS_DEVNUM,
+           dev->filename, "not supported on this platform" );
+#endif
+} /* end function fba_dasd_mmap */
+
 /*-------------------------------------------------------------------*/
 /* Initialize the device handler                                     */
 /*-------------------------------------------------------------------*/
@@ -71,6 +120,8 @@ BYTE    c;                              /* Character work area       */
 char   *cu = NULL;                      /* Specified control unit    */
 int     cfba = 0;                       /* 1 = Compressed fba        */
 int     i;                              /* Loop index                */
+int     npos;                           /* Positional argument count */
+char   *pos[3];                         /* Positional arguments      */
 CKD_DEVHDR      devhdr;                 /* Device header             */
 CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
 
@@ -83,6 +134,7 @@ CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
 
     /* reset excps count */
     dev->excps = 0;
+    dev->dasdmmap = 0;
 
     /* The first argument is the file name */
     if (argc == 0 || strlen(argv[0]) >= sizeof(dev->filename))
@@ -192,11 +244,25 @@ CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
                 cu = argv[i]+3;
                 continue;
             }
+            if (strcasecmp ("mmap", argv[i]) == 0)
+            {
+                dev->dasdmmap = 1;
+                continue;
+            }
 
             // "%1d:%04X FBA file: parameter %s in argument %d is invalid"
             WRMSG( HHC00503, "E", LCSS_DEVNUM, argv[i], i + 1 );
             return -1;
         }
+
+        /* Compressed images are always read through the cache */
+        if (dev->dasdmmap)
+        {
+            // "%1d:%04X FBA file %s: mmap not used: %s"
+            WRMSG( HHC00522, "W", LCSS_DEVNUM,
+                   dev->filename, "compressed image" );
+            dev->dasdmmap = 0;
+        }
     }
 
     /* Processing for compressed fba64 dasd */
@@ -213,6 +279,16 @@ CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
     {
         dev->cckd64 = 0;
 
+        /* The mmap keyword, which requests the file be mapped, may
+           be given anywhere; the other arguments are positional */
+        for (i = 1, npos = 1; i < argc; i++)
+        {
+            if (strcasecmp ("mmap", argv[i]) == 0)
+                dev->dasdmmap = 1;
+            else if (npos < 3)
+                pos[npos++] = argv[i];
+        }
+
         /* Determine the device size */
         rc = fstat (dev->fd, &statbuf);
         if (rc < 0)
@@ -254,13 +330,13 @@ CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
         }
 
         /* The second argument is the device origin block number */
-        if (argc >= 2)
+        if (npos >= 2)
         {
-            if (sscanf(argv[1], "%u%c", &startblk, &c) != 1
+            if (sscanf(pos[1], "%u%c", &startblk, &c) != 1
              || startblk >= dev->fbanumblk)
             {
                 // "%1d:%04X FBA file %s: invalid device origin block number %s"
-                WRMSG( HHC00505, "E", LCSS_DEVNUM, dev->filename, argv[1] );
+                WRMSG( HHC00505, "E", LCSS_DEVNUM, dev->filename, pos[1] );
                 close (dev->fd);
                 dev->fd = -1;
                 return -1;
@@ -270,13 +346,13 @@ CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
         }
 
         /* The third argument is the device block count */
-        if (argc >= 3 && strcmp(argv[2],"*") != 0)
+        if (npos >= 3 && strcmp(pos[2],"*") != 0)
         {
-            if (sscanf(argv[2], "%u%c", &numblks, &c) != 1
+            if (sscanf(pos[2], "%u%c", &numblks, &c) != 1
              || numblks > dev->fbanumblk)
             {
                 // "%1d:%04X FBA file %s: invalid device block count %s"
-                WRMSG( HHC00506, "E", LCSS_DEVNUM, dev->filename, argv[2] );
+                WRMSG( HHC00506, "E", LCSS_DEVNUM, dev->filename, pos[2] );
                 close (dev->fd);
                 dev->fd = -1;
                 return -1;
@@ -323,6 +399,10 @@ CCKD_DEVHDR     cdevhdr;                /* Compressed device header  */
     if (cfba)
         return cckd_dasd_init_handler (dev, argc, argv);
 
+    /* Map the image file if requested */
+    if (dev->dasdmmap)
+        fba_dasd_mmap (dev);
+
     return 0;
 } /* end function fba_dasd_init_handler */
 
@@ -506,6 +586,7 @@ int fba_dasd_read_blkgrp (DEVBLK *dev, int blkgrp, BYTE *unitstat)
 int             rc;                     /* Return code               */
 int             i, o;                   /* Cache indexes             */
 int             len;                    /* Length to read            */
+int             prevgrp;                /* Previous block group      */
 off_t           offset;                 /* File offsets              */
 
     /* Return if reading the same block group */
@@ -563,6 +644,7 @@ off_t           offset;                 /* File offsets              */
     /* Make the previous cache entry inactive */
     if (dev->cache >= 0)
         cache_setflag(CACHE_DEVBUF, dev->cache, ~FBA_CACHE_ACTIVE, 0);
+    prevgrp = dev->bufcur;
     dev->bufcur = dev->cache = -1;
 
     /* Return on special case when called by the close handler */
@@ -572,6 +654,19 @@ off_t           offset;                 /* File offsets              */
         return 0;
     }
 
+    /* Use the block group in place if the image file is mapped */
+    if (dev->dasdmap[0])
+    {
+        cache_unlock (CACHE_DEVBUF);
+        dev->buf = dev->dasdmap[0] + (size_t)blkgrp * CFBA_BLKGRP_SIZE;
+        dev->bufcur = blkgrp;
+        dev->bufoff = 0;
+        dev->bufoffhi = fba_blkgrp_len (dev, blkgrp);
+        dev->buflen = fba_blkgrp_len (dev, blkgrp);
+        dev->bufsize = dev->buflen;
+        return 0;
+    }
+
 fba_read_blkgrp_retry:
 
     /* Search the cache */
@@ -628,6 +723,20 @@ fba_read_blkgrp_retry:
     // "%1d:%04X FBA file %s: read blkgrp %d offset %"PRId64" len %d"
     LOGDEVTR( HHC00519, "I", dev->filename, blkgrp, offset, fba_blkgrp_len( dev, blkgrp ));
 
+#if defined( POSIX_FADV_WILLNEED )
+    /* If reading sequentially have the host start reading the
+       following block groups asynchronously while we read this one */
+    if (blkgrp == prevgrp + 1
+        && (blkgrp >= dev->bufrahint
+            || blkgrp + DEVBUF_HOST_RA < dev->bufrahint))
+    {
+        posix_fadvise( dev->fd, offset + CFBA_BLKGRP_SIZE,
+                       (off_t) DEVBUF_HOST_RA * CFBA_BLKGRP_SIZE,
+                       POSIX_FADV_WILLNEED );
+        dev->bufrahint = blkgrp + DEVBUF_HOST_RA / 2;
+    }
+#endif
+
     /* Seek to the block group offset */
     offset = lseek (dev->fd, offset, SEEK_SET);
     if (offset < 0)
@@ -672,6 +781,46 @@ fba_read_blkgrp_retry:
 
 } /* end function fba_dasd_read_blkgrp */
 
+/*-------------------------------------------------------------------*/
+/* Copy the current mapped block group into a cache buffer           */
+/*-------------------------------------------------------------------*/
+static
+void fba_dasd_copy_blkgrp (DEVBLK *dev)
+{
+int             i, o;                   /* Cache indexes             */
+BYTE           *mapbuf = dev->buf;      /* -> Mapped block group     */
+
+    cache_lock (CACHE_DEVBUF);
+
+fba_copy_blkgrp_retry:
+
+    /* A stale entry may remain from an earlier update of the group */
+    i = cache_lookup (CACHE_DEVBUF, FBA_CACHE_SETKEY(dev->devnum, dev->bufcur), &o);
+    if (i < 0)
+    {
+        /* Wait if no available cache entry */
+        if (o < 0)
+        {
+            dev->cachewaits++;
+            cache_wait(CACHE_DEVBUF);
+            goto fba_copy_blkgrp_retry;
+        }
+        i = o;
+        cache_setkey (CACHE_DEVBUF, i, FBA_CACHE_SETKEY(dev->devnum, dev->bufcur));
+    }
+
+    /* Make this cache entry active */
+    cache_setflag(CACHE_DEVBUF, i, 0, FBA_CACHE_ACTIVE|DEVBUF_TYPE_FBA);
+    cache_setage (CACHE_DEVBUF, i);
+    dev->buf = cache_getbuf(CACHE_DEVBUF, i, CFBA_BLKGRP_SIZE);
+    cache_unlock (CACHE_DEVBUF);
+
+    memcpy (dev->buf, mapbuf, dev->buflen);
+    dev->cache = i;
+    dev->bufsize = cache_getlen(CACHE_DEVBUF, dev->cache);
+
+} /* end function fba_dasd_copy_blkgrp */
+
 /*-------------------------------------------------------------------*/
 /* FBA update block group exit                                       */
 /*-------------------------------------------------------------------*/
@@ -692,6 +841,10 @@ int             rc;                     /* Return code               */
         }
     }
 
+    /* A mapped block group is read-only so update a copy of it */
+    if (dev->cache < 0 && dev->dasdmap[0])
+        fba_dasd_copy_blkgrp (dev);
+
     /* Copy to the device buffer */
     if (buf) memcpy (dev->buf + off, buf, len);
 
@@ -754,6 +907,14 @@ BYTE            unitstat;
     cache_scan(CACHE_DEVBUF, fbadasd_purge_cache, dev);
     cache_unlock(CACHE_DEVBUF);
 
+#if !defined( _MSVC_ )
+    /* Unmap the device file */
+    if (dev->dasdmap[0])
+        munmap (dev->dasdmap[0], dev->dasdmapsz[0]);
+#endif
+    dev->dasdmap[0] = NULL;
+    dev->dasdmapsz[0] = 0;
+
     /* Close the device file */
     close (dev->fd);
     dev->fd = -1;
@@ -785,6 +946,8 @@ int     num;                            /* Number of bytes to move   */
 BYTE    hexzeroes[512];                 /* Bytes for zero fill       */
 int     rem;                            /* Byte count for zero fill  */
 int     repcnt;                         /* Replication count         */
+int     direct;                         /* 1=Leave data in dev->buf  */
+int     off;                            /* Offset of data in dev->buf*/
 
     /* Reset extent flag at start of CCW chain */
     if (chained == 0)
@@ -942,6 +1105,15 @@ int     repcnt;                         /* Replication count         */
             break;
         }
 
+        /* If all of the data is within one block group then leave
+           it in the device buffer for the channel to copy directly */
+        num = (int)MIN( count, (U32)dev->fbalcnum * dev->fbablksiz );
+        direct = num > 0
+              && dev->fbarba / CFBA_BLKGRP_SIZE
+              == (dev->fbarba + num - 1) / CFBA_BLKGRP_SIZE;
+        off = (int)(dev->fbarba % CFBA_BLKGRP_SIZE);
+        dev->iodirect = NULL;
+
         /* Read physical blocks of data from device */
         while (dev->fbalcnum > 0 && count > 0)
         {
@@ -959,8 +1131,10 @@ int     repcnt;                         /* Replication count         */
             if (num < dev->fbablksiz) *more = 1;
 
             /* Read physical block into channel buffer */
-            rc = fba_read (dev, iobuf, num, unitstat);
+            rc = fba_read (dev, direct ? NULL : iobuf, num, unitstat);
             if (rc < num) break;
+            if (direct)
+                dev->iodirect = dev->buf + off;
 
             /* Prepare to read next block */
             count -= num;
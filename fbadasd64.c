@@ -162,11 +162,25 @@ CCKD64_DEVHDR   cdevhdr;                /* Compressed device header  */
                 cu = argv[i]+3;
                 continue;
             }
+            if (strcasecmp ("mmap", argv[i]) == 0)
+            {
+                dev->dasdmmap = 1;
+                continue;
+            }
 
             // "%1d:%04X FBA file: parameter %s in argument %d is invalid"
             WRMSG( HHC00503, "E", LCSS_DEVNUM, argv[i], i + 1 );
             return -1;
         }
+
+        /* Compressed images are always read through the cache */
+        if (dev->dasdmmap)
+        {
+            // "%1d:%04X FBA file %s: mmap not used: %s"
+            WRMSG( HHC00522, "W", LCSS_DEVNUM,
+                   dev->filename, "compressed image" );
+            dev->dasdmmap = 0;
+        }
     }
 
     /* Processing for regular fba dasd */
@@ -1889,6 +1889,12 @@ BYTE    *main2;                         /* Operand-2 mainstor addr   */
         i = cpu_length / 4;
         cpu_length = i * 4;
 
+#if defined( HAVE_HOST_VEC_SCAN )
+        /* Add the fullwords, then carry the overflow back in */
+        dreg += host_vec_cksm( main2, cpu_length );
+        while (dreg > 0xFFFFFFFFULL)
+            dreg = (dreg & 0xFFFFFFFFULL) + (dreg >> 32);
+#else
         for (j=0; j < i; j++)
         {
             /* Fetch fullword from second operand */
@@ -1905,6 +1911,7 @@ BYTE    *main2;                         /* Operand-2 mainstor addr   */
                 dreg++;
             }
         } /* end for(j) */
+#endif
 
         /* Adjust the operand address and remaining length for the
            number of bytes processed */
@@ -2663,11 +2670,31 @@ BYTE    rbyte[4],                       /* Register bytes            */
 /*-------------------------------------------------------------------*/
 static INLINE U32 memneq( const BYTE* m1, const BYTE* m2, U32 len )
 {
+#if defined( HAVE_HOST_VEC_SCAN )
+    return (U32) host_vec_neq( m1, m2, (int) len );
+#else
     U32  i;
     for (i=0; i < len; i++)
         if (m1[i] != m2[i])
             break;
     return i;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* memeq: return index of first equal byte                           */
+/*-------------------------------------------------------------------*/
+static INLINE U32 memeq( const BYTE* m1, const BYTE* m2, U32 len )
+{
+#if defined( HAVE_HOST_VEC_SCAN )
+    return (U32) host_vec_eq( m1, m2, (int) len );
+#else
+    U32  i;
+    for (i=0; i < len; i++)
+        if (m1[i] == m2[i])
+            break;
+    return i;
+#endif
 }
 #endif // MEMNEQ
 
@@ -3350,6 +3377,8 @@ VADR    addr1, addr2;                   /* Operand addresses         */
 GREG    len1, len2;                     /* Operand lengths           */
 BYTE    byte1, byte2;                   /* Operand bytes             */
 BYTE    pad;                            /* Padding byte              */
+BYTE   *m1, *m2;                        /* Mainstor addresses        */
+U32     n, k;                           /* Compare lengths           */
 
     RS( inst, regs, r1, r3, b2, effective_addr2 );
 
@@ -3367,8 +3396,38 @@ BYTE    pad;                            /* Padding byte              */
     len1 = GR_A( r1+1, regs );
     len2 = GR_A( r3+1, regs );
 
-    /* Process operands from left to right */
-    for (i = 0; len1 > 0 || len2 > 0 ; i++)
+    /* Compare both operands a page at a time while neither is used up */
+    for (i = 0; len1 > 0 && len2 > 0 && i < 4096; i += k)
+    {
+        n = 4096 - i;
+        n = MIN( n, PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK) );
+        n = MIN( n, PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK) );
+        if (len1 < n) n = (U32) len1;
+        if (len2 < n) n = (U32) len2;
+
+        ITIMER_SYNC( addr1, n-1, regs );
+        ITIMER_SYNC( addr2, n-1, regs );
+
+        m1 = MADDRL( addr1, n, r1, regs, ACCTYPE_READ, regs->psw.pkey );
+        m2 = MADDRL( addr2, n, r3, regs, ACCTYPE_READ, regs->psw.pkey );
+
+        k = memneq( m1, m2, n );
+
+        addr1 = (addr1 + k) & ADDRESS_MAXWRAP( regs );
+        addr2 = (addr2 + k) & ADDRESS_MAXWRAP( regs );
+        len1 -= k;
+        len2 -= k;
+
+        /* Set condition code if unequal */
+        if (k < n)
+        {
+            cc = (m1[k] < m2[k]) ? 1 : 2;
+            break;
+        }
+    }
+
+    /* Process the rest, compared with the padding byte, byte by byte */
+    for (; !cc && (len1 > 0 || len2 > 0); i++)
     {
         /* If 4096 bytes have been compared, exit with cc=3 */
         if (i >= 4096)
@@ -3642,6 +3701,8 @@ BYTE    pad;                            /* Padding byte              */
 BYTE    sublen;                         /* Substring length          */
 BYTE    equlen = 0;                     /* Equal byte counter        */
 VADR    eqaddr1, eqaddr2;               /* Address of equal substring*/
+BYTE   *m1, *m2;                        /* Mainstor addresses        */
+U32     n, k;                           /* Unequal run lengths       */
 #if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
 S64     len1, len2;                     /* Operand lengths           */
 S64     remlen1, remlen2;               /* Lengths remaining         */
@@ -3720,6 +3781,43 @@ S32     remlen1, remlen2;               /* Lengths remaining         */
             break;
         }
 
+        /* Skip a run of unequal bytes up to the next half page of
+           either operand, where the registers must be updated */
+        if (equlen == 0 && len1 > 0 && len2 > 0)
+        {
+            n = 4096 - i;
+            n = MIN( n, 0x800 - (addr1 & 0x7FF) );
+            n = MIN( n, 0x800 - (addr2 & 0x7FF) );
+            if (len1 < (S64) n) n = (U32) len1;
+            if (len2 < (S64) n) n = (U32) len2;
+
+            ITIMER_SYNC( addr1, n-1, regs );
+            ITIMER_SYNC( addr2, n-1, regs );
+
+            m1 = MADDRL( addr1, n, r1, regs, ACCTYPE_READ, regs->psw.pkey );
+            m2 = MADDRL( addr2, n, r2, regs, ACCTYPE_READ, regs->psw.pkey );
+
+            if ((k = memeq( m1, m2, n )) > 0)
+            {
+                addr1 = (addr1 + k) & ADDRESS_MAXWRAP(regs);
+                addr2 = (addr2 + k) & ADDRESS_MAXWRAP(regs);
+                len1 -= k;
+                len2 -= k;
+                i += k - 1;
+                cc = 2;
+
+                /* update GPRs if we just crossed half page - could get rupt */
+                if ((addr1 & 0x7FF) == 0 || (addr2 & 0x7FF) == 0)
+                {
+                    SET_GR_A(r1, regs,addr1);
+                    SET_GR_A(r2, regs,addr2);
+                    SET_GR_A(r1+1, regs,len1);
+                    SET_GR_A(r2+1, regs,len2);
+                }
+                continue;
+            }
+        }
+
         /* Fetch byte from first operand, or use padding byte */
         if (len1 > 0)
             byte1 = ARCH_DEP(vfetchb) ( addr1, r1, regs );
@@ -3845,6 +3943,10 @@ U16     unicode1;                       /* Unicode character         */
 U16     unicode2;                       /* Unicode low surrogate     */
 GREG    n;                              /* Number of UTF-8 bytes - 1 */
 BYTE    utf[4];                         /* UTF-8 bytes               */
+#if defined( HAVE_HOST_VEC_SCAN )
+BYTE   *main1, *main2;                  /* Mainstor addresses        */
+GREG    k;                              /* ASCII run length          */
+#endif
 #if defined( FEATURE_030_ETF3_ENHANCEMENT_FACILITY )
 bool    wfc;                            /* Well-Formedness-Checking  */
 #endif
@@ -3886,6 +3988,41 @@ bool    wfc;                            /* Well-Formedness-Checking  */
             break;
         }
 
+#if defined( HAVE_HOST_VEC_SCAN )
+        /* Convert a run of ASCII characters together, up to
+           the next page boundary of either operand */
+        k = MIN( 4096 - i, PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK) );
+        k = MIN( k, (PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK)) / 2 );
+        k = MIN( k, MIN( len1, len2 / 2 ));
+        if (k > 1)
+        {
+            main2 = MADDRL( addr2, 2*k, r2, regs, ACCTYPE_READ, regs->psw.pkey );
+            if (fetch_hw( main2 ) < 0x0080)
+            {
+                main1 = MADDRL( addr1, k, r1, regs, ACCTYPE_WRITE, regs->psw.pkey );
+                if (main1 + k <= main2 || main2 + 2*k <= main1)
+                {
+                    k = host_vec_ascii_narrow( main1, main2, (int) k, 2 );
+                    addr1 = (addr1 + k) & ADDRESS_MAXWRAP(regs);
+                    len1 -= k;
+                    addr2 = (addr2 + 2*k) & ADDRESS_MAXWRAP(regs);
+                    len2 -= 2*k;
+
+                    SET_GR_A(r1, regs,addr1);
+                    SET_GR_A(r1+1, regs,len1);
+                    SET_GR_A(r2, regs,addr2);
+                    SET_GR_A(r2+1, regs,len2);
+
+                    if (len1 == 0 && len2 != 0)
+                        cc = 1;
+
+                    i += (int) k - 1;
+                    continue;
+                }
+            }
+        }
+#endif
+
         /* Exit if fewer than 2 bytes remain in source operand */
         if (len2 < 2) break;
 
@@ -4002,6 +4139,10 @@ U16     unicode1;                       /* Unicode character         */
 U16     unicode2 = 0;                   /* Unicode low surrogate     */
 GREG    n;                              /* Number of UTF-8 bytes - 1 */
 BYTE    utf[4];                         /* UTF-8 bytes               */
+#if defined( HAVE_HOST_VEC_SCAN )
+BYTE   *main1, *main2;                  /* Mainstor addresses        */
+GREG    k;                              /* ASCII run length          */
+#endif
 #if defined( FEATURE_030_ETF3_ENHANCEMENT_FACILITY )
 bool    wfc;                            /* WellFormednessChecking    */
 #endif
@@ -4043,6 +4184,41 @@ bool    wfc;                            /* WellFormednessChecking    */
             break;
         }
 
+#if defined( HAVE_HOST_VEC_SCAN )
+        /* Convert a run of ASCII characters together, up to
+           the next page boundary of either operand */
+        k = MIN( 4096 - i, PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK) );
+        k = MIN( k, (PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK)) / 2 );
+        k = MIN( k, MIN( len2, len1 / 2 ));
+        if (k > 1)
+        {
+            main2 = MADDRL( addr2, k, r2, regs, ACCTYPE_READ, regs->psw.pkey );
+            if (main2[0] < 0x80)
+            {
+                main1 = MADDRL( addr1, 2*k, r1, regs, ACCTYPE_WRITE, regs->psw.pkey );
+                if (main1 + 2*k <= main2 || main2 + k <= main1)
+                {
+                    k = host_vec_ascii_widen( main1, main2, (int) k, 2 );
+                    addr1 = (addr1 + 2*k) & ADDRESS_MAXWRAP(regs);
+                    len1 -= 2*k;
+                    addr2 = (addr2 + k) & ADDRESS_MAXWRAP(regs);
+                    len2 -= k;
+
+                    SET_GR_A(r1, regs,addr1);
+                    SET_GR_A(r1+1, regs,len1);
+                    SET_GR_A(r2, regs,addr2);
+                    SET_GR_A(r2+1, regs,len2);
+
+                    if (len1 == 0 && len2 != 0)
+                        cc = 1;
+
+                    i += (int) k - 1;
+                    continue;
+                }
+            }
+        }
+#endif
+
         /* Fetch first UTF-8 byte from source operand */
         utf[0] = ARCH_DEP(vfetchb) ( addr2, r2, regs );
 
@@ -5664,7 +5840,7 @@ int     orglen1;                        /* Original dest length      */
             len4 = NOCROSSPAGEL( addr2, len2 ) ? len2 : (int)(PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK));
             len = len3 < len4 ? len3 : len4;
             /* Use concpy to ensure Concurrent block update consistency */
-            concpy( regs, dest, source, len );
+            concpy_long( regs, dest, source, len );
         }
 
         /* Adjust lengths and virtual addresses */
@@ -5787,7 +5963,7 @@ size_t  dstlen,srclen;                  /* Page wide src/dst lengths */
         BYTE *source;
         /* get source frame and copy concurrently */
         source = MADDRL(addr2, copylen, r3, regs, ACCTYPE_READ, regs->psw.pkey);
-        concpy(regs,dest,source,(int)copylen);
+        concpy_long(regs,dest,source,(int)copylen);
         /* Adjust operands */
         addr2+=(int)copylen;
         len2-=(int)copylen;
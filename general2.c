@@ -537,6 +537,7 @@ int     cpu_length;                     /* CPU determined length     */
 VADR    addr1, addr2;                   /* End/start addresses       */
 BYTE    *main2;                         /* Operand-2 mainstor addr   */
 BYTE    termchar;                       /* Terminating character     */
+BYTE    *tpos;                          /* Terminating char mainstor */
 
     RRE( inst, regs, r1, r2 );
 
@@ -631,36 +632,36 @@ BYTE    termchar;                       /* Terminating character     */
     }
 
     main2 = MADDRL(addr2, cpu_length, r2, regs, ACCTYPE_READ, regs->psw.pkey );
-    for (i=0; i < cpu_length; i++)
-    {
-        /* If operand end address has been reached, return
-           CC=2 and leave the R1 and R2 registers unchanged */
-        if (addr2 == addr1)
-        {
-            regs->psw.cc = 2;
-            return;
-        }
 
-        /* If the terminating character was found, return
-           CC=1 and load the address of the character in R1 */
-        if (*main2 == termchar)
-        {
-            SET_GR_A( r1, regs, addr2 );
-            regs->psw.cc = 1;
-            return;
-        }
+    /* Search no further than the operand end address when
+       that is within the part of the page being searched */
+    i = cpu_length;
+    if (((addr1 - addr2) & ADDRESS_MAXWRAP( regs )) < (VADR) cpu_length)
+        i = (int)((addr1 - addr2) & ADDRESS_MAXWRAP( regs ));
 
-        /* Bump operand-2 */
-        main2++;
-        addr2++;
-        addr2 &= ADDRESS_MAXWRAP( regs );
+    /* If the terminating character was found, return
+       CC=1 and load the address of the character in R1 */
+    if ((tpos = memchr( main2, termchar, i )))
+    {
+        SET_GR_A( r1, regs, (addr2 + (tpos - main2)) & ADDRESS_MAXWRAP( regs ));
+        regs->psw.cc = 1;
+        return;
+    }
 
-    } /* end for(i) */
+    /* If operand end address has been reached, return
+       CC=2 and leave the R1 and R2 registers unchanged */
+    if (i < cpu_length)
+    {
+        regs->psw.cc = 2;
+        return;
+    }
 
     /* The CPU determine number of bytes has been reached.
        Set R2 to point to next character of operand-2 and
        return CC=3.
     */
+    addr2 += cpu_length;
+    addr2 &= ADDRESS_MAXWRAP( regs );
     SET_GR_A( r2, regs, addr2 );
     regs->psw.cc = 3;
 
@@ -1740,8 +1741,14 @@ BYTE   *dest, *dest2 = NULL, *tab, *tab2; /* Mainstor pointers       */
     {
         tab = MADDRL(effective_addr2, 256, b2, regs, ACCTYPE_READ, regs->psw.pkey );
         /* Perform translate function */
+#if defined( HAVE_HOST_VEC_SCAN )
+        host_vec_tr( dest, len+1, tab );
+        if (dest2)
+            host_vec_tr( dest2, len2+1, tab );
+#else
         for (i=0; i <= len;  i++) dest [i] = tab[dest [i]];
         for (i=0; i <= len2; i++) dest2[i] = tab[dest2[i]];
+#endif
     }
     else /* Translate table spans a boundary */
     {
@@ -1778,69 +1785,96 @@ BYTE   *dest, *dest2 = NULL, *tab, *tab2; /* Mainstor pointers       */
 }
 
 
+#ifndef TRT_SCAN
+#define TRT_SCAN
+/*-------------------------------------------------------------------*/
+/* trt_scan: index of first byte with a nonzero function byte, or n  */
+/*-------------------------------------------------------------------*/
+static INLINE int trt_scan( const BYTE* s, int n, const BYTE* tab )
+{
+#if defined( HAVE_HOST_VEC_SCAN )
+    return host_vec_trt( s, n, tab );
+#else
+    int  i;
+    for (i=0; i < n; i++)
+        if (tab[ s[i] ])
+            break;
+    return i;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* trtr_scan: index of last byte with a nonzero function byte, or -1 */
+/*-------------------------------------------------------------------*/
+static INLINE int trtr_scan( const BYTE* s, int n, const BYTE* tab )
+{
+#if defined( HAVE_HOST_VEC_SCAN )
+    return host_vec_trtr( s, n, tab );
+#else
+    int  i;
+    for (i=n-1; i >= 0; i--)
+        if (tab[ s[i] ])
+            break;
+    return i;
+#endif
+}
+#endif // TRT_SCAN
+
 /*-------------------------------------------------------------------*/
 /* DD   TRT   - Translate and Test                            [SS-a] */
 /*-------------------------------------------------------------------*/
 DEF_INST(translate_and_test)
 {
-CACHE_ALIGN BYTE op1[256], op2[256];    /* Operand work areas        */
 VADR    effective_addr1;                /* Effective address         */
 VADR    effective_addr2;                /* Effective address         */
 int     b1, b2;                         /* Base registers            */
 int     len;                            /* Length - 1                */
-int     i;                              /* work variable             */
+int     i, n;                           /* work variables            */
 int     cc = 0;                         /* Condition code            */
 BYTE    dbyte, sbyte = 0;               /* Byte work areas           */
-bool    op1crosses, op2crosses;         /* Operand crosses Page Bdy  */
+BYTE   *op1, *tab;                      /* Mainstor addresses        */
 
     SS_L( inst, regs, len, b1, effective_addr1, b2, effective_addr2 );
 
     CONTRAN_INSTR_CHECK( regs );
 
-    /* Copy operand-1 data to work area if within same page */
-    if (!(op1crosses = CROSSPAGE( effective_addr1, len )))
-        ARCH_DEP( vfetchc )( op1, len, effective_addr1, b1, regs );
-
-    /* Copy operand-2 data to work area if within same page */
-    if (!(op2crosses = CROSSPAGE( effective_addr2, 256-1 )))
-        ARCH_DEP( vfetchc )( op2, 256-1, effective_addr2, b2, regs );
-
     /* Process first operand from left to right */
-    if (unlikely( op1crosses ))
+    if (NOCROSSPAGE( effective_addr2, 256-1 ))
     {
-        /* Operand-1 crosses a page boundary */
-        if (unlikely( op2crosses ))
-        {
-            /* WORST case: BOTH operands cross a page boundary */
-            for (i=0; i <= len; i++)
-            {
-                dbyte = ARCH_DEP( vfetchb )( effective_addr1+i, b1, regs );
-                if ((sbyte = ARCH_DEP( vfetchb )( effective_addr2+dbyte, b2, regs )))
-                    break;
-            }
-        }
-        else /* Only operand-1 crosses a page boundary */
+        /* Usual case: the table is within a single page */
+        ITIMER_SYNC( effective_addr2, 256-1, regs );
+        tab = MADDRL( effective_addr2, 256, b2, regs, ACCTYPE_READ, regs->psw.pkey );
+
+        /* Scan operand-1 up to the end of its first page */
+        n = NOCROSSPAGE( effective_addr1, len ) ? len + 1
+          : (int)(PAGEFRAME_PAGESIZE - (effective_addr1 & PAGEFRAME_BYTEMASK));
+
+        ITIMER_SYNC( effective_addr1, n-1, regs );
+        op1 = MADDRL( effective_addr1, n, b1, regs, ACCTYPE_READ, regs->psw.pkey );
+        if ((i = trt_scan( op1, n, tab )) < n)
+            sbyte = tab[ op1[i] ];
+
+        /* The second page is only accessed if nothing was found */
+        else if (n <= len)
         {
-            for (i=0; i <= len; i++)
-                if ((sbyte = op2[ ARCH_DEP( vfetchb )( effective_addr1+i, b1, regs ) ]))
-                    break;
+            ITIMER_SYNC( (effective_addr1 + n) & ADDRESS_MAXWRAP( regs ), len - n, regs );
+            op1 = MADDRL((effective_addr1 + n) & ADDRESS_MAXWRAP( regs ),
+                    len + 1 - n, b1, regs, ACCTYPE_READ, regs->psw.pkey );
+            if ((i = trt_scan( op1, len + 1 - n, tab )) < len + 1 - n)
+                sbyte = tab[ op1[i] ];
+            i += n;
         }
     }
-    else /* Operand-1 does NOT cross a page boundary */
+    else
     {
-       if (unlikely( op2crosses ))
-       {
-            /* But operand-2 DOES cross a page boundary */
-            for (i=0; i <= len; i++)
-                if ((sbyte = ARCH_DEP( vfetchb )( effective_addr2+op1[i], b2, regs )))
-                    break;
-       }
-       else /* BEST case: NEITHER operand crosses a page boundary */
-       {
-            for (i=0; i <= len; i++)
-                if ((sbyte = op2[ op1[i] ]))
-                    break;
-       }
+        /* The table crosses a page boundary: only the function
+           bytes actually used may be accessed, so go byte by byte */
+        for (i=0; i <= len; i++)
+        {
+            dbyte = ARCH_DEP( vfetchb )( (effective_addr1+i) & ADDRESS_MAXWRAP( regs ), b1, regs );
+            if ((sbyte = ARCH_DEP( vfetchb )( (effective_addr2+dbyte) & ADDRESS_MAXWRAP( regs ), b2, regs )))
+                break;
+        }
     }
 
     /* Test for non-zero function byte */
@@ -1880,11 +1914,11 @@ bool    op1crosses, op2crosses;         /* Operand crosses Page Bdy  */
 DEF_INST(translate_extended)
 {
 int     r1, r2;                         /* Values of R fields        */
-int     i;                              /* Loop counter              */
+int     i, k, n;                        /* Loop counter and lengths  */
 int     cc = 0;                         /* Condition code            */
 VADR    addr1, addr2;                   /* Operand addresses         */
 GREG    len1;                           /* Operand length            */
-BYTE    byte1, byte2;                   /* Operand bytes             */
+BYTE   *main1, *tpos;                   /* Mainstor addresses        */
 BYTE    tbyte;                          /* Test byte                 */
 BYTE    trtab[256];                     /* Translate table           */
 
@@ -1909,8 +1943,8 @@ BYTE    trtab[256];                     /* Translate table           */
        operand may be recognized, even if not all bytes are used */
     ARCH_DEP(vfetchc) ( trtab, 255, addr2, r2, regs );
 
-    /* Process first operand from left to right */
-    for (i = 0; len1 > 0; i++)
+    /* Process first operand from left to right, a page at a time */
+    for (i = 0; len1 > 0; i += k)
     {
         /* If 4096 bytes have been compared, exit with CC 3 */
         if (i >= 4096)
@@ -1919,29 +1953,44 @@ BYTE    trtab[256];                     /* Translate table           */
             break;
         }
 
-        /* Fetch byte from first operand */
-        byte1 = ARCH_DEP(vfetchb) ( addr1, r1, regs );
+        n = 4096 - i;
+        n = MIN( n, PAGEFRAME_PAGESIZE - (addr1 & PAGEFRAME_BYTEMASK) );
+        if (len1 < (GREG) n) n = (int) len1;
+
+        /* Find the test byte, if any, in this part of the operand */
+        ITIMER_SYNC( addr1, n-1, regs );
+        main1 = MADDRL( addr1, n, r1, regs, ACCTYPE_READ, regs->psw.pkey );
+        tpos  = memchr( main1, tbyte, n );
+        k     = tpos ? (int)(tpos - main1) : n;
+
+        /* Translate the bytes before it in place */
+        if (k)
+        {
+            main1 = MADDRL( addr1, k, r1, regs, ACCTYPE_WRITE, regs->psw.pkey );
+#if defined( HAVE_HOST_VEC_SCAN )
+            host_vec_tr( main1, k, trtab );
+#else
+            for (tpos = main1; tpos < main1 + k; tpos++)
+                *tpos = trtab[ *tpos ];
+#endif
+            ITIMER_UPDATE( addr1, k-1, regs );
+
+            addr1 += k;
+            addr1 &= ADDRESS_MAXWRAP(regs);
+            len1 -= k;
+
+            /* Update the registers */
+            SET_GR_A(r1, regs, addr1);
+            SET_GR_A(r1+1, regs, len1);
+        }
 
         /* If equal to test byte, exit with condition code 1 */
-        if (byte1 == tbyte)
+        if (k < n)
         {
             cc = 1;
             break;
         }
 
-        /* Load indicated byte from translate table */
-        byte2 = trtab[byte1];
-
-        /* Store result at first operand address */
-        ARCH_DEP(vstoreb) ( byte2, addr1, r1, regs );
-        addr1++;
-        addr1 &= ADDRESS_MAXWRAP(regs);
-        len1--;
-
-        /* Update the registers */
-        SET_GR_A(r1, regs, addr1);
-        SET_GR_A(r1+1, regs, len1);
-
     } /* end for(i) */
 
     /* Set condition code */
@@ -2188,6 +2237,10 @@ DEF_INST(convert_utf8_to_utf32)
   bool wfc;                        /* Well-Formedness-Checking (W)   */
 #endif
   int xlated;                      /* characters translated          */
+#if defined( HAVE_HOST_VEC_SCAN )
+  BYTE *main1, *main2;             /* Mainstor addresses             */
+  GREG k;                          /* ASCII run length               */
+#endif
 
   RRF_M(inst, regs, r1, r2, m3);
 
@@ -2228,6 +2281,33 @@ DEF_INST(convert_utf8_to_utf32)
       return;
     }
 
+#if defined( HAVE_HOST_VEC_SCAN )
+    /* Convert a run of ASCII characters together, up to
+       the next page boundary of either operand */
+    k = MIN(4096 - xlated, PAGEFRAME_PAGESIZE - (srce & PAGEFRAME_BYTEMASK));
+    k = MIN(k, (PAGEFRAME_PAGESIZE - (dest & PAGEFRAME_BYTEMASK)) / 4);
+    k = MIN(k, MIN(srcelen, destlen / 4));
+    if(k > 1)
+    {
+      main2 = MADDRL(srce & ADDRESS_MAXWRAP(regs), k, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+      if(main2[0] < 0x80)
+      {
+        main1 = MADDRL(dest & ADDRESS_MAXWRAP(regs), 4*k, r1, regs, ACCTYPE_WRITE, regs->psw.pkey);
+        if(main1 + 4*k <= main2 || main2 + k <= main1)
+        {
+          k = host_vec_ascii_widen(main1, main2, (int) k, 4);
+          SET_GR_A(r1, regs, (dest += 4*k) & ADDRESS_MAXWRAP(regs));
+          SET_GR_A(r1 + 1, regs, destlen -= 4*k);
+          SET_GR_A(r2, regs, (srce += k) & ADDRESS_MAXWRAP(regs));
+          SET_GR_A(r2 + 1, regs, srcelen -= k);
+
+          xlated += (int) k;
+          continue;
+        }
+      }
+    }
+#endif
+
     /* Fetch a byte */
     utf8[0] = ARCH_DEP(vfetchb)(srce, r2, regs);
     if(utf8[0] < 0x80)
@@ -2547,6 +2627,10 @@ DEF_INST(convert_utf32_to_utf8)
   BYTE utf8[4];                    /* utf8 character(s)              */
   int write;                       /* Bytes written                  */
   int xlated;                      /* characters translated          */
+#if defined( HAVE_HOST_VEC_SCAN )
+  BYTE *main1, *main2;             /* Mainstor addresses             */
+  GREG k;                          /* ASCII run length               */
+#endif
 
   RRE(inst, regs, r1, r2);
 
@@ -2579,6 +2663,33 @@ DEF_INST(convert_utf32_to_utf8)
       return;
     }
 
+#if defined( HAVE_HOST_VEC_SCAN )
+    /* Convert a run of ASCII characters together, up to
+       the next page boundary of either operand */
+    k = MIN((4096 - xlated) / 4, PAGEFRAME_PAGESIZE - (dest & PAGEFRAME_BYTEMASK));
+    k = MIN(k, (PAGEFRAME_PAGESIZE - (srce & PAGEFRAME_BYTEMASK)) / 4);
+    k = MIN(k, MIN(srcelen / 4, destlen));
+    if(k > 1)
+    {
+      main2 = MADDRL(srce & ADDRESS_MAXWRAP(regs), 4*k, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+      if(fetch_fw(main2) < 0x80)
+      {
+        main1 = MADDRL(dest & ADDRESS_MAXWRAP(regs), k, r1, regs, ACCTYPE_WRITE, regs->psw.pkey);
+        if(main1 + k <= main2 || main2 + 4*k <= main1)
+        {
+          k = host_vec_ascii_narrow(main1, main2, (int) k, 4);
+          SET_GR_A(r1, regs, (dest += k) & ADDRESS_MAXWRAP(regs));
+          SET_GR_A(r1 + 1, regs, destlen -= k);
+          SET_GR_A(r2, regs, (srce += 4*k) & ADDRESS_MAXWRAP(regs));
+          SET_GR_A(r2 + 1, regs, srcelen -= 4*k);
+
+          xlated += 4 * (int) k;
+          continue;
+        }
+      }
+    }
+#endif
+
     /* Get 4 bytes */
     ARCH_DEP(vfetchc)(utf32, 3, srce, r2, regs);
 
@@ -2785,6 +2896,9 @@ DEF_INST(search_string_unicode)
   int r1, r2;                           /* Values of R fields        */
   U16 sbyte;                            /* String character          */
   U16 termchar;                         /* Terminating character     */
+  BYTE *main2;                          /* Operand-2 mainstor addr   */
+  VADR dist;                            /* Distance to end address   */
+  int n, k;                             /* Characters in this page   */
 
   RRE(inst, regs, r1, r2);
 
@@ -2804,6 +2918,48 @@ DEF_INST(search_string_unicode)
   /* Search up to 256 bytes or until end of operand */
   for(i = 0; i < 0x100; i++)
   {
+    /* Search the characters wholly within this page together */
+    n = (int)(PAGEFRAME_PAGESIZE - (addr2 & PAGEFRAME_BYTEMASK)) / 2;
+    if(n > 0x100 - i)
+      n = 0x100 - i;
+    if(n > 1)
+    {
+      /* Stop short of the operand end address if it is reached */
+      dist = (addr1 - addr2) & ADDRESS_MAXWRAP(regs);
+      if(!(dist & 1) && dist < (VADR)(2 * n))
+      {
+        if(!dist)
+        {
+          regs->psw.cc = 2;
+          return;
+        }
+        n = (int)(dist / 2);
+      }
+
+      main2 = MADDRL(addr2, 2 * n, r2, regs, ACCTYPE_READ, regs->psw.pkey);
+#if defined( HAVE_HOST_VEC_SCAN )
+      k = host_vec_chr2(main2, n, termchar);
+#else
+      for(k = 0; k < n; k++)
+        if(fetch_hw(main2 + 2 * k) == termchar)
+          break;
+#endif
+
+      /* If the terminating character was found, return condition
+         code 1 and load the address of the character into R1 */
+      if(k < n)
+      {
+        SET_GR_A(r1, regs, (addr2 + 2 * k) & ADDRESS_MAXWRAP(regs));
+        regs->psw.cc = 1;
+        return;
+      }
+
+      addr2 += 2 * n;
+      addr2 &= ADDRESS_MAXWRAP(regs);
+      i += n - 1;
+      continue;
+    }
+
     /* If operand end address has been reached, return condition
        code 2 and leave the R1 and R2 registers unchanged */
     if(addr2 == addr1)
@@ -2847,59 +3003,94 @@ DEF_INST(translate_and_test_reverse)
   BYTE dbyte;                           /* Byte work areas           */
   VADR effective_addr1;
   VADR effective_addr2;                 /* Effective addresses       */
-  int i;                                /* Integer work areas        */
+  int i, j, n;                          /* Integer work areas        */
   int len;                              /* Length byte               */
-  BYTE sbyte;                           /* Byte work areas           */
+  BYTE sbyte = 0;                       /* Byte work areas           */
+  BYTE *op1, *tab;                      /* Mainstor addresses        */
 
   SS_L(inst, regs, len, b1, effective_addr1, b2, effective_addr2);
 
   CONTRAN_INSTR_CHECK( regs );
 
   /* Process first operand from right to left*/
-  for(i = 0; i <= len; i++)
+  if(NOCROSSPAGE(effective_addr2, 256-1))
   {
-    /* Fetch argument byte from first operand */
-    dbyte = ARCH_DEP(vfetchb)(effective_addr1, b1, regs);
-
-    /* Fetch function byte from second operand */
-    sbyte = ARCH_DEP(vfetchb)((effective_addr2 + dbyte) & ADDRESS_MAXWRAP(regs), b2, regs);
+    /* Usual case: the table is within a single page */
+    ITIMER_SYNC(effective_addr2, 256-1, regs);
+    tab = MADDRL(effective_addr2, 256, b2, regs, ACCTYPE_READ, regs->psw.pkey);
+
+    /* Scan operand-1 back to the start of its last page */
+    n = (int)(effective_addr1 & PAGEFRAME_BYTEMASK) + 1;
+    if(n > len + 1)
+      n = len + 1;
+
+    ITIMER_SYNC((effective_addr1 - (n-1)) & ADDRESS_MAXWRAP(regs), n-1, regs);
+    op1 = MADDRL((effective_addr1 - (n-1)) & ADDRESS_MAXWRAP(regs),
+            n, b1, regs, ACCTYPE_READ, regs->psw.pkey);
+    if((j = trtr_scan(op1, n, tab)) >= 0)
+    {
+      sbyte = tab[op1[j]];
+      i = n-1 - j;
+    }
 
-    /* Test for non-zero function byte */
-    if(sbyte != 0)
+    /* The preceding page is only accessed if nothing was found */
+    else if((i = n) <= len)
     {
-      /* Store address of argument byte in register 1 */
-#if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
-      if(regs->psw.amode64)
-        regs->GR_G(1) = effective_addr1;
-      else
-#endif
-      if(regs->psw.amode)
-      {
-        /* Note: TRTR differs from TRT in 31 bit mode.
-           TRTR leaves bit 32 unchanged, TRT clears bit 32 */
-        regs->GR_L(1) &= 0x80000000;
-        regs->GR_L(1) |= effective_addr1;
-      }
-      else
-        regs->GR_LA24(1) = effective_addr1;
+      ITIMER_SYNC((effective_addr1 - len) & ADDRESS_MAXWRAP(regs), len - n, regs);
+      op1 = MADDRL((effective_addr1 - len) & ADDRESS_MAXWRAP(regs),
+              len + 1 - n, b1, regs, ACCTYPE_READ, regs->psw.pkey);
+      if((j = trtr_scan(op1, len + 1 - n, tab)) >= 0)
+        sbyte = tab[op1[j]];
+      i = len - j;
+    }
+  }
+  else
+  {
+    /* The table crosses a page boundary: only the function
+       bytes actually used may be accessed, so go byte by byte */
+    for(i = 0; i <= len; i++)
+    {
+      /* Fetch argument byte from first operand */
+      dbyte = ARCH_DEP(vfetchb)((effective_addr1 - i) & ADDRESS_MAXWRAP(regs), b1, regs);
 
-      /* Store function byte in low-order byte of reg.2 */
-      regs->GR_LHLCL(2) = sbyte;
+      /* Fetch function byte from second operand */
+      sbyte = ARCH_DEP(vfetchb)((effective_addr2 + dbyte) & ADDRESS_MAXWRAP(regs), b2, regs);
 
-      /* Set condition code 2 if argument byte was last byte
-         of first operand, otherwise set condition code 1 */
-      cc = (i == len) ? 2 : 1;
+      if(sbyte != 0)
+        break;
+    }
+  }
 
-      /* Terminate the operation at this point */
-      break;
+  /* Test for non-zero function byte */
+  if(sbyte != 0)
+  {
+    effective_addr1 -= i; /* Another difference with TRT */
+    effective_addr1 &= ADDRESS_MAXWRAP(regs);
 
-    } /* end if(sbyte) */
+    /* Store address of argument byte in register 1 */
+#if defined( FEATURE_001_ZARCH_INSTALLED_FACILITY )
+    if(regs->psw.amode64)
+      regs->GR_G(1) = effective_addr1;
+    else
+#endif
+    if(regs->psw.amode)
+    {
+      /* Note: TRTR differs from TRT in 31 bit mode.
+         TRTR leaves bit 32 unchanged, TRT clears bit 32 */
+      regs->GR_L(1) &= 0x80000000;
+      regs->GR_L(1) |= effective_addr1;
+    }
+    else
+      regs->GR_LA24(1) = effective_addr1;
 
-    /* Decrement first operand address */
-    effective_addr1--; /* Another difference with TRT */
-    effective_addr1 &= ADDRESS_MAXWRAP(regs);
+    /* Store function byte in low-order byte of reg.2 */
+    regs->GR_LHLCL(2) = sbyte;
 
-  } /* end for(i) */
+    /* Set condition code 2 if argument byte was last byte
+       of first operand, otherwise set condition code 1 */
+    cc = (i == len) ? 2 : 1;
+
+  } /* end if(sbyte) */
 
   /* Update the condition code */
   regs->psw.cc = cc;
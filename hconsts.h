@@ -127,6 +127,16 @@
 #define MAX_390_MAINSIZE_PAGES      (MAX_390_MAINSIZE_BYTES  >> SHIFT_4K)
 #define MAX_900_MAINSIZE_PAGES      (MAX_900_MAINSIZE_BYTES  >> SHIFT_4K)
 
+/*-------------------------------------------------------------------*/
+/*       Host huge page backing of main and expanded storage         */
+/*-------------------------------------------------------------------*/
+
+#define HUGEPAGE_SIZE               (2ULL << SHIFT_MEGABYTE) // (see alloc_storage)
+
+#define HUGEPAGES_NONE              0   // (ordinary host pages)
+#define HUGEPAGES_THP               1   // (madvise MADV_HUGEPAGE)
+#define HUGEPAGES_HUGETLB           2   // (mmap MAP_HUGETLB)
+
 /*-------------------------------------------------------------------*/
 /* Miscellaneous system related constants we could be missing...     */
 /*-------------------------------------------------------------------*/
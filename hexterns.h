@@ -67,6 +67,7 @@ int  configure_memlock(int);
 int  configure_memfree(int);
 int  configure_storage( U64 /* number of 4K pages */ );
 int  configure_xstorage(U64);
+int  configure_numa( bool pin, bool interleave );
 U64  adjust_mainsize( int archnum, U64 mainsize );
 
 int  configure_shrdport(U16 shrdport);
@@ -300,6 +301,7 @@ void ckd_dasd_query_device (DEVBLK *dev, char **devclass,
                 int buflen, char *buffer);
 int ckd_dasd_hsuspend ( DEVBLK *dev, void *file );
 int ckd_dasd_hresume  ( DEVBLK *dev, void *file );
+void ckd_dasd_mmap ( DEVBLK *dev );
 
 /* Functions in module fbadasd.c */
 FBA_DLL_IMPORT void fbadasd_syncblk_io (DEVBLK *dev, BYTE type, int blknum,
@@ -329,6 +331,7 @@ int     cckd_read_track (DEVBLK *, int, BYTE *);
 int     cckd_update_track (DEVBLK *, int, int, BYTE *, int, BYTE *);
 int     cfba_read_block (DEVBLK *, int, BYTE *);
 int     cfba_write_block (DEVBLK *, int, int, BYTE *, int, BYTE *);
+CCKD_DLL_IMPORT int cckd_set_dict (DEVBLK *, BYTE *, int);
 
 DEVIF   cckd64_dasd_init_handler;
 int     cckd64_dasd_close_device (DEVBLK *);
@@ -340,6 +343,10 @@ int     cfba64_write_block (DEVBLK *, int, int, BYTE *, int, BYTE *);
 /* Functions in module cckdutil.c/cckdutil64.c */
 CCDU_DLL_IMPORT const char* comp_to_str( BYTE comp );
 CCDU_DLL_IMPORT const char* spc_typ_to_str( BYTE spc_typ );
+CCDU_DLL_IMPORT int   cckd_inflate_dict( BYTE* to, int tolen, BYTE* from,
+                                         int fromlen, const BYTE* dict, int dictlen );
+CCDU_DLL_IMPORT int   cckd_dict_train( BYTE* dict, int dictsize, const BYTE* samples,
+                                       const int* lens, int nsamples );
 
 CCDU_DLL_IMPORT   int   cckd_swapend (DEVBLK *);
 CCDU_DLL_IMPORT   void  cckd_swapend_chdr ( CCKD_DEVHDR* );
@@ -621,6 +621,59 @@ static inline void start_all_cpus()
     RELEASE_INTLOCK( NULL );
 }
 
+/*-------------------------------------------------------------------*/
+/* Suspend/resume: note that a storage frame might have changed      */
+/*-------------------------------------------------------------------*/
+/*                                                                   */
+/* Done for every store that might modify storage while the srdirty  */
+/* array is allocated, which is only after "resume ... INCREMENTAL"  */
+/* or during a live suspend.  The flag for a frame is set whenever   */
+/* the frame might be changed and is cleared again by suspend when   */
+/* it writes the frame, so that an incremental suspend file need     */
+/* only contain the flagged frames.  The storage key change bit      */
+/* cannot be used for this as the guest is free to reset it with     */
+/* SSKE or PFMF.                                                     */
+/*                                                                   */
+/* While no array is allocated the only cost to a store is the test  */
+/* of the array pointer, a load and a well-predicted branch.  The    */
+/* store hooks of the withdrawn translation block cache cost no more */
+/* than this while it was off; the cache was dropped because it      */
+/* never ran faster than the normal dispatch, not for its hooks.     */
+/*                                                                   */
+/* Stores by absolute address, mostly by the channel subsystem, are  */
+/* flagged in the separate srabs array.  These may flag the frame    */
+/* before the data is actually moved and are not bounded by a CPU's  */
+/* instruction, so a live suspend writes such frames again once the  */
+/* CPUs are stopped and the I/O has finished.                        */
+/*                                                                   */
+/*-------------------------------------------------------------------*/
+#define SR_STORE_ABS( _abs )                                          \
+  do                                                                  \
+  {                                                                   \
+    BYTE*  _flags  = sysblk.srabs;                                    \
+    if (unlikely( _flags != NULL ))                                   \
+    {                                                                 \
+      U64  _frame  = ((U64)(_abs)) >> SHIFT_4K;                       \
+      if (_frame < sysblk.srframes)                                   \
+        _flags[ _frame ] = 1;                                         \
+    }                                                                 \
+  }                                                                   \
+  while (0)
+
+#define SR_STORE_MAIN( _main )                                        \
+  do                                                                  \
+  {                                                                   \
+    BYTE*  _flags  = sysblk.srdirty;                                  \
+    if (unlikely( _flags != NULL ))                                   \
+    {                                                                 \
+      U64  _frame  = ((uintptr_t)(_main) -                            \
+                      (uintptr_t)sysblk.mainstor) >> SHIFT_4K;        \
+      if (_frame < sysblk.srframes)                                   \
+        _flags[ _frame ] = 1;                                         \
+    }                                                                 \
+  }                                                                   \
+  while (0)
+
 /*-------------------------------------------------------------------*/
 #undef asm
 
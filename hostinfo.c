@@ -21,8 +21,245 @@
 #include <sys/sysctl.h>
 #endif
 
+#if defined( __linux__ )
+#include <sys/syscall.h>
+#endif
+
+#if defined( __linux__ ) && defined( SYS_mbind ) && defined( SYS_move_pages )
+  #define HAVE_HOST_NUMA            /* Raw NUMA syscalls; no libnuma */
+  #ifndef MPOL_DEFAULT
+  #define MPOL_DEFAULT      0
+  #endif
+  #ifndef MPOL_INTERLEAVE
+  #define MPOL_INTERLEAVE   3
+  #endif
+  #ifndef MPOL_MF_MOVE
+  #define MPOL_MF_MOVE      (1 << 1)
+  #endif
+  #define NUMA_MASK_LONGS   ((HOST_MAX_NUMA_NODES / (8 * sizeof( unsigned long ))) + 1)
+  #define NUMA_QUERY_PAGES  1024    /* Pages sampled by query        */
+#endif
+
 DLL_EXPORT HOST_INFO  hostinfo;     /* Host system information       */
 
+#if defined( HAVE_HOST_NUMA )
+static cpu_set_t  numa_cpuset[ HOST_MAX_NUMA_NODES ]; /* Node's CPUs  */
+
+/*-------------------------------------------------------------------*/
+/* Build the set of host CPUs of a NUMA node from its CPU list file  */
+/* (e.g. "0-7,16-23").  The whole file is parsed, however long.      */
+/*-------------------------------------------------------------------*/
+static void read_numa_cpuset( FILE* f, cpu_set_t* set )
+{
+    long  lo, hi;
+    int   c;
+
+    CPU_ZERO( set );
+
+    while (fscanf( f, "%ld", &lo ) == 1)
+    {
+        hi = lo;
+        if ((c = fgetc( f )) == '-')
+        {
+            if (fscanf( f, "%ld", &hi ) != 1)
+                break;
+            c = fgetc( f );
+        }
+        for (; lo <= hi && lo < CPU_SETSIZE; lo++)
+            CPU_SET( lo, set );
+        if (c != ',')
+            break;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+/* Discover the host's NUMA nodes and the CPUs belonging to each.    */
+/* Node numbers need not be contiguous, so the node directory is     */
+/* enumerated rather than probed for node0, node1, ...               */
+/*-------------------------------------------------------------------*/
+static void init_numa_hostinfo( HOST_INFO* pHostInfo )
+{
+    bool            present[ HOST_MAX_NUMA_NODES ] = {0};
+    char            path[64];
+    char*           p;
+    char            c;
+    DIR*            dir;
+    struct dirent*  ent;
+    FILE*           f;
+    int             id, node = 0;
+
+    if (!(dir = opendir( "/sys/devices/system/node" )))
+        return;
+
+    while ((ent = readdir( dir )))
+    {
+        if (sscanf( ent->d_name, "node%d%c", &id, &c ) == 1
+            && id >= 0 && id < HOST_MAX_NUMA_NODES)
+            present[ id ] = true;
+    }
+    closedir( dir );
+
+    for (id=0; id < HOST_MAX_NUMA_NODES; id++)
+    {
+        if (!present[ id ])
+            continue;
+
+        MSGBUF( path, "/sys/devices/system/node/node%d/cpulist", id );
+
+        if (!(f = fopen( path, "r" )))
+            continue;
+
+        read_numa_cpuset( f, &numa_cpuset[ node ] );
+
+        /* Keep (the start of) the list for display */
+        rewind( f );
+        p = pHostInfo->numa_cpulist[ node ];
+        if (!fgets( p, sizeof( pHostInfo->numa_cpulist[ node ] ), f ))
+            *p = 0;
+        else if (!strchr( p, '\n' ) && !feof( f ))
+            strcpy( p + sizeof( pHostInfo->numa_cpulist[ node ] ) - 4, "..." );
+        if ((p = strchr( p, '\n' )))
+            *p = 0;
+
+        fclose( f );
+
+        pHostInfo->numa_nodeid[ node++ ] = id;
+    }
+
+    pHostInfo->num_numa_nodes = node;
+}
+
+/*-------------------------------------------------------------------*/
+/* Set of host CPUs of a NUMA node                                   */
+/*-------------------------------------------------------------------*/
+static void numa_node_cpuset( int node, cpu_set_t* set )
+{
+    memcpy( set, &numa_cpuset[ node ], sizeof( cpu_set_t ));
+}
+#endif /* defined( HAVE_HOST_NUMA ) */
+
+/*-------------------------------------------------------------------*/
+/* Restrict a thread to the host CPUs of a NUMA node (-1 = any CPU)  */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int set_thread_numa_node( TID tid, int node )
+{
+#if defined( HAVE_HOST_NUMA )
+    cpu_set_t  set;
+    int        i;
+
+    if (!hostinfo.num_numa_nodes || node >= hostinfo.num_numa_nodes)
+        return EINVAL;
+
+    if (node < 0)
+    {
+        cpu_set_t  nodeset;
+
+        CPU_ZERO( &set );
+        for (i=0; i < hostinfo.num_numa_nodes; i++)
+        {
+            numa_node_cpuset( i, &nodeset );
+            CPU_OR( &set, &set, &nodeset );
+        }
+    }
+    else
+        numa_node_cpuset( node, &set );
+
+    return pthread_setaffinity_np( tid, sizeof( set ), &set );
+#else
+    UNREFERENCED( tid );
+    UNREFERENCED( node );
+    return ENOTSUP;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* Interleave storage across all NUMA nodes, or revert it to the     */
+/* default policy where pages are placed on the node of whichever    */
+/* thread first touches them.  Pages already present are migrated.   */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int set_storage_numa_policy( void* addr, U64 size, bool interleave )
+{
+#if defined( HAVE_HOST_NUMA )
+    unsigned long  mask[ NUMA_MASK_LONGS ] = {0};
+    U64  pagesz = hostinfo.hostpagesz ? hostinfo.hostpagesz : _4K;
+    U64  beg    = ((U64)(uintptr_t) addr + pagesz - 1) & ~(pagesz - 1);
+    U64  end    = ((U64)(uintptr_t) addr + size) & ~(pagesz - 1);
+    int  i;
+
+    if (!hostinfo.num_numa_nodes || end <= beg)
+        return EINVAL;
+
+    if (!interleave)
+        return syscall( SYS_mbind, (void*)(uintptr_t) beg, (unsigned long)(end - beg),
+                        MPOL_DEFAULT, NULL, 0UL, 0U ) ? errno : 0;
+
+    for (i=0; i < hostinfo.num_numa_nodes; i++)
+    {
+        int  id = hostinfo.numa_nodeid[i];
+        mask[ id / (8 * sizeof( unsigned long )) ] |= 1UL << (id % (8 * sizeof( unsigned long )));
+    }
+
+    return syscall( SYS_mbind, (void*)(uintptr_t) beg, (unsigned long)(end - beg),
+                    MPOL_INTERLEAVE, mask, (unsigned long)(HOST_MAX_NUMA_NODES + 1),
+                    (unsigned) MPOL_MF_MOVE ) ? errno : 0;
+#else
+    UNREFERENCED( addr );
+    UNREFERENCED( size );
+    UNREFERENCED( interleave );
+    return ENOTSUP;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* Count on which NUMA node a sample of up to 1024 evenly spaced     */
+/* pages of storage reside.  counts[HOST_MAX_NUMA_NODES] receives    */
+/* the counts per node, indexed like numa_nodeid; the number of      */
+/* sampled pages which are not (yet) present is returned.            */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int query_storage_numa_nodes( void* addr, U64 size, U64* counts )
+{
+#if defined( HAVE_HOST_NUMA )
+    void*  pages [ NUMA_QUERY_PAGES ];
+    int    status[ NUMA_QUERY_PAGES ];
+    U64    pagesz = hostinfo.hostpagesz ? hostinfo.hostpagesz : _4K;
+    U64    npages = size / pagesz;
+    U64    step;
+    int    n, i, j, absent = 0;
+
+    memset( counts, 0, HOST_MAX_NUMA_NODES * sizeof( U64 ));
+
+    if (!npages)
+        return 0;
+
+    n    = (int) MIN( npages, NUMA_QUERY_PAGES );
+    step = npages / n;
+
+    for (i=0; i < n; i++)
+        pages[i] = (BYTE*) addr + ((i * step * pagesz) & ~(pagesz - 1));
+
+    if (syscall( SYS_move_pages, 0, (unsigned long) n, pages, NULL, status, 0 ))
+        return -errno;
+
+    for (i=0; i < n; i++)
+    {
+        /* Status is the host node number; count by node index */
+        for (j=0; j < hostinfo.num_numa_nodes; j++)
+            if (status[i] == hostinfo.numa_nodeid[j])
+                break;
+        if (status[i] >= 0 && j < hostinfo.num_numa_nodes)
+            counts[j]++;
+        else
+            absent++;
+    }
+    return absent;
+#else
+    UNREFERENCED( addr );
+    UNREFERENCED( size );
+    memset( counts, 0, HOST_MAX_NUMA_NODES * sizeof( U64 ));
+    return -ENOTSUP;
+#endif
+}
+
 /*-------------------------------------------------------------------*/
 /* Initialize host system information                                */
 /*-------------------------------------------------------------------*/
@@ -211,6 +448,16 @@ DLL_EXPORT void init_hostinfo ( HOST_INFO* pHostInfo )
 
     pHostInfo->hostpagesz = (U64) HPAGESIZE();
 
+#if defined( HAVE_HOST_NUMA )
+    init_numa_hostinfo( pHostInfo );
+#endif
+
+#if defined( __GNUC__ ) && (defined( __x86_64__ ) || defined( __i386__ ))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports( "avx2" ))
+        pHostInfo->cpu_avx2 = 1;
+#endif
+
     if ( pHostInfo->cachelinesz == 0 )
     {
         pHostInfo->cachelinesz = 64;
@@ -37,10 +37,16 @@ typedef struct HOST_INFO
         int     num_logical_cpu;        /* #of of hyperthreads       */
         int     num_packages;           /* #of physical CPUS         */
 
+#define HOST_MAX_NUMA_NODES  64
+        int     num_numa_nodes;         /* #of NUMA nodes (0=unknown)*/
+        int     numa_nodeid [ HOST_MAX_NUMA_NODES ];     /* Host node#*/
+        char    numa_cpulist[ HOST_MAX_NUMA_NODES ][64]; /* e.g. "0-7" */
+
         int     vector_unit;            /* CPU has vector processor  */
         int     fp_unit;                /* CPU has Floating Point    */
         int     cpu_64bits;             /* CPU is 64 bit             */
         int     cpu_aes_extns;          /* CPU supports aes extension*/
+        int     cpu_avx2;               /* CPU supports AVX2         */
         int     valid_cache_nums;       /* Cache nums are obtained   */
 
         U64     bus_speed;              /* Motherboard BUS Speed   Hz*/
@@ -73,6 +79,17 @@ HI_DLL_IMPORT char*  format_hostinfo ( HOST_INFO* pHostInfo,
                                        char*      pszHostInfoStrBuff,
                                        size_t     nHostInfoStrBuffSiz );
 
+/* Host NUMA node placement of threads and storage                   */
+HI_DLL_IMPORT int  set_thread_numa_node    ( TID tid, int node );
+HI_DLL_IMPORT int  set_storage_numa_policy ( void* addr, U64 size,
+                                             bool interleave );
+HI_DLL_IMPORT int  query_storage_numa_nodes( void* addr, U64 size,
+                                             U64* counts );
+
+/* Host NUMA node an emulated CPU is placed on when pinned           */
+#define HOST_NUMA_NODE( _cpu )                                        \
+    (hostinfo.num_numa_nodes > 1 ? (_cpu) % hostinfo.num_numa_nodes : 0)
+
 /* Hercules Host Information structure  (similar to utsname struct)  */
 
 
@@ -3353,6 +3353,7 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
 
     char   lockopt[16];             // (LOCKED/UNLOCKED work)
     bool   lock_mainstor = false;   // (true == "LOCKED" given)
+    bool   huge_mainstor = false;   // (true == "HUGEPAGES" given)
     int    i, rc;                   // (work)
 
     UNREFERENCED( cmdline );
@@ -3468,6 +3469,10 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
 #endif
         if (strabbrev( "UNLOCKED", lockopt, 3 ))
             lock_mainstor = false;
+        else if (strabbrev( "HUGEPAGES", lockopt, 4 ))
+            huge_mainstor = true;
+        else if (strabbrev( "NOHUGEPAGES", lockopt, 6 ))
+            huge_mainstor = false;
         else
         {
             // "Invalid value %s specified for %s"
@@ -3479,6 +3484,7 @@ int mainsize_cmd( int argc, char* argv[], char* cmdline )
     /* Set lock request ("UNLOCKED" forced when mainsize = 0) */
     if (!mainsize_numpages) lock_mainstor = false;
     sysblk.lock_mainstor =  lock_mainstor;
+    sysblk.huge_mainstor =  huge_mainstor;
 
     /* Update main storage size */
     rc = configure_storage( mainsize_numpages );
@@ -3516,6 +3522,7 @@ char    check[16];
 char   *q_argv[2] = { "qstor", "xpnd" };
 u_int   lockreq = 0;
 u_int   locktype = 0;
+u_int   hugepages = 0;
 
     UNREFERENCED(cmdline);
 
@@ -3613,6 +3620,10 @@ u_int   locktype = 0;
             lockreq = 1;
             locktype = 0;
         }
+        else if (strabbrev("HUGEPAGES", check, 4))
+            hugepages = 1;
+        else if (strabbrev("NOHUGEPAGES", check, 6))
+            hugepages = 0;
         else
         {
             // "Invalid value %s specified for %s"
@@ -3624,6 +3635,7 @@ u_int   locktype = 0;
         sysblk.lock_xpndstor = 0;
     else if (lockreq)
         sysblk.lock_xpndstor = locktype;
+    sysblk.huge_xpndstor = hugepages;
 
     rc = configure_xstorage( xpndsize );
     if (rc >= 0)
@@ -4576,6 +4588,104 @@ int legacysenseid_cmd(int argc, char *argv[], char *cmdline)
     return 0;
 }
 
+/*-------------------------------------------------------------------*/
+/* numa command - host NUMA placement of CPUs and storage            */
+/*-------------------------------------------------------------------*/
+int numa_cmd( int argc, char* argv[], char* cmdline )
+{
+    U64   counts[ HOST_MAX_NUMA_NODES ];
+    U64   sampled;
+    bool  pin        = sysblk.numapin;
+    bool  interleave = sysblk.numaintlv;
+    int   i, rc, absent;
+    char  buf[128];
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    if (argc > 1)
+    {
+        for (i=1; i < argc; i++)
+        {
+                 if (CMD( argv[i], pin,        3 )) pin        = true;
+            else if (CMD( argv[i], nopin,      5 )) pin        = false;
+            else if (CMD( argv[i], interleave, 5 )) interleave = true;
+            else if (CMD( argv[i], local,      5 )) interleave = false;
+            else
+            {
+                // "Invalid argument %s%s"
+                WRMSG( HHC02205, "E", argv[i], "" );
+                return -1;
+            }
+        }
+
+        if ((rc = configure_numa( pin, interleave )) != 0)
+        {
+            // "Error in function %s: %s"
+            WRMSG( HHC01430, "E", "configure_numa()", strerror( rc ));
+            return -1;
+        }
+
+        if (MLVL( VERBOSE ))
+        {
+            MSGBUF( buf, "%s %s", pin        ? "PIN"        : "NOPIN",
+                                  interleave ? "INTERLEAVE" : "LOCAL" );
+            // "%-14s set to %s"
+            WRMSG( HHC02204, "I", argv[0], buf );
+        }
+        return 0;
+    }
+
+    MSGBUF( buf, "CPUs %spinned; storage %s", sysblk.numapin ? "" : "not ",
+        sysblk.numaintlv ? "interleaved" : "placed on first touch" );
+    // "%-14s: %s"
+    WRMSG( HHC02203, "I", argv[0], buf );
+
+    if (!hostinfo.num_numa_nodes)
+    {
+        // "%s" (numa_cmd)
+        WRMSG( HHC02296, "I", "Host NUMA topology is not available" );
+        return 0;
+    }
+
+    /* Show where a sample of main storage currently resides */
+    absent  = query_storage_numa_nodes( sysblk.mainstor, sysblk.mainsize, counts );
+    sampled = MAX( absent, 0 );
+    for (i=0; i < hostinfo.num_numa_nodes; i++)
+        sampled += counts[i];
+
+    for (i=0; i < hostinfo.num_numa_nodes; i++)
+    {
+        MSGBUF( buf, "Node %d: host CPUs %s; main storage %d%%",
+            hostinfo.numa_nodeid[i], hostinfo.numa_cpulist[i],
+            sampled ? (int)(counts[i] * 100 / sampled) : 0 );
+        WRMSG( HHC02296, "I", buf );
+    }
+
+    if (absent > 0)
+    {
+        MSGBUF( buf, "Not yet present: main storage %d%%",
+            (int)(absent * 100 / sampled) );
+        WRMSG( HHC02296, "I", buf );
+    }
+
+    if (sysblk.numapin)
+    {
+        for (i=0; i < sysblk.maxcpu; i++)
+        {
+            if (IS_CPU_ONLINE( i ))
+            {
+                MSGBUF( buf, "%s%02X: node %d",
+                    PTYPSTR( i ), i, HOST_NUMA_NODE( i ));
+                WRMSG( HHC02296, "I", buf );
+            }
+        }
+    }
+
+    return 0;
+}
+
 /*-------------------------------------------------------------------
  * cp_updt command       User code page management
  *
@@ -6563,9 +6673,15 @@ int devtmax_cmd(int argc, char *argv[], char *cmdline)
         release_lock(&sysblk.ioqlock);
     }
     else
+    {
         WRMSG(HHC02242, "I",
             sysblk.devtmax, sysblk.devtnbr, sysblk.devthwm,
             sysblk.devtwait, sysblk.devtunavail );
+        WRMSG(HHC02241, "I",
+            sysblk.devtdisp, sysblk.devtaffine, sysblk.devtqhwm,
+            sysblk.devtdisp ? sysblk.devtwaitus / sysblk.devtdisp : 0,
+            sysblk.devtwaitmax );
+    }
 
     return 0;
 }
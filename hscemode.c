@@ -404,11 +404,13 @@ DLL_EXPORT int aia_cmd( int argc, char* argv[], char* cmdline )
 int tlb_cmd(int argc, char *argv[], char *cmdline)
 {
     int     i;                          /* Index                     */
+    int     w;                          /* TLB way                   */
     int     shift;                      /* Number of bits to shift   */
     int     bytemask;                   /* Byte mask                 */
     U64     pagemask;                   /* Page mask                 */
     int     matches = 0;                /* Number aeID matches       */
     REGS   *regs;
+    TLB    *tlb;
     char    buf[128];
 
 
@@ -434,21 +436,25 @@ int tlb_cmd(int argc, char *argv[], char *cmdline)
     MSGBUF( buf, "tlbID 0x%6.6X mainstor %p",regs->tlbID,regs->mainstor);
     WRMSG(HHC02284, "I", buf);
     WRMSG(HHC02284, "I", "  ix              asd            vaddr              pte   id c p r w ky     main");
-    for (i = 0; i < TLBN; i++)
+    for (w = 0; w < regs->tlbways; w++)
     {
+      tlb = TLB_WAY( regs, w );
+      for (i = 0; i < TLBN; i++)
+      {
         MSGBUF( buf, "%s%3.3X %16.16"PRIX64" %16.16"PRIX64" %16.16"PRIX64" %4.4X %1d %1d %1d %1d %2.2X %8.8X",
-         ((regs->tlb.TLB_VADDR_G(i) & bytemask) == regs->tlbID ? "*" : " "),
-         i,regs->tlb.TLB_ASD_G(i),
-         ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (i << shift)),
-         regs->tlb.TLB_PTE_G(i),(int)(regs->tlb.TLB_VADDR_G(i) & bytemask),
-         regs->tlb.common[i],regs->tlb.protect[i],
-         (regs->tlb.acc[i] & ACC_READ) != 0,(regs->tlb.acc[i] & ACC_WRITE) != 0,
-         regs->tlb.skey[i],
-         (unsigned int)(MAINADDR(regs->tlb.main[i],
-                  ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (unsigned int)(i << shift)))
+         ((tlb->TLB_VADDR_G(i) & bytemask) == regs->tlbID ? "*" : " "),
+         (w * TLBN) + i,tlb->TLB_ASD_G(i),
+         ((tlb->TLB_VADDR_G(i) & pagemask) | (i << shift)),
+         tlb->TLB_PTE_G(i),(int)(tlb->TLB_VADDR_G(i) & bytemask),
+         tlb->common[i],tlb->protect[i],
+         (tlb->acc[i] & ACC_READ) != 0,(tlb->acc[i] & ACC_WRITE) != 0,
+         tlb->skey[i],
+         (unsigned int)(MAINADDR(tlb->main[i],
+                  ((tlb->TLB_VADDR_G(i) & pagemask) | (unsigned int)(i << shift)))
                   - regs->mainstor));
-        matches += ((regs->tlb.TLB_VADDR(i) & bytemask) == regs->tlbID);
+        matches += ((tlb->TLB_VADDR(i) & bytemask) == regs->tlbID);
        WRMSG(HHC02284, "I", buf);
+      }
     }
     MSGBUF( buf, "%d tlbID matches", matches);
     WRMSG(HHC02284, "I", buf);
@@ -465,21 +471,25 @@ int tlb_cmd(int argc, char *argv[], char *cmdline)
         MSGBUF( buf, "SIE: tlbID 0x%4.4x mainstor %p",regs->tlbID,regs->mainstor);
         WRMSG(HHC02284, "I", buf);
         WRMSG(HHC02284, "I", "  ix              asd            vaddr              pte   id c p r w ky       main");
-        for (i = matches = 0; i < TLBN; i++)
+        for (w = matches = 0; w < regs->tlbways; w++)
         {
+          tlb = TLB_WAY( regs, w );
+          for (i = 0; i < TLBN; i++)
+          {
             MSGBUF( buf, "%s%3.3X %16.16"PRIX64" %16.16"PRIX64" %16.16"PRIX64" %4.4X %1d %1d %1d %1d %2.2X %8.8X",
-             ((regs->tlb.TLB_VADDR_G(i) & bytemask) == regs->tlbID ? "*" : " "),
-             i,regs->tlb.TLB_ASD_G(i),
-             ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (i << shift)),
-             regs->tlb.TLB_PTE_G(i),(int)(regs->tlb.TLB_VADDR_G(i) & bytemask),
-             regs->tlb.common[i],regs->tlb.protect[i],
-             (regs->tlb.acc[i] & ACC_READ) != 0,(regs->tlb.acc[i] & ACC_WRITE) != 0,
-             regs->tlb.skey[i],
-             (unsigned int) (MAINADDR(regs->tlb.main[i],
-                     ((regs->tlb.TLB_VADDR_G(i) & pagemask) | (unsigned int)(i << shift)))
+             ((tlb->TLB_VADDR_G(i) & bytemask) == regs->tlbID ? "*" : " "),
+             (w * TLBN) + i,tlb->TLB_ASD_G(i),
+             ((tlb->TLB_VADDR_G(i) & pagemask) | (i << shift)),
+             tlb->TLB_PTE_G(i),(int)(tlb->TLB_VADDR_G(i) & bytemask),
+             tlb->common[i],tlb->protect[i],
+             (tlb->acc[i] & ACC_READ) != 0,(tlb->acc[i] & ACC_WRITE) != 0,
+             tlb->skey[i],
+             (unsigned int) (MAINADDR(tlb->main[i],
+                     ((tlb->TLB_VADDR_G(i) & pagemask) | (unsigned int)(i << shift)))
                     - regs->mainstor));
-            matches += ((regs->tlb.TLB_VADDR(i) & bytemask) == regs->tlbID);
+            matches += ((tlb->TLB_VADDR(i) & bytemask) == regs->tlbID);
            WRMSG(HHC02284, "I", buf);
+          }
         }
         MSGBUF( buf, "SIE: %d tlbID matches", matches);
         WRMSG(HHC02284, "I", buf);
@@ -491,6 +501,127 @@ int tlb_cmd(int argc, char *argv[], char *cmdline)
 }
 
 
+/*-------------------------------------------------------------------*/
+/* tlbways - display or set TLB associativity and statistics         */
+/*-------------------------------------------------------------------*/
+int tlbways_cmd( int argc, char* argv[], char* cmdline )
+{
+    REGS*   regs;
+    U64     total;
+    int     i, ways, rc;
+    BYTE    c;
+    char    buf[128];
+
+    UNREFERENCED( cmdline );
+
+    UPPER_ARGV_0( argv );
+
+    if (argc > 2)
+    {
+        // "Invalid command usage. Type 'help %s' for assistance."
+        WRMSG( HHC02299, "E", argv[0] );
+        return -1;
+    }
+
+    if (argc == 2)
+    {
+        if (CMD( argv[1], reset, 5 ))
+        {
+            for (i=0; i < sysblk.maxcpu; i++)
+            {
+                if (IS_CPU_ONLINE( i ))
+                {
+                    sysblk.regs[i]->tlbhits   = 0;
+                    sysblk.regs[i]->tlbmisses = 0;
+                    sysblk.regs[i]->tlbevicts = 0;
+                    sysblk.regs[i]->tlblhits  = 0;
+                }
+            }
+            return 0;
+        }
+
+        if (0
+            || sscanf( argv[1], "%d%c", &ways, &c ) != 1
+            || (ways != 1 && ways != 2 && ways != 4)
+        )
+        {
+            // "Invalid argument %s%s"
+            WRMSG( HHC02205, "E", argv[1], ": must be 1, 2 or 4" );
+            return -1;
+        }
+
+        /* Ensure all CPUs have been stopped */
+        if (are_any_cpus_started())
+        {
+            // "CPUs must be offline or stopped"
+            WRMSG( HHC02389, "E" );
+            return -1;
+        }
+
+        /* Reallocate the additional ways of every CPU's TLB and
+           purge all of its ways, including way 0 which is kept. */
+        for (i=0, rc=0; i < sysblk.maxcpu; i++)
+        {
+            if (!IS_CPU_ONLINE( i ))
+                continue;
+
+            regs = sysblk.regs[i];
+            rc |= resize_tlb( regs, ways );
+            CLEAR_TLB_WAYS( regs );
+
+            if (GUESTREGS)
+            {
+                rc |= resize_tlb( GUESTREGS, ways );
+                CLEAR_TLB_WAYS( GUESTREGS );
+            }
+        }
+
+        sysblk.tlbways = ways;
+
+        if (rc != 0)
+        {
+            // "Error in function %s: %s"
+            WRMSG( HHC01430, "E", "resize_tlb()", strerror( ENOMEM ));
+            return -1;
+        }
+
+        if (MLVL( VERBOSE ))
+        {
+            // "%-14s set to %s"
+            WRMSG( HHC02204, "I", argv[0], argv[1] );
+        }
+        return 0;
+    }
+
+    MSGBUF( buf, "%d (%d entries)", sysblk.tlbways, sysblk.tlbways * TLBN );
+    // "%-14s: %s"
+    WRMSG( HHC02203, "I", argv[0], buf );
+
+    for (i=0; i < sysblk.maxcpu; i++)
+    {
+        if (!IS_CPU_ONLINE( i ))
+            continue;
+
+        regs  = sysblk.regs[i];
+        total = regs->tlbhits + regs->tlbmisses;
+
+        MSGBUF( buf, "%s%02X: other way hits %"PRIu64" misses %"PRIu64
+            " evictions %"PRIu64" hit ratio %d.%d%%"
+            " large frame hits %"PRIu64,
+            PTYPSTR( i ), i, regs->tlbhits, regs->tlbmisses,
+            regs->tlbevicts,
+            total ? (int)((regs->tlbhits * 1000 / total) / 10) : 0,
+            total ? (int)((regs->tlbhits * 1000 / total) % 10) : 0,
+            regs->tlblhits );
+
+        // "%s" (tlbways_cmd)
+        WRMSG( HHC02295, "I", buf );
+    }
+
+    return 0;
+}
+
+
 #if defined(SIE_DEBUG_PERFMON)
 /*-------------------------------------------------------------------*/
 /* spm - SIE performance monitor table                               */
@@ -1797,6 +1928,8 @@ int ipending_cmd(int argc, char *argv[], char *cmdline)
     WRMSG( HHC00874, "I", test_lock(&sysblk.mainlock) ? "" : "not ", sysblk.mainowner);
     WRMSG( HHC00875, "I", test_lock(&sysblk.intlock) ? "" : "not ", sysblk.intowner);
     WRMSG( HHC00876, "I", test_lock(&sysblk.ioqlock) ? "" : "not ");
+    WRMSG( HHC00877, "I", test_lock(&sysblk.iointqlk) ? "" : "not ",
+        sysblk.iointqlocks, sysblk.iointqwaits, sysblk.iointisc, sysblk.iointqquick );
 
     /*----------------------*/
     /* Channel Report queue */
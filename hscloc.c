@@ -524,6 +524,9 @@ int locate_hostinfo( int argc, char* argv[], char* cmdline )
     MSGBUF( msgbuf, "%-17s = %s", "cpu_aes_extns", pHostInfo->cpu_aes_extns ? "YES" : " NO" );
     WRMSG( HHC90000, "D", msgbuf );
 
+    MSGBUF( msgbuf, "%-17s = %s", "cpu_avx2", pHostInfo->cpu_avx2 ? "YES" : " NO" );
+    WRMSG( HHC90000, "D", msgbuf );
+
     WRMSG( HHC90000, "D", "" );
 
     MSGBUF( msgbuf, "%-17s = %s", "valid_cache_nums", pHostInfo->valid_cache_nums ? "YES" : " NO" );
@@ -532,6 +532,7 @@ char    absorr[8];                      /* Uppercase command         */
 
             /* Update absolute storage */
             regs->mainstor[aaddr] = newval[i];
+            SR_STORE_ABS( aaddr );
 
         } /* end for(i) */
     }
@@ -727,6 +728,7 @@ size_t  totamt;                         /* Total amount to be dumped */
 
             /* Update absolute storage */
             regs->mainstor[aaddr] = newval[i];
+            SR_STORE_ABS( aaddr );
         }
     }
 
@@ -2044,9 +2046,11 @@ DLL_EXPORT REGS* copy_regs( REGS* regs )
 
     /* Perform partial copy and clear the TLB */
     memcpy(  newregs, regs, sysblk.regs_copy_len );
-    memset( &newregs->tlb.vaddr, 0, TLBN * sizeof( DW ));
+    CLEAR_TLB( &newregs->tlb );
 
     newregs->tlbID      = 1;
+    newregs->tlbxway    = NULL;   /* direct-mapped TLB in the copy  */
+    newregs->tlbways    = 1;
     newregs->ghostregs  = 1;      /* indicate these aren't real regs */
     HOST(  newregs )    = newregs;
     GUEST( newregs )    = NULL;
@@ -2058,9 +2062,11 @@ DLL_EXPORT REGS* copy_regs( REGS* regs )
         hostregs = newregs + 1;
 
         memcpy(  hostregs, HOSTREGS, sysblk.regs_copy_len );
-        memset( &hostregs->tlb.vaddr, 0, TLBN * sizeof( DW ));
+        CLEAR_TLB( &hostregs->tlb );
 
         hostregs->tlbID     = 1;
+        hostregs->tlbxway   = NULL;
+        hostregs->tlbways   = 1;
         hostregs->ghostregs = 1;  /* indicate these aren't real regs */
 
         HOST(  hostregs )   = hostregs;
@@ -1453,6 +1453,534 @@ DLL_EXPORT BYTE reverse_bits( BYTE b )
     );
 }
 
+/*-------------------------------------------------------------------*/
+/* Copy whole host vectors for MVCL, MVCLE and MVCOS                 */
+/*-------------------------------------------------------------------*/
+/* Used by concpy_long.  The destination is brought to a vector      */
+/* boundary a byte and then a doubleword at a time, and only aligned */
+/* vector stores are used after that, so every doubleword of the     */
+/* destination is still stored by one host instruction, as it is by  */
+/* the doubleword loop in concpy.  The caller ensures that the       */
+/* destination is not less than 32 bytes to the right of the source  */
+/* (if it is to the right of it at all), so each vector fetched      */
+/* already holds any bytes propagated into it.  AVX2 is used when    */
+/* init_hostinfo found it, SSE2 otherwise.  Returns the number of    */
+/* bytes copied; concpy does whatever is left.                       */
+/*-------------------------------------------------------------------*/
+#if defined( HAVE_HOST_VEC_COPY )
+
+#if defined( __GNUC__ )
+  #include <immintrin.h>
+#endif
+
+#if defined( __GNUC__ )
+__attribute__(( target( "avx2" )))
+#endif
+static int vec_copy_avx2( BYTE* d, const BYTE* s, int n )
+{
+    int  k;
+
+    for (k=0; ((uintptr_t)(d + k) & 31) && n - k >= 8; k += 8)
+        store_dw_noswap( d + k, fetch_dw_noswap( s + k ));
+
+    if ((uintptr_t)(d + k) & 31)
+        return k;
+
+    /* Each vector is stored before the next one is fetched */
+    for (; n - k >= 128; k += 128)
+    {
+        _mm256_store_si256( (__m256i*)(d + k),
+            _mm256_loadu_si256( (const __m256i*)(s + k) ));
+        _mm256_store_si256( (__m256i*)(d + k + 32),
+            _mm256_loadu_si256( (const __m256i*)(s + k + 32) ));
+        _mm256_store_si256( (__m256i*)(d + k + 64),
+            _mm256_loadu_si256( (const __m256i*)(s + k + 64) ));
+        _mm256_store_si256( (__m256i*)(d + k + 96),
+            _mm256_loadu_si256( (const __m256i*)(s + k + 96) ));
+    }
+    for (; n - k >= 32; k += 32)
+        _mm256_store_si256( (__m256i*)(d + k),
+            _mm256_loadu_si256( (const __m256i*)(s + k) ));
+    return k;
+}
+
+static int vec_copy_sse2( BYTE* d, const BYTE* s, int n )
+{
+    int  k = 0;
+
+    if (((uintptr_t) d & 15) && n >= 8)
+    {
+        store_dw_noswap( d, fetch_dw_noswap( s ));
+        k = 8;
+    }
+
+    /* Each vector is stored before the next one is fetched */
+    for (; n - k >= 64; k += 64)
+    {
+        _mm_store_si128( (__m128i*)(d + k),
+            _mm_loadu_si128( (const __m128i*)(s + k) ));
+        _mm_store_si128( (__m128i*)(d + k + 16),
+            _mm_loadu_si128( (const __m128i*)(s + k + 16) ));
+        _mm_store_si128( (__m128i*)(d + k + 32),
+            _mm_loadu_si128( (const __m128i*)(s + k + 32) ));
+        _mm_store_si128( (__m128i*)(d + k + 48),
+            _mm_loadu_si128( (const __m128i*)(s + k + 48) ));
+    }
+    for (; n - k >= 16; k += 16)
+        _mm_store_si128( (__m128i*)(d + k),
+            _mm_loadu_si128( (const __m128i*)(s + k) ));
+    return k;
+}
+
+DLL_EXPORT int host_vec_copy( BYTE* d, const BYTE* s, int n )
+{
+    int  k;
+
+    for (k=0; ((uintptr_t)(d + k) & 7) && k < n; k++)
+        d[k] = s[k];
+
+    return k + (hostinfo.cpu_avx2 ? vec_copy_avx2( d + k, s + k, n - k )
+                                  : vec_copy_sse2( d + k, s + k, n - k ));
+}
+
+#endif /* defined( HAVE_HOST_VEC_COPY ) */
+
+/*-------------------------------------------------------------------*/
+/* Scan and translate bytes with host vectors (CLCL, TR, TRT, TRTR)  */
+/*-------------------------------------------------------------------*/
+/* These only ever see host storage the caller has already mapped,   */
+/* so page crossings and access exceptions remain the caller's       */
+/* business.  host_vec_neq needs only SSE2.  The translate kernels   */
+/* use AVX2 PSHUFB lookups when init_hostinfo found AVX2, and simply */
+/* loop a byte at a time otherwise or when the operand is short.     */
+/*-------------------------------------------------------------------*/
+#if defined( HAVE_HOST_VEC_SCAN )
+
+/* Index of the lowest and of the highest one bit in a nonzero mask  */
+static INLINE int vec_lsb( U32 m )
+{
+#if defined( _MSVC_ )
+    unsigned long  i;
+    _BitScanForward( &i, m );
+    return (int) i;
+#else
+    return __builtin_ctz( m );
+#endif
+}
+
+static INLINE int vec_msb( U32 m )
+{
+#if defined( _MSVC_ )
+    unsigned long  i;
+    _BitScanReverse( &i, m );
+    return (int) i;
+#else
+    return 31 - __builtin_clz( m );
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+/* Return index of first unequal byte, or n if all are equal         */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int host_vec_neq( const BYTE* m1, const BYTE* m2, int n )
+{
+    int  i;
+    U32  m;
+
+    for (i=0; n - i >= 16; i += 16)
+    {
+        m = 0xFFFF & ~_mm_movemask_epi8( _mm_cmpeq_epi8(
+                _mm_loadu_si128( (const __m128i*)(m1 + i) ),
+                _mm_loadu_si128( (const __m128i*)(m2 + i) )));
+        if (m)
+            return i + vec_lsb( m );
+    }
+    for (; i < n; i++)
+        if (m1[i] != m2[i])
+            break;
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* Translate n bytes in place through a 256 byte table               */
+/*-------------------------------------------------------------------*/
+/* Each 16 byte row of the table is looked up by the low nibble of   */
+/* every byte, and kept only where the high nibble selects that row. */
+/*-------------------------------------------------------------------*/
+#if defined( __GNUC__ )
+__attribute__(( target( "avx2" )))
+#endif
+static int vec_tr_avx2( BYTE* d, int n, const BYTE* tab )
+{
+    __m256i  row[16];
+    __m256i  nib = _mm256_set1_epi8( 0x0F );
+    __m256i  x, lo, hi, res;
+    int      i, r;
+
+    for (r=0; r < 16; r++)
+        row[r] = _mm256_broadcastsi128_si256(
+                     _mm_loadu_si128( (const __m128i*)(tab + 16 * r) ));
+
+    for (i=0; n - i >= 32; i += 32)
+    {
+        x   = _mm256_loadu_si256( (const __m256i*)(d + i) );
+        lo  = _mm256_and_si256( x, nib );
+        hi  = _mm256_and_si256( _mm256_srli_epi16( x, 4 ), nib );
+        res = _mm256_setzero_si256();
+        for (r=0; r < 16; r++)
+            res = _mm256_or_si256( res, _mm256_and_si256(
+                      _mm256_cmpeq_epi8( hi, _mm256_set1_epi8( (char) r )),
+                      _mm256_shuffle_epi8( row[r], lo )));
+        _mm256_storeu_si256( (__m256i*)(d + i), res );
+    }
+    return i;
+}
+
+DLL_EXPORT void host_vec_tr( BYTE* d, int n, const BYTE* tab )
+{
+    int  i = 0;
+
+    /* A table overlapping the operand must see earlier results */
+    if (n >= 32 && hostinfo.cpu_avx2 && (tab + 256 <= d || d + n <= tab))
+        i = vec_tr_avx2( d, n, tab );
+
+    for (; i < n; i++)
+        d[i] = tab[ d[i] ];
+}
+
+/*-------------------------------------------------------------------*/
+/* Find bytes whose function byte in a 256 byte table is nonzero     */
+/*-------------------------------------------------------------------*/
+/* The table is first reduced to a bitmap of its nonzero entries: a  */
+/* 16 byte row for each half of the table, indexed by the low nibble */
+/* of the argument byte, with one bit for each value of the high     */
+/* nibble.  vec_trt_mask then tests 32 argument bytes at once.       */
+/* host_vec_trt returns the index of the leftmost such byte, or n,   */
+/* and host_vec_trtr that of the rightmost one, or -1.               */
+/*-------------------------------------------------------------------*/
+typedef struct VEC_TRT_MAP
+{
+    __m256i  lo;                        /* Bits for high nibble 0-7  */
+    __m256i  hi;                        /* Bits for high nibble 8-F  */
+}
+VEC_TRT_MAP;
+
+#if defined( __GNUC__ )
+__attribute__(( target( "avx2" )))
+#endif
+static INLINE void vec_trt_map( VEC_TRT_MAP* map, const BYTE* tab )
+{
+    __m128i  lo   = _mm_setzero_si128();
+    __m128i  hi   = _mm_setzero_si128();
+    __m128i  zero = _mm_setzero_si128();
+    __m128i  bits;
+    int      r;
+
+    for (r=0; r < 16; r++)
+    {
+        bits = _mm_andnot_si128( _mm_cmpeq_epi8( zero,
+                   _mm_loadu_si128( (const __m128i*)(tab + 16 * r) )),
+                   _mm_set1_epi8( (char)(1 << (r & 7)) ));
+        if (r < 8)
+            lo = _mm_or_si128( lo, bits );
+        else
+            hi = _mm_or_si128( hi, bits );
+    }
+    map->lo = _mm256_broadcastsi128_si256( lo );
+    map->hi = _mm256_broadcastsi128_si256( hi );
+}
+
+#if defined( __GNUC__ )
+__attribute__(( target( "avx2" )))
+#endif
+static INLINE U32 vec_trt_mask( const VEC_TRT_MAP* map, const BYTE* s )
+{
+    __m256i  nib = _mm256_set1_epi8( 0x0F );
+    __m256i  bit = _mm256_setr_epi8( 1, 2, 4, 8, 16, 32, 64, -128,
+                                     1, 2, 4, 8, 16, 32, 64, -128,
+                                     1, 2, 4, 8, 16, 32, 64, -128,
+                                     1, 2, 4, 8, 16, 32, 64, -128 );
+    __m256i  x, lo, hi, set;
+
+    x   = _mm256_loadu_si256( (const __m256i*) s );
+    lo  = _mm256_and_si256( x, nib );
+    hi  = _mm256_and_si256( _mm256_srli_epi16( x, 4 ), nib );
+
+    /* Bit 0x80 of the argument byte picks the half of the table */
+    set = _mm256_blendv_epi8( _mm256_shuffle_epi8( map->lo, lo ),
+                              _mm256_shuffle_epi8( map->hi, lo ), x );
+    set = _mm256_and_si256( set, _mm256_shuffle_epi8( bit, hi ));
+
+    return ~(U32) _mm256_movemask_epi8(
+               _mm256_cmpeq_epi8( set, _mm256_setzero_si256() ));
+}
+
+#if defined( __GNUC__ )
+__attribute__(( target( "avx2" )))
+#endif
+static int vec_trt_avx2( const BYTE* s, int n, const BYTE* tab )
+{
+    VEC_TRT_MAP  map;
+    U32          m;
+    int          i;
+
+    vec_trt_map( &map, tab );
+
+    for (i=0; n - i >= 32; i += 32)
+        if ((m = vec_trt_mask( &map, s + i )))
+            return i + vec_lsb( m );
+    for (; i < n; i++)
+        if (tab[ s[i] ])
+            break;
+    return i;
+}
+
+#if defined( __GNUC__ )
+__attribute__(( target( "avx2" )))
+#endif
+static int vec_trtr_avx2( const BYTE* s, int n, const BYTE* tab )
+{
+    VEC_TRT_MAP  map;
+    U32          m;
+    int          i;
+
+    vec_trt_map( &map, tab );
+
+    for (i=n; i >= 32; i -= 32)
+        if ((m = vec_trt_mask( &map, s + i - 32 )))
+            return i - 32 + vec_msb( m );
+    for (i--; i >= 0; i--)
+        if (tab[ s[i] ])
+            break;
+    return i;
+}
+
+/* Scan the first bytes singly, in case a hit comes early on         */
+#define VEC_TRT_PREFIX      16
+
+DLL_EXPORT int host_vec_trt( const BYTE* s, int n, const BYTE* tab )
+{
+    int  i;
+
+    for (i=0; i < n && i < VEC_TRT_PREFIX; i++)
+        if (tab[ s[i] ])
+            return i;
+
+    if (n - i >= 32 && hostinfo.cpu_avx2)
+        return i + vec_trt_avx2( s + i, n - i, tab );
+
+    for (; i < n; i++)
+        if (tab[ s[i] ])
+            break;
+    return i;
+}
+
+DLL_EXPORT int host_vec_trtr( const BYTE* s, int n, const BYTE* tab )
+{
+    int  i;
+
+    for (i=n-1; i >= 0 && i >= n - VEC_TRT_PREFIX; i--)
+        if (tab[ s[i] ])
+            return i;
+
+    if (i + 1 >= 32 && hostinfo.cpu_avx2)
+        return vec_trtr_avx2( s, i + 1, tab );
+
+    for (; i >= 0; i--)
+        if (tab[ s[i] ])
+            break;
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* String, checksum and Unicode kernels (SRSTU, CUSE, CKSM, CUxx)    */
+/*-------------------------------------------------------------------*/
+/* Like the kernels above these only see storage already mapped by   */
+/* the caller, and only need SSE2.  Characters and fullwords in      */
+/* guest storage are big-endian.                                     */
+/*-------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------*/
+/* Return index of first equal byte, or n if all are unequal         */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int host_vec_eq( const BYTE* m1, const BYTE* m2, int n )
+{
+    int  i;
+    U32  m;
+
+    for (i=0; n - i >= 16; i += 16)
+    {
+        m = _mm_movemask_epi8( _mm_cmpeq_epi8(
+                _mm_loadu_si128( (const __m128i*)(m1 + i) ),
+                _mm_loadu_si128( (const __m128i*)(m2 + i) )));
+        if (m)
+            return i + vec_lsb( m );
+    }
+    for (; i < n; i++)
+        if (m1[i] == m2[i])
+            break;
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return index of first of n halfwords equal to c, or n             */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int host_vec_chr2( const BYTE* s, int n, U16 c )
+{
+    __m128i  v = _mm_set1_epi16( (short)((c >> 8) | (c << 8)) );
+    int      i;
+    U32      m;
+
+    for (i=0; n - i >= 8; i += 8)
+    {
+        m = _mm_movemask_epi8( _mm_cmpeq_epi16( v,
+                _mm_loadu_si128( (const __m128i*)(s + 2 * i) )));
+        if (m)
+            return i + vec_lsb( m ) / 2;
+    }
+    for (; i < n; i++)
+        if (fetch_hw( s + 2 * i ) == c)
+            break;
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* Return the sum of n/4 fullwords as a 64-bit value                 */
+/*-------------------------------------------------------------------*/
+/* Summing without end-around carries and folding the carries back   */
+/* in afterwards gives the same result as CKSM adding them one by    */
+/* one: both are the ones' complement sum.                           */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT U64 host_vec_cksm( const BYTE* s, int n )
+{
+    __m128i  sum  = _mm_setzero_si128();
+    __m128i  zero = _mm_setzero_si128();
+    __m128i  x;
+    U64      part[2];
+    int      i;
+
+    for (i=0; n - i >= 16; i += 16)
+    {
+        /* Swap the bytes of each halfword, then the halfwords */
+        x = _mm_loadu_si128( (const __m128i*)(s + i) );
+        x = _mm_or_si128( _mm_slli_epi16( x, 8 ), _mm_srli_epi16( x, 8 ));
+        x = _mm_shufflehi_epi16( _mm_shufflelo_epi16( x, 0xB1 ), 0xB1 );
+
+        sum = _mm_add_epi64( sum, _mm_unpacklo_epi32( x, zero ));
+        sum = _mm_add_epi64( sum, _mm_unpackhi_epi32( x, zero ));
+    }
+    _mm_storeu_si128( (__m128i*) part, sum );
+    part[0] += part[1];
+
+    for (; n - i >= 4; i += 4)
+        part[0] += fetch_fw( s + i );
+    return part[0];
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert leading ASCII bytes to 2 or 4 byte characters             */
+/*-------------------------------------------------------------------*/
+/* Converts bytes below X'80' from s to UTF-16 (size 2) or UTF-32    */
+/* (size 4) characters at d, stopping at the first other byte or     */
+/* after n bytes.  Returns the number of bytes converted.            */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int host_vec_ascii_widen( BYTE* d, const BYTE* s, int n, int size )
+{
+    __m128i  zero = _mm_setzero_si128();
+    __m128i  x, lo, hi;
+    int      i;
+
+    for (i=0; n - i >= 16; i += 16)
+    {
+        x = _mm_loadu_si128( (const __m128i*)(s + i) );
+        if (_mm_movemask_epi8( x ))
+            break;
+
+        lo = _mm_unpacklo_epi8( zero, x );
+        hi = _mm_unpackhi_epi8( zero, x );
+        if (size == 2)
+        {
+            _mm_storeu_si128( (__m128i*)(d + 2 * i),      lo );
+            _mm_storeu_si128( (__m128i*)(d + 2 * i + 16), hi );
+        }
+        else
+        {
+            _mm_storeu_si128( (__m128i*)(d + 4 * i),      _mm_unpacklo_epi16( zero, lo ));
+            _mm_storeu_si128( (__m128i*)(d + 4 * i + 16), _mm_unpackhi_epi16( zero, lo ));
+            _mm_storeu_si128( (__m128i*)(d + 4 * i + 32), _mm_unpacklo_epi16( zero, hi ));
+            _mm_storeu_si128( (__m128i*)(d + 4 * i + 48), _mm_unpackhi_epi16( zero, hi ));
+        }
+    }
+    for (; i < n && s[i] < 0x80; i++)
+    {
+        if (size == 2)
+            store_hw( d + 2 * i, s[i] );
+        else
+            store_fw( d + 4 * i, s[i] );
+    }
+    return i;
+}
+
+/*-------------------------------------------------------------------*/
+/* Convert leading 2 or 4 byte ASCII characters to bytes             */
+/*-------------------------------------------------------------------*/
+/* Converts UTF-16 (size 2) or UTF-32 (size 4) characters below X'80'*/
+/* from s to single bytes at d, stopping at the first other char or  */
+/* after n chars.  Returns the number of characters converted.       */
+/*-------------------------------------------------------------------*/
+DLL_EXPORT int host_vec_ascii_narrow( BYTE* d, const BYTE* s, int n, int size )
+{
+    __m128i  zero = _mm_setzero_si128();
+    __m128i  x0, x1, x2, x3, any;
+    int      i;
+    U32      c;
+
+    for (i=0; n - i >= 16; i += 16)
+    {
+        if (size == 2)
+        {
+            x0  = _mm_loadu_si128( (const __m128i*)(s + 2 * i) );
+            x1  = _mm_loadu_si128( (const __m128i*)(s + 2 * i + 16) );
+            any = _mm_and_si128( _mm_or_si128( x0, x1 ),
+                                 _mm_set1_epi16( (short) 0x80FF ));
+            if (_mm_movemask_epi8( _mm_cmpeq_epi8( any, zero )) != 0xFFFF)
+                break;
+
+            x0 = _mm_packus_epi16( _mm_srli_epi16( x0, 8 ),
+                                   _mm_srli_epi16( x1, 8 ));
+        }
+        else
+        {
+            x0  = _mm_loadu_si128( (const __m128i*)(s + 4 * i) );
+            x1  = _mm_loadu_si128( (const __m128i*)(s + 4 * i + 16) );
+            x2  = _mm_loadu_si128( (const __m128i*)(s + 4 * i + 32) );
+            x3  = _mm_loadu_si128( (const __m128i*)(s + 4 * i + 48) );
+            any = _mm_and_si128( _mm_or_si128( _mm_or_si128( x0, x1 ),
+                                               _mm_or_si128( x2, x3 )),
+                                 _mm_set1_epi32( (int) 0x80FFFFFF ));
+            if (_mm_movemask_epi8( _mm_cmpeq_epi8( any, zero )) != 0xFFFF)
+                break;
+
+            x0 = _mm_packus_epi16(
+                     _mm_packs_epi32( _mm_srli_epi32( x0, 24 ),
+                                      _mm_srli_epi32( x1, 24 )),
+                     _mm_packs_epi32( _mm_srli_epi32( x2, 24 ),
+                                      _mm_srli_epi32( x3, 24 )));
+        }
+        _mm_storeu_si128( (__m128i*)(d + i), x0 );
+    }
+    for (; i < n; i++)
+    {
+        c = (size == 2) ? fetch_hw( s + 2 * i ) : fetch_fw( s + 4 * i );
+        if (c >= 0x80)
+            break;
+        d[i] = (BYTE) c;
+    }
+    return i;
+}
+
+#endif /* defined( HAVE_HOST_VEC_SCAN ) */
+
 /*-------------------------------------------------------------------*/
 /* Format printer cctape information                                 */
 /*-------------------------------------------------------------------*/
@@ -237,6 +237,31 @@ HUT_DLL_IMPORT int initialize_utility( int argc, char* argv[],
 /*-------------------------------------------------------------------*/
 HUT_DLL_IMPORT BYTE reverse_bits( BYTE b );
 
+/*-------------------------------------------------------------------*/
+/*      Copy whole host vectors (SSE2/AVX2) for concpy_long          */
+/*-------------------------------------------------------------------*/
+#if (defined( __GNUC__ ) && defined( __SSE2__ )) || \
+    (defined( _MSVC_ )   && defined( _M_X64 ))
+  #define HAVE_HOST_VEC_COPY
+  HUT_DLL_IMPORT int host_vec_copy( BYTE* d, const BYTE* s, int n );
+#endif
+
+/*-------------------------------------------------------------------*/
+/*  Compare, translate, search and convert with host vectors (SSE2+) */
+/*-------------------------------------------------------------------*/
+#if defined( HAVE_HOST_VEC_COPY )
+  #define HAVE_HOST_VEC_SCAN
+  HUT_DLL_IMPORT int  host_vec_neq ( const BYTE* m1, const BYTE* m2, int n );
+  HUT_DLL_IMPORT void host_vec_tr  ( BYTE* d, int n, const BYTE* tab );
+  HUT_DLL_IMPORT int  host_vec_trt ( const BYTE* s, int n, const BYTE* tab );
+  HUT_DLL_IMPORT int  host_vec_trtr( const BYTE* s, int n, const BYTE* tab );
+  HUT_DLL_IMPORT int  host_vec_eq  ( const BYTE* m1, const BYTE* m2, int n );
+  HUT_DLL_IMPORT int  host_vec_chr2( const BYTE* s, int n, U16 c );
+  HUT_DLL_IMPORT U64  host_vec_cksm( const BYTE* s, int n );
+  HUT_DLL_IMPORT int  host_vec_ascii_widen ( BYTE* d, const BYTE* s, int n, int size );
+  HUT_DLL_IMPORT int  host_vec_ascii_narrow( BYTE* d, const BYTE* s, int n, int size );
+#endif
+
 /*-------------------------------------------------------------------*/
 /* Format printer FCB/CCTAPE information                             */
 /*-------------------------------------------------------------------*/
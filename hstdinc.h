@@ -249,6 +249,12 @@
 #ifdef HAVE_ZLIB_H
   #include <zlib.h>
 #endif
+#if defined( CCKD_ZSTD )
+  #include <zstd.h>
+#endif
+#if defined( CCKD_LZ4 )
+  #include <lz4.h>
+#endif
 #ifdef HAVE_SYS_CAPABILITY_H
   #include <sys/capability.h>
 #endif
@@ -504,6 +504,12 @@ struct REGS {                           /* Processor registers       */
      /* TLB - Translation lookaside buffer                           */
         unsigned int tlbID;             /* Validation identifier     */
         TLB     tlb;                    /* Translation lookaside buf */
+        TLB    *tlbxway;                /* -> TLB ways 1 and up      */
+        int     tlbways;                /* TLB ways in use           */
+        U64     tlbhits;                /* TLB hits (other ways)     */
+        U64     tlbmisses;              /* TLB misses                */
+        U64     tlbevicts;              /* Valid TLB entries evicted */
+        U64     tlblhits;               /* Large frame TLB hits      */
 
         BLOCK_TRAILER;                  /* Name of block  END        */
 };
@@ -599,12 +605,22 @@ struct SYSBLK {
         RADR    mainsize;               /* Main storage size (bytes) */
         BYTE   *mainstor;               /* -> Main storage           */
         BYTE   *storkeys;               /* -> Main storage key array */
+        BYTE   *srdirty;                /* -> Frames changed since   */
+                                        /*    last resume/suspend    */
+        BYTE   *srabs;                  /* -> Same for stores by     */
+                                        /*    absolute address (I/O) */
+        U64     srframes;               /* Frames in above arrays    */
+        char   *srbase;                 /* Last resumed suspend file */
         u_int   lock_mainstor:1;        /* Request mainstor to lock  */
         u_int   mainstor_locked:1;      /* Main storage locked       */
+        u_int   huge_mainstor:1;        /* Request huge page backing */
+        u_int   mainstor_huge:2;        /* HUGEPAGES_xxx obtained    */
         U32     xpndsize;               /* Expanded size in 4K pages */
         BYTE   *xpndstor;               /* -> Expanded storage       */
         u_int   lock_xpndstor:1;        /* Request xpndstor to lock  */
         u_int   xpndstor_locked:1;      /* Expanded storage locked   */
+        u_int   huge_xpndstor:1;        /* Request huge page backing */
+        u_int   xpndstor_huge:2;        /* HUGEPAGES_xxx obtained    */
         U64     todstart;               /* Time of initialisation    */
         U64     cpuid;                  /* CPU identifier for STIDP  */
         U32     cpuserial;              /* CPU serial number         */
@@ -841,6 +857,9 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
 
         int     timerint;               /* microsecs timer interval  */
         int     cfg_timerint;           /* (value defined in config) */
+        int     tlbways;                /* TLB ways per set (TLBWAYS)*/
+        u_int   numapin:1;              /* Pin CPUs to host NUMA node*/
+        u_int   numaintlv:1;            /* Interleave storage (NUMA) */
         char   *pantitle;               /* Alt console panel title   */
 #if defined( OPTION_SCSI_TAPE )
         /* Access to all SCSI fields controlled by sysblk.stape_lock */
@@ -884,6 +903,13 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
         U32     crwcount;               /* #of entries queued        */
         U32     crwindex;               /* CRW queue index           */
         IOINT  *iointq;                 /* I/O interrupt queue       */
+        BYTE    iointisc;               /* ISC mask (as CR6 byte 4)
+                                           of queued interrupts; may
+                                           have excess bits but never
+                                           lacks a queued ISC's bit  */
+        U64     iointqlocks;            /* iointqlk obtained count   */
+        U64     iointqwaits;            /* ... of which contended    */
+        U64     iointqquick;            /* Quick ISC mask exits      */
         DEVBLK *ioq;                    /* I/O queue                 */
         LOCK    ioqlock;                /* I/O queue lock            */
         COND    ioqcond;                /* I/O queue condition       */
@@ -892,6 +918,13 @@ atomic_update64( &sysblk.txf_stats[ contran ? 1 : 0 ].txf_ ## ctr, +1 )
         int     devtmax;                /* Max device threads        */
         int     devthwm;                /* High water mark           */
         int     devtunavail;            /* Count thread unavailable  */
+        int     devtqhwm;               /* I/O queue high water mark */
+        U64     devtdisp;               /* I/Os dispatched from queue*/
+        U64     devtaffine;             /* ... to previous I/O thread*/
+        int     devtskips;              /* Times head of queue was
+                                           passed over in succession */
+        U64     devtwaitus;             /* Total I/O queue wait usecs*/
+        U64     devtwaitmax;            /* Max I/O queue wait usecs  */
         RADR    addrlimval;             /* Address limit value (SAL) */
 #if defined(_FEATURE_VM_BLOCKIO)
         U16     servcode;               /* External interrupt code   */
@@ -1094,6 +1127,7 @@ struct IOINT {                          /* I/O interrupt queue entry */
         IOINT  *next;                   /* -> next interrupt entry   */
         DEVBLK *dev;                    /* -> Device block           */
         int     priority;               /* Device priority           */
+        BYTE    iscmask;                /* ISC bit (as CR6 byte 4)   */
         unsigned int
                 pending:1,              /* 1=Normal interrupt        */
                 pcipending:1,           /* 1=PCI interrupt           */
@@ -1246,6 +1280,8 @@ struct DEVBLK {                         /* Device configuration block*/
         int     bufupdlo;               /* Lowest offset updated     */
         int     bufupdhi;               /* Highest offset updated    */
         U32     bufupd;                 /* 1=Buffer updated          */
+        int     bufrahint;              /* Host readahead advised
+                                           up to this buffer id      */
 
         /*  device cache management fields                           */
 
@@ -1265,6 +1301,8 @@ struct DEVBLK {                         /* Device configuration block*/
         TID     tid;                    /* Thread-id executing CCW   */
         int     priority;               /* I/O q scehduling priority */
         DEVBLK *nextioq;                /* -> next device in I/O q   */
+        TOD     ioqtod;                 /* Time queued on I/O q      */
+        TID     lasttid;                /* Thread-id of previous I/O */
         IOINT   ioint;                  /* Normal i/o interrupt
                                                queue entry           */
         IOINT   pciioint;               /* PCI i/o interrupt
@@ -1300,6 +1338,10 @@ struct DEVBLK {                         /* Device configuration block*/
             int length;
             BYTE *data;
         }       iobuf;
+        BYTE   *iodirect;               /* -> Read data left in the
+                                           handler's own buffer for
+                                           the channel to copy to
+                                           storage, else NULL        */
 
         DEVRCD  *rcd;                   /* Read Configuration Data   */
         DEVSNS  *sns;                   /* Format sense bytes        */
@@ -1694,6 +1736,9 @@ struct DEVBLK {                         /* Device configuration block*/
 
         char   *dasdsfn;                /* Shadow file name          */
         char   *dasdsfx;                /* Pointer to suffix char    */
+        BYTE   *dasdmap[CKD_MAXFILES];  /* -> Mapped image files     */
+        size_t  dasdmapsz[CKD_MAXFILES];/* Mapped image file sizes   */
+        u_int   dasdmmap:1;             /* 1=Map image files         */
 
         /*  Device dependent fields for fbadasd                      */
 
@@ -835,6 +835,7 @@ int     rc;
     sysblk.ostailor = OSTAILOR_DEFAULT;
 
     sysblk.timerint = DEF_TOD_UPDATE_USECS;
+    sysblk.tlbways  = 1;
 
 #if defined( _FEATURE_073_TRANSACT_EXEC_FACILITY )
     sysblk.txf_timerint = sysblk.timerint;
@@ -325,6 +325,17 @@ PMCW    pmcw;                           /* Path management ctl word  */
         dev->priority &= 0xFF00FFFFULL;
         dev->priority |= 0x00800000ULL >> ((dev->pmcw.flag4 & PMCW4_ISC) >> 3);
 
+        /* Interrupts already queued for the device are now presented
+           according to its new interruption subclass */
+        obtain_lock( &sysblk.iointqlk );
+        {
+            dev->ioint.iscmask     =
+            dev->pciioint.iscmask  =
+            dev->attnioint.iscmask = 0x80 >> ((dev->pmcw.flag4 & PMCW4_ISC) >> 3);
+            if (dev->pending || dev->pcipending || dev->attnpending)
+                sysblk.iointisc |= dev->ioint.iscmask;
+        }
+        release_lock( &sysblk.iointqlk );
     }
     release_lock( &dev->lock );
 
@@ -959,6 +959,10 @@ void storage_clear()
         if (sysblk.mainstor) memset( sysblk.mainstor, 0x00, sysblk.mainsize );
         if (sysblk.storkeys) memset( sysblk.storkeys, 0x00, sysblk.mainsize / _STORKEY_ARRAY_UNITSIZE );
         sysblk.main_clear = 1;
+
+        /* Every frame now differs from the last suspend file */
+        if (sysblk.srdirty)
+            memset( sysblk.srdirty, 1, (size_t) sysblk.srframes );
     }
 }
 
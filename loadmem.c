@@ -328,6 +328,8 @@ int loadtext_cmd(int argc, char *argv[], char *cmdline)
                        }
                        ahighaddr = MAX(ahighaddr, lastbyte);                    // Keep track of highsest byte used
                        memcpy(regs->mainstor + aaddr + n, &buf[16], len);
+                       SR_STORE_ABS( aaddr + n );
+                       SR_STORE_ABS( lastbyte );
                     }
                 }
 
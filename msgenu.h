@@ -419,10 +419,10 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00331 "%1d:%04X CCKD file[%d] %s: shadow file check failed, sf command busy on device"
 #define HHC00332 "%1d:%04X CCKD file: display cckd statistics"
 #define HHC00333 "%1d:%04X   32/64       size free  nbr st   reads  writes l2reads    hits switches"
-#define HHC00334 "%1d:%04X                                                      readaheads   misses"
+#define HHC00334 "%1d:%04X                                                      readaheads   misses   useful"
 #define HHC00335 "%1d:%04X ------------------------------------------------------------------------"
 #define HHC00336 "%1d:%04X [*] %s %11.11"PRId64" %3.3"PRId64"%% %4.4"PRId64"    %7.7d %7.7d %7.7d %7.7d  %7.7d"
-#define HHC00337 "%1d:%04X                                                         %7.7d  %7.7d"
+#define HHC00337 "%1d:%04X                                                         %7.7d  %7.7d  %7.7d"
 #define HHC00338 "%1d:%04X %s"
 #define HHC00339 "%1d:%04X [0] %s %11.11"PRId64" %3.3"PRId64"%% %4.4"PRId64" %s %7.7d %7.7d %7.7d"
 #define HHC00340 "%1d:%04X %s"
@@ -467,7 +467,12 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00379 "%1d:%04X CCKD file %s: starting %s level %d%s..."
 #define HHC00380 "%1d:%04X CCKD file %s: %s level %d complete; rc=%d"
 #define HHC00381 "%1d:%04X CCKD file %s: closing device while wrpending=%d cckdioact=%d"
-//efine HHC00382 - HHC00395 (available)
+#define HHC00382 "CCKD free space benchmark: %d free spaces, %d gets and releases in %"PRId64" usecs, %"PRId64" nsecs each"
+#define HHC00383 "CCKD free space benchmark: %s"
+#define HHC00384 "CCKD compression benchmark: %-5s %d tracks, %"PRId64" bytes to %"PRId64" (%d%%), compress %"PRId64" MB/s, uncompress %"PRId64" MB/s"
+#define HHC00385 "CCKD compression benchmark: %s"
+#define HHC00386 "%1d:%04X CCKD file %s: header level %u.%u.%u is not supported"
+//efine HHC00387 - HHC00395 (available)
 #define HHC00396 "%1d:%04X %s" // (cckd_trace)
 //efine HHC00397 (available)
 #define HHC00398 "%s" // (trace table)
@@ -517,7 +522,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00440 "%1d:%04X CKD file %s: updating cyl %d head %d record %d kl %d dl %d"
 #define HHC00441 "%1d:%04X CKD file %s: ipdating cyl %d head %d record %d dl %d"
 #define HHC00442 "%1d:%04X CKD file %s: set file mask %02X"
-//efine HHC00443 (available)
+#define HHC00443 "%1d:%04X CKD file %s: mmap not used: %s"
 //efine HHC00444 (available)
 #define HHC00445 "%1d:%04X CKD file %s: updating cyl %d head %d"
 #define HHC00446 "%1d:%04X CKD file %s: write track error: stat %2.2X"
@@ -576,7 +581,8 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00519 "%1d:%04X FBA file %s: read blkgrp %d offset %"PRId64" len %d"
 #define HHC00520 "%1d:%04X FBA file %s: positioning to 0x%"PRIX64" %"PRId64
 #define HHC00521 "Maximum of %u %s in a 2GB file"
-//efine HHC00522 - HHC00599 (available)
+#define HHC00522 "%1d:%04X FBA file %s: mmap not used: %s"
+//efine HHC00523 - HHC00599 (available)
 
 // scedasd.c
 #define HHC00600 "SCE file %s: error in function %s: %s"
@@ -734,7 +740,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC00874 "mainlock %sheld; owner %4.4x"
 #define HHC00875 "intlock %sheld; owner %4.4x"
 #define HHC00876 "ioq lock %sheld"
-//efine HHC00877 (available)
+#define HHC00877 "iointq lock %sheld; obtained %"PRIu64" times, %"PRIu64" contended; subclasses %2.2X, %"PRIu64" quick exits"
 //efine HHC00878 (available)
 //efine HHC00879 (available)
 #define HHC00880 "device %1d:%04X: status %s"
@@ -1052,7 +1058,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC01431 "Expanded storage support not installed"
 #define HHC01432 "Config file[%d] %s: error in function %s: %s"
 #define HHC01433 "Config file[%d] %s: line is too long"
-//efine HHC01434 (available)
+#define HHC01434 "%s storage is backed by %s"
 #define HHC01435 "Config file %s: will ignore include errors"
 #define HHC01436 "Config file[%d] %s: maximum nesting level %d reached"
 #define HHC01437 "Config file[%d] %s: including file %s"
@@ -1296,7 +1302,15 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02020 "SR: value error, incorrect length"
 #define HHC02021 "SR: string error, incorrect length"
 #define HHC02022 "SR: error loading CRW queue: not enough memory for %d CRWs"
-//efine HHC02023 - HHC02099 (available)
+#define HHC02023 "SR: incremental suspend requires a resume with INCREMENTAL"
+#define HHC02024 "SR: %s %"PRIu64" of %"PRIu64" storage frames, %"PRIu64" bytes, %d threads"
+#define HHC02025 "SR: loading storage from base file %s"
+#define HHC02026 "SR: too many base files, maximum is %d"
+#define HHC02027 "SR: invalid storage chunk at address %16.16"PRIX64
+#define HHC02028 "SR: incremental file %s cannot replace its base file"
+#define HHC02029 "SR: live pass %d wrote %"PRIu64" storage frames, %"PRIu64" bytes, %d threads"
+#define HHC02030 "SR: processors were stopped for %d.%03d seconds, %"PRIu64" storage bytes written in %d passes"
+//efine HHC02031 - HHC02099 (available)
 
 // reserve 021xx: misc
 #define HHC02100 "Logger: log not active"
@@ -1354,7 +1368,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02238 "Device numbers can only be redefined within the same Logical Channel SubSystem"
 #define HHC02239 "command '%s' invalid for device type %04X"
 #define HHC02240 "Processor %s%02X%s"
-//efine HHC02241 (available)
+#define HHC02241 "I/Os dispatched: %"PRIu64", same thread as previous: %"PRIu64", most queued: %d, wait avg: %"PRIu64" usecs, max: %"PRIu64" usecs"
 #define HHC02242 "Max device threads: %d, current: %d, most: %d, waiting: %d, total I/Os queued: %d"
 #define HHC02243 "%1d:%04X reinit rejected; drive not empty"
 #define HHC02244 "%1d:%04X device initialization failed"
@@ -1408,8 +1422,8 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02292 "%s" // icount_cmd
 #define HHC02293 "%s" // history.c: command history
 #define HHC02294 "%s" // cachestats_cmd
-//efine HHC02295 (available)
-//efine HHC02296 (available)
+#define HHC02295 "%s" // tlbways_cmd
+#define HHC02296 "%s" // numa_cmd
 //efine HHC02297 (available)
 #define HHC02298 "%1d:%04X drive is empty"
 #define HHC02299 "Invalid command usage. Type 'help %s' for assistance."
@@ -1873,7 +1887,7 @@ LOGM_DLL_IMPORT int  panel_command_capture( char* cmd, char** resp, bool quiet )
 #define HHC02593 "VOL1 record not readable or locatable"
 #define HHC02594 "Syntax error: %s"
 #define HHC02595 "Shadow file data successfully merged into output"
-//efine HHC02596 (available)
+#define HHC02596 "Preset dictionary of %d bytes trained from %d %ss"
 //efine HHC02597 (available)
 //efine HHC02598 (available)
 //efine HHC02599 (available)
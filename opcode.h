@@ -1374,6 +1374,21 @@ do {                                                                  \
 
 #define TLBIX(_addr) (((VADR_L)(_addr) >> TLB_PAGESHIFT) & TLB_MASK)
 
+/* TLB way _w of a CPU, 0 <= _w < regs->tlbways (see resize_tlb) */
+#define TLB_WAY( _regs, _w )                                          \
+    ((_w) ? &(_regs)->tlbxway[ (_w) - 1 ] : &(_regs)->tlb)
+
+/* Invalidate all entries of all TLB ways in use by a CPU */
+#define CLEAR_TLB_WAYS( _regs )                                       \
+    do {                                                              \
+        int _w;                                                       \
+        for (_w=0; _w < (_regs)->tlbways; _w++)                       \
+            CLEAR_TLB( TLB_WAY( (_regs), _w ));                       \
+    } while (0)
+
+/* Large (1M segment) frame TLB index */
+#define LTLBIX(_addr) (((VADR_L)(_addr) >> 20) & LTLB_MASK)
+
 #define MAINADDR(_main, _addr) \
    (BYTE*)((uintptr_t)(_main) ^ (uintptr_t)(_addr))
 
@@ -1863,6 +1878,7 @@ void z900_process_trace( REGS* regs, BYTE* dest );
 #endif
 
 int cpu_init (int cpu, REGS *regs, REGS *hostregs);
+int resize_tlb( REGS* regs, int ways );
 void ARCH_DEP( perform_io_interrupt ) (REGS *regs);
 void ARCH_DEP( checkstop_config )(void);
 
@@ -200,6 +200,12 @@ inline void ARCH_DEP( _or_storage_key )( U64 abs, BYTE bits, BYTE K )
         BYTE* skey_ptr  = _get_storekey_ptr( abs, K );
         OR_SKEY( skey_ptr, bits );
     }
+
+    /* Storage is being changed: tell suspend/resume */
+    if (bits & STORKEY_CHANGE)
+    {
+        SR_STORE_ABS( abs );
+    }
 }
 
 inline void ARCH_DEP( _or_dev_storage_key )( DEVBLK* dev, U64 abs, BYTE bits, BYTE K )
@@ -217,6 +223,12 @@ inline void ARCH_DEP( _or_dev_storage_key )( DEVBLK* dev, U64 abs, BYTE bits, BY
         BYTE* skey_ptr  = _get_dev_storekey_ptr(  dev, abs, K );
         OR_SKEY( skey_ptr, bits );
     }
+
+    /* Storage is being changed: tell suspend/resume */
+    if (bits & STORKEY_CHANGE)
+    {
+        SR_STORE_ABS( abs );
+    }
 }
 
 /*-------------------------------------------------------------------*/
@@ -65,6 +65,799 @@ DEVBLK *dev;
     return NULL;
 }
 
+/*-------------------------------------------------------------------*/
+/* Main storage save and restore                                     */
+/*                                                                   */
+/* Main storage is written in chunks of SR_CHUNK_SIZE bytes (see the */
+/* description in sr.h).  Suspend has a number of threads each take  */
+/* the next chunk, collect its non-zero (or, for an incremental file */
+/* or live pass, its changed) frames, compress them and then write   */
+/* them as one text unit.  Resume reads the chunk text units and     */
+/* queues them to a number of threads which expand them into main    */
+/* storage while the next ones are being read.                       */
+/*-------------------------------------------------------------------*/
+typedef struct SR_STORAGE
+{
+    LOCK     lock;                      /* Lock for below fields     */
+    COND     cond;                      /* Signalled on queue change */
+    SR_FILE  file;                      /* Suspend/resume file       */
+    U64      mainsize;                  /* Size of saved storage     */
+    U32      chunksize;                 /* Bytes per chunk           */
+    U64      next;                      /* Next chunk to be written  */
+    U64      nchunks;                   /* Number of chunks          */
+    BYTE    *map;                       /* Frames to write, or NULL  */
+                                        /* for all non-zero frames   */
+    BYTE    *queue[SR_MAX_QUEUED];      /* Chunks waiting to be read */
+    U32      queuelen[SR_MAX_QUEUED];   /* Their text unit lengths   */
+    int      head;                      /* Index of oldest entry     */
+    int      count;                     /* Number of entries         */
+    U64      frames;                    /* Frames saved or restored  */
+    U64      bytes;                     /* Bytes of chunk data       */
+    int      rc;                        /* 0 or -1 after any error   */
+    u_int    incr:1;                    /* Incremental file          */
+    u_int    eof:1;                     /* No more chunks to queue   */
+}
+SR_STORAGE;
+
+/* Number of threads to compress or expand storage with */
+static int sr_threads()
+{
+    if (hostinfo.num_procs <= 1)
+        return 1;
+    return MIN( hostinfo.num_procs, SR_MAX_THREADS );
+}
+
+/* Whether a 4K frame of storage contains only zeroes */
+static bool sr_zero_frame( BYTE* frame )
+{
+U64    *dw = (U64*) frame;
+U64     bits;
+int     i;
+
+    for (i = 0; i < 4096 / 8; i += 8)
+    {
+        bits = dw[i+0] | dw[i+1] | dw[i+2] | dw[i+3]
+             | dw[i+4] | dw[i+5] | dw[i+6] | dw[i+7];
+        if (bits)
+            return false;
+    }
+    return true;
+}
+
+/*-------------------------------------------------------------------*/
+/* Suspend: collect, compress and write chunks of main storage       */
+/*-------------------------------------------------------------------*/
+static void* sr_save_storage_thread( void* arg )
+{
+SR_STORAGE *sto = arg;
+BYTE   *hdr;                            /* Chunk header and map      */
+BYTE   *raw;                            /* Frames of the chunk       */
+BYTE   *data;                           /* Data to be written        */
+U32     maplen, rawlen, datalen;        /* Lengths                   */
+U64     chunk, addr, size;              /* Chunk being written       */
+U64     frame;                          /* Frame number              */
+U32     i, nframes;                     /* Frame index, count        */
+BYTE    format;                         /* SR_CHUNK_xxxxx            */
+bool    present;                        /* Frame is to be written    */
+#if defined( HAVE_ZLIB )
+BYTE   *zbuf;                           /* Compressed frames         */
+uLongf  zlen;                           /* Compressed length         */
+#endif
+
+    maplen = sto->chunksize / 4096 / 8;
+    hdr    = malloc( SR_CHUNK_HDRLEN + maplen );
+    raw    = malloc( sto->chunksize );
+#if defined( HAVE_ZLIB )
+    zbuf   = malloc( compressBound( sto->chunksize ));
+    if (!zbuf)
+        goto sr_nomem;
+#endif
+    if (!hdr || !raw)
+        goto sr_nomem;
+
+    for (;;)
+    {
+        obtain_lock( &sto->lock );
+        chunk = sto->next++;
+        if (sto->rc || chunk >= sto->nchunks)
+        {
+            release_lock( &sto->lock );
+            break;
+        }
+        release_lock( &sto->lock );
+
+        addr    = chunk * sto->chunksize;
+        size    = MIN( sto->chunksize, sto->mainsize - addr );
+        nframes = (U32)(size / 4096);
+        rawlen  = 0;
+        memset( hdr, 0, SR_CHUNK_HDRLEN + maplen );
+
+        for (i = 0; i < nframes; i++)
+        {
+            frame   = (addr / 4096) + i;
+            present = sto->map ? sto->map[ frame ]
+                               : !sr_zero_frame( sysblk.mainstor + frame * 4096 );
+            if (!present)
+                continue;
+
+            hdr[ SR_CHUNK_HDRLEN + i / 8 ] |= 0x80 >> (i % 8);
+            memcpy( raw + rawlen, sysblk.mainstor + frame * 4096, 4096 );
+            rawlen += 4096;
+        }
+
+        /* Chunks without changed frames are left out */
+        if (sto->map && !rawlen)
+            continue;
+
+        data    = raw;
+        datalen = rawlen;
+        format  = SR_CHUNK_STORED;
+#if defined( HAVE_ZLIB )
+        zlen = compressBound( sto->chunksize );
+        if (1
+            && rawlen
+            && compress2( zbuf, &zlen, raw, rawlen, Z_BEST_SPEED ) == Z_OK
+            && zlen < rawlen
+        )
+        {
+            data    = zbuf;
+            datalen = (U32) zlen;
+            format  = SR_CHUNK_ZLIB;
+        }
+#endif
+        store_dw( hdr + 0, addr );
+        store_fw( hdr + 8, rawlen );
+        hdr[12] = format;
+        hdr[13] = sto->map ? SR_CHUNK_DELTA : 0;
+
+        obtain_lock( &sto->lock );
+        if (0
+            || sto->rc
+            || sr_write_hdr( (FILE*) sto->file, SR_SYS_MAINCHUNK,
+                             SR_CHUNK_HDRLEN + maplen + datalen ) != 0
+            || (U32)SR_WRITE( hdr, 1, SR_CHUNK_HDRLEN + maplen, sto->file )
+                          != SR_CHUNK_HDRLEN + maplen
+            || (datalen && (U32)SR_WRITE( data, 1, datalen, sto->file ) != datalen)
+        )
+        {
+            if (!sto->rc)
+                sr_write_error_();
+            sto->rc = -1;
+        }
+        sto->frames += rawlen / 4096;
+        sto->bytes  += SR_CHUNK_HDRLEN + maplen + datalen;
+        release_lock( &sto->lock );
+    }
+
+    free( hdr );
+    free( raw );
+#if defined( HAVE_ZLIB )
+    free( zbuf );
+#endif
+    return NULL;
+
+sr_nomem:
+    // "SR: error in function %s: %s"
+    WRMSG( HHC02001, "E", "malloc()", strerror( errno ));
+    obtain_lock( &sto->lock );
+    sto->rc = -1;
+    release_lock( &sto->lock );
+    free( hdr );
+    free( raw );
+#if defined( HAVE_ZLIB )
+    free( zbuf );
+#endif
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Write the non-zero frames of main storage or, if a map is given,  */
+/* the frames flagged in the map.  'pass' is the number of the pass  */
+/* of a live suspend, or zero, and the bytes written are added to    */
+/* 'total'.                                                          */
+/*-------------------------------------------------------------------*/
+static int sr_save_storage( SR_FILE file, BYTE* map, int pass, U64* total )
+{
+SR_STORAGE sto;
+TID     tids[SR_MAX_THREADS];
+int     n, i, rc;
+
+    SR_WRITE_VALUE( file, SR_SYS_MAINCHUNKS, SR_CHUNK_SIZE, sizeof( U32 ));
+
+    memset( &sto, 0, sizeof( sto ));
+    initialize_lock( &sto.lock );
+    initialize_condition( &sto.cond );
+
+    sto.file      = file;
+    sto.mainsize  = sysblk.mainsize;
+    sto.chunksize = SR_CHUNK_SIZE;
+    sto.nchunks   = (sysblk.mainsize + SR_CHUNK_SIZE - 1) / SR_CHUNK_SIZE;
+    sto.map       = map;
+
+    /* The chunks are compressed already */
+    SR_SET_LEVEL( file, SR_LEVEL_NONE );
+
+    n = sr_threads();
+    for (i = 0; i < n; i++)
+    {
+        if ((rc = create_thread( &tids[i], JOINABLE, sr_save_storage_thread,
+                                 &sto, "sr_save_storage" )) != 0)
+        {
+            // "Error in function create_thread(): %s"
+            WRMSG( HHC00102, "E", strerror( rc ));
+            break;
+        }
+    }
+    n = i;
+
+    /* Do the work ourselves if no thread could be created */
+    if (!n)
+        sr_save_storage_thread( &sto );
+
+    for (i = 0; i < n; i++)
+        join_thread( tids[i], NULL );
+
+    SR_SET_LEVEL( file, SR_LEVEL_DEFAULT );
+
+    if (!sto.rc && pass)
+    {
+        // "SR: live pass %d wrote %"PRIu64" storage frames, %"PRIu64" bytes, %d threads"
+        WRMSG( HHC02029, "I", pass, sto.frames, sto.bytes, n ? n : 1 );
+    }
+    else if (!sto.rc)
+    {
+        // "SR: %s %"PRIu64" of %"PRIu64" storage frames, %"PRIu64" bytes, %d threads"
+        WRMSG( HHC02024, "I", "saved", sto.frames, (U64)(sysblk.mainsize / 4096),
+            sto.bytes, n ? n : 1 );
+    }
+    *total += sto.bytes;
+
+    destroy_condition( &sto.cond );
+    destroy_lock( &sto.lock );
+    return sto.rc;
+}
+
+/*-------------------------------------------------------------------*/
+/* Start flagging the frames of main storage which are changed       */
+/*-------------------------------------------------------------------*/
+static int sr_track_changes()
+{
+U64     frames = sysblk.mainsize >> SHIFT_4K;
+BYTE   *flags;
+
+    if (sysblk.srdirty)
+        return 0;
+
+    /* One array for srdirty followed by one for srabs */
+    if (!(flags = calloc( (size_t) frames, 2 )))
+    {
+        // "SR: error in function %s: %s"
+        WRMSG( HHC02001, "E", "calloc()", strerror( errno ));
+        return -1;
+    }
+
+    /* The store hooks test the arrays before srframes */
+    OBTAIN_INTLOCK( NULL );
+    sysblk.srdirty = flags;
+    sysblk.srabs   = flags + frames;
+    RELEASE_INTLOCK( NULL );
+    sysblk.srframes = frames;
+    return 0;
+}
+
+/*-------------------------------------------------------------------*/
+/* Move the flags of the changed frames into a map of the frames to  */
+/* be written, counting them.  Frames flagged in srabs are also      */
+/* flagged in 'late', if given, to be written again at the end.      */
+/*-------------------------------------------------------------------*/
+static U64 sr_take_changes( BYTE* map, BYTE* late )
+{
+U64     i, n = 0;
+
+    for (i = 0; i < sysblk.srframes; i++)
+    {
+        map[i] = 0;
+        if (sysblk.srabs[i])
+        {
+            sysblk.srabs[i] = 0;
+            map[i] = 1;
+            if (late)
+                late[i] = 1;
+        }
+        if (sysblk.srdirty[i])
+        {
+            sysblk.srdirty[i] = 0;
+            map[i] = 1;
+        }
+        n += map[i];
+    }
+    return n;
+}
+
+/* Flag the frames of a map as changed again after an error */
+static void sr_return_changes( BYTE* map )
+{
+U64     i;
+
+    for (i = 0; i < sysblk.srframes; i++)
+        if (map[i])
+            sysblk.srdirty[i] = 1;
+}
+
+/* Number of frames changed since the changes were last taken */
+static U64 sr_count_changes()
+{
+U64     i, n = 0;
+
+    for (i = 0; i < sysblk.srframes; i++)
+        if (sysblk.srdirty[i] || sysblk.srabs[i])
+            n++;
+    return n;
+}
+
+/*-------------------------------------------------------------------*/
+/* Wait until every running CPU has finished the instruction it was  */
+/* executing.  A CPU flags a frame (see SR_STORE_MAIN) before it     */
+/* stores into it, so after flags have been taken the frames must    */
+/* not be copied until any store still pending has been done.        */
+/*-------------------------------------------------------------------*/
+static void sr_cpu_boundary()
+{
+U32     count[ MAX_CPU_ENGS ];          /* Instruction counts        */
+CPU_BITMAP mask = 0;                    /* CPUs still to be seen     */
+int     i;
+
+    OBTAIN_INTLOCK( NULL );
+    for (i = 0; i < sysblk.hicpu; i++)
+    {
+        if (1
+            && IS_CPU_ONLINE( i )
+            && (sysblk.started_mask & CPU_BIT( i ))
+            && !(sysblk.waiting_mask & CPU_BIT( i ))
+        )
+        {
+            count[i] = sysblk.regs[i]->instcount;
+            mask |= CPU_BIT( i );
+        }
+    }
+
+    while (mask)
+    {
+        for (i = 0; i < sysblk.hicpu; i++)
+        {
+            if (1
+                && (mask & CPU_BIT( i ))
+                && (0
+                    || !IS_CPU_ONLINE( i )
+                    || !(sysblk.started_mask & CPU_BIT( i ))
+                    || (sysblk.waiting_mask & CPU_BIT( i ))
+                    || sysblk.regs[i]->instcount != count[i]
+                   )
+            )
+                mask &= ~CPU_BIT( i );
+        }
+        if (mask)
+        {
+            RELEASE_INTLOCK( NULL );
+            usleep( 100 );
+            OBTAIN_INTLOCK( NULL );
+        }
+    }
+    RELEASE_INTLOCK( NULL );
+}
+
+/*-------------------------------------------------------------------*/
+/* Stop flagging the frames of main storage which are changed.  The  */
+/* store hooks fetch the array pointer once, so it may be freed once */
+/* every CPU that could be storing has finished its instruction.     */
+/*-------------------------------------------------------------------*/
+static void sr_untrack_changes()
+{
+BYTE   *flags = sysblk.srdirty;
+
+    if (!flags)
+        return;
+
+    OBTAIN_INTLOCK( NULL );
+    sysblk.srframes = 0;
+    sysblk.srdirty  = NULL;
+    sysblk.srabs    = NULL;
+    RELEASE_INTLOCK( NULL );
+
+    sr_cpu_boundary();
+    free( flags );
+}
+
+/*-------------------------------------------------------------------*/
+/* Resume: expand chunks of main storage as they are read            */
+/*-------------------------------------------------------------------*/
+static int sr_restore_chunk( SR_STORAGE* sto, BYTE* unit, U32 len, BYTE* raw )
+{
+U32     maplen, rawlen, datalen;        /* Lengths                   */
+U64     addr, size;                     /* Chunk being restored      */
+U32     i, nframes, present;            /* Frame index and counts    */
+BYTE   *map, *data, *frame;             /* -> map, data and frame    */
+
+    maplen = sto->chunksize / 4096 / 8;
+    addr   = fetch_dw( unit + 0 );
+    rawlen = fetch_fw( unit + 8 );
+    map    = unit + SR_CHUNK_HDRLEN;
+    data   = map + maplen;
+
+    if (0
+        || len < SR_CHUNK_HDRLEN + maplen
+        || addr % sto->chunksize
+        || addr >= sto->mainsize
+        || rawlen > sto->chunksize
+    )
+        goto sr_chunk_error;
+
+    size    = MIN( sto->chunksize, sto->mainsize - addr );
+    nframes = (U32)(size / 4096);
+    datalen = len - SR_CHUNK_HDRLEN - maplen;
+
+    for (i = 0, present = 0; i < nframes; i++)
+        if (map[ i / 8 ] & (0x80 >> (i % 8)))
+            present++;
+
+    if (rawlen != present * 4096)
+        goto sr_chunk_error;
+
+    switch (unit[12])
+    {
+    case SR_CHUNK_STORED:
+        if (datalen != rawlen)
+            goto sr_chunk_error;
+        break;
+
+#if defined( HAVE_ZLIB )
+    case SR_CHUNK_ZLIB:
+    {
+        uLongf  zlen = rawlen;
+
+        if (0
+            || uncompress( raw, &zlen, data, datalen ) != Z_OK
+            || zlen != rawlen
+        )
+            goto sr_chunk_error;
+        data = raw;
+        break;
+    }
+#endif
+    default:
+        goto sr_chunk_error;
+    }
+
+    for (i = 0; i < nframes; i++)
+    {
+        frame = sysblk.mainstor + addr + (U64)i * 4096;
+
+        if (map[ i / 8 ] & (0x80 >> (i % 8)))
+        {
+            memcpy( frame, data, 4096 );
+            data += 4096;
+        }
+        else if (1
+            && !sto->incr
+            && !(unit[13] & SR_CHUNK_DELTA)
+            && !sr_zero_frame( frame )
+        )
+            memset( frame, 0, 4096 );
+    }
+
+    obtain_lock( &sto->lock );
+    sto->frames += present;
+    sto->bytes  += len;
+    release_lock( &sto->lock );
+    return 0;
+
+sr_chunk_error:
+    // "SR: invalid storage chunk at address %16.16"PRIX64
+    WRMSG( HHC02027, "E", addr );
+    return -1;
+}
+
+static void* sr_restore_storage_thread( void* arg )
+{
+SR_STORAGE *sto = arg;
+BYTE   *unit;                           /* Chunk text unit           */
+U32     len;                            /* Text unit length          */
+BYTE   *raw;                            /* Expanded frames           */
+int     rc;
+
+    raw = malloc( sto->chunksize );
+
+    for (;;)
+    {
+        obtain_lock( &sto->lock );
+        while (!sto->count && !sto->eof)
+            wait_condition( &sto->cond, &sto->lock );
+        if (!sto->count)
+        {
+            release_lock( &sto->lock );
+            break;
+        }
+        unit = sto->queue[ sto->head ];
+        len  = sto->queuelen[ sto->head ];
+        sto->head = (sto->head + 1) % SR_MAX_QUEUED;
+        sto->count--;
+        broadcast_condition( &sto->cond );
+        release_lock( &sto->lock );
+
+        rc = raw ? sr_restore_chunk( sto, unit, len, raw ) : -1;
+        free( unit );
+
+        if (rc)
+        {
+            obtain_lock( &sto->lock );
+            sto->rc = -1;
+            release_lock( &sto->lock );
+        }
+    }
+
+    free( raw );
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+/* Queue a chunk for the restore threads, waiting while queue full   */
+/*-------------------------------------------------------------------*/
+static void sr_queue_chunk( SR_STORAGE* sto, BYTE* unit, U32 len )
+{
+    obtain_lock( &sto->lock );
+    while (sto->count == SR_MAX_QUEUED)
+        wait_condition( &sto->cond, &sto->lock );
+    sto->queue   [ (sto->head + sto->count) % SR_MAX_QUEUED ] = unit;
+    sto->queuelen[ (sto->head + sto->count) % SR_MAX_QUEUED ] = len;
+    sto->count++;
+    broadcast_condition( &sto->cond );
+    release_lock( &sto->lock );
+}
+
+/*-------------------------------------------------------------------*/
+/* Restore main storage from the chunk text units which follow the   */
+/* SR_SYS_MAINCHUNKS text unit just read.  Returns with the header   */
+/* of the first text unit that is not a chunk in *key and *len.      */
+/*-------------------------------------------------------------------*/
+static int sr_restore_storage( SR_FILE file, U32 len, U64 mainsize,
+                               bool incr, U32* key, U32* keylen )
+{
+SR_STORAGE sto;
+TID     tids[SR_MAX_THREADS];
+BYTE   *unit;
+U32     k = 0, l = 0;
+U32     maxlen;                         /* Longest valid chunk       */
+int     n, i, rc;
+
+    memset( &sto, 0, sizeof( sto ));
+    sto.mainsize = mainsize;
+    sto.incr     = incr;
+
+    if (sr_read_value( (FILE*) file, len, &sto.chunksize, sizeof( sto.chunksize )) != 0)
+        return -1;
+
+    if (0
+        || sto.chunksize < 4096 * 8
+        || sto.chunksize > SR_CHUNK_MAXSIZE
+        || sto.chunksize % (4096 * 8)
+    )
+    {
+        char buf1[20];
+        char buf2[20];
+        MSGBUF( buf1, "%u", sto.chunksize );
+        MSGBUF( buf2, "%u", SR_CHUNK_SIZE );
+        // "SR: mismatch in '%s': '%s' found, '%s' expected"
+        WRMSG( HHC02009, "E", "chunk size", buf1, buf2 );
+        return -1;
+    }
+
+    /* No chunk is longer than its header and map followed by its
+       frames in the largest form that compression could produce */
+    maxlen = SR_CHUNK_HDRLEN + sto.chunksize / 4096 / 8;
+#if defined( HAVE_ZLIB )
+    maxlen += (U32) compressBound( sto.chunksize );
+#else
+    maxlen += sto.chunksize;
+#endif
+
+    initialize_lock( &sto.lock );
+    initialize_condition( &sto.cond );
+
+    n = sr_threads();
+    for (i = 0; i < n; i++)
+    {
+        if ((rc = create_thread( &tids[i], JOINABLE, sr_restore_storage_thread,
+                                 &sto, "sr_restore_storage" )) != 0)
+        {
+            // "Error in function create_thread(): %s"
+            WRMSG( HHC00102, "E", strerror( rc ));
+            break;
+        }
+    }
+    n = i;
+
+    for (;;)
+    {
+        if (sr_read_hdr( (FILE*) file, &k, &l ) != 0)
+        {
+            sto.rc = -1;
+            break;
+        }
+        if (k != SR_SYS_MAINCHUNK || sto.rc)
+            break;
+
+        if (l > maxlen)
+        {
+            char buf1[20];
+            char buf2[20];
+            MSGBUF( buf1, "%u", l );
+            MSGBUF( buf2, "<= %u", maxlen );
+            // "SR: mismatch in '%s': '%s' found, '%s' expected"
+            WRMSG( HHC02009, "E", "chunk length", buf1, buf2 );
+            sto.rc = -1;
+            break;
+        }
+
+        if (!(unit = malloc( l )))
+        {
+            // "SR: error in function %s: %s"
+            WRMSG( HHC02001, "E", "malloc()", strerror( errno ));
+            sto.rc = -1;
+            break;
+        }
+        if (sr_read_buf( (FILE*) file, unit, l ) != 0)
+        {
+            free( unit );
+            sto.rc = -1;
+            break;
+        }
+
+        /* Expand it ourselves if no thread could be created */
+        if (!n)
+        {
+            BYTE* raw = malloc( sto.chunksize );
+            if (!raw || sr_restore_chunk( &sto, unit, l, raw ) != 0)
+                sto.rc = -1;
+            free( raw );
+            free( unit );
+        }
+        else
+            sr_queue_chunk( &sto, unit, l );
+    }
+
+    /* Let the threads finish the queued chunks */
+    obtain_lock( &sto.lock );
+    sto.eof = 1;
+    broadcast_condition( &sto.cond );
+    release_lock( &sto.lock );
+
+    for (i = 0; i < n; i++)
+        join_thread( tids[i], NULL );
+
+    if (!sto.rc)
+    {
+        // "SR: %s %"PRIu64" of %"PRIu64" storage frames, %"PRIu64" bytes, %d threads"
+        WRMSG( HHC02024, "I", "restored", sto.frames, (U64)(mainsize / 4096),
+            sto.bytes, n ? n : 1 );
+    }
+
+    destroy_condition( &sto.cond );
+    destroy_lock( &sto.lock );
+
+    *key    = k;
+    *keylen = l;
+    return sto.rc;
+}
+
+/*-------------------------------------------------------------------*/
+/* Restore main storage from the base file of an incremental file    */
+/*-------------------------------------------------------------------*/
+static int sr_restore_base( char* fn, int depth )
+{
+SR_FILE  file;
+U32      key = 0, len = 0;
+U64      mainsize = 0;
+bool     incr = false;
+bool     havehdr = false;
+char     buf[SR_MAX_STRING_LENGTH+1];
+int      rc = 0;
+
+    if (depth > SR_MAX_BASE_DEPTH)
+    {
+        // "SR: too many base files, maximum is %d"
+        WRMSG( HHC02026, "E", SR_MAX_BASE_DEPTH );
+        return -1;
+    }
+
+    // "SR: loading storage from base file %s"
+    WRMSG( HHC02025, "I", fn );
+
+    file = SR_OPEN( fn, "rb" );
+    if (file == NULL)
+    {
+        // "SR: error in function '%s': '%s'"
+        WRMSG( HHC02001, "E", "open()", strerror( errno ));
+        return -1;
+    }
+
+    if (0
+        || sr_read_hdr( (FILE*) file, &key, &len ) != 0
+        || key != SR_HDR_ID
+        || sr_read_string( (FILE*) file, buf, len ) != 0
+        || strcmp( buf, SR_ID )
+    )
+    {
+        // "SR: file identifier error"
+        WRMSG( HHC02006, "E" );
+        rc = -1;
+    }
+
+    /* Only the main storage of the base file is wanted */
+    while (!rc && key != SR_EOF)
+    {
+        if (!havehdr && sr_read_hdr( (FILE*) file, &key, &len ) != 0)
+        {
+            rc = -1;
+            break;
+        }
+        havehdr = false;
+
+        switch (key)
+        {
+        case SR_HDR_BASE:
+            if (sr_read_string( (FILE*) file, buf, len ) != 0)
+                rc = -1;
+            else
+                rc = sr_restore_base( buf, depth + 1 );
+            incr = true;
+            break;
+
+        case SR_SYS_MAINSIZE:
+            rc = sr_read_value( (FILE*) file, len, &mainsize, sizeof( mainsize ));
+            if (!rc && mainsize > sysblk.mainsize)
+            {
+                char buf1[20];
+                char buf2[20];
+                MSGBUF( buf1, "%dM", (U32)(mainsize / (1024*1024)));
+                MSGBUF( buf2, "%dM", (U32)(sysblk.mainsize / (1024*1024)));
+                // "SR: mismatch in '%s': '%s' found, '%s' expected"
+                WRMSG( HHC02009, "E", "mainsize", buf1, buf2 );
+                rc = -1;
+            }
+            break;
+
+        case SR_SYS_MAINSTOR:
+            rc = sr_read_buf( (FILE*) file, sysblk.mainstor, mainsize );
+            key = SR_EOF;
+            break;
+
+        case SR_SYS_MAINCHUNKS:
+            rc = sr_restore_storage( file, len, mainsize, incr, &key, &len );
+            /* (a live suspend file has one group of chunks per pass) */
+            if (key != SR_SYS_MAINCHUNKS)
+                key = SR_EOF;
+            havehdr = true;
+            break;
+
+        case SR_EOF:
+            break;
+
+        default:
+            rc = sr_read_skip( (FILE*) file, len );
+            break;
+        }
+    }
+
+    if (rc)
+    {
+        // "SR: error processing file '%s'"
+        WRMSG( HHC02004, "E", fn );
+    }
+
+    SR_CLOSE( file );
+    return rc;
+}
+
 int suspend_cmd(int argc, char *argv[],char *cmdline)
 {
 char    *fn = SR_DEFAULT_FILENAME;
@@ -77,9 +870,28 @@ REGS    *regs;
 DEVBLK  *dev;
 IOINT   *ioq;
 BYTE     psw[16];
+bool     incr = false;
+bool     live = false;
+BYTE    *map = NULL;                    /* Frames to write this pass */
+BYTE    *late = NULL;                   /* Frames to write at end    */
+U64      n, k, total = 0;
+int      pass = 0;
+struct   timeval stop;
+bool     tracked = (sysblk.srdirty != NULL); /* Tracked before suspend */
 
     UNREFERENCED(cmdline);
 
+    while (argc > 1)
+    {
+        if (CMD(argv[argc-1], INCREMENTAL, 4))
+            incr = true;
+        else if (CMD(argv[argc-1], LIVE, 4))
+            live = true;
+        else
+            break;
+        argc--;
+    }
+
     if (argc > 2)
     {
         // "SR: too many arguments"
@@ -90,17 +902,90 @@ BYTE     psw[16];
     if (argc == 2)
         fn = argv[1];
 
+    /* Only the frames changed since the resume are written */
+    if (incr)
+    {
+        if (!sysblk.srdirty || !sysblk.srbase)
+        {
+            // "SR: incremental suspend requires a resume with INCREMENTAL"
+            WRMSG(HHC02023, "E");
+            return -1;
+        }
+        if (strcmp(fn, sysblk.srbase) == 0)
+        {
+            // "SR: incremental file %s cannot replace its base file"
+            WRMSG(HHC02028, "E", fn);
+            return -1;
+        }
+    }
+
+    /* Maps of the frames to be written by a pass */
+    if (incr || live)
+    {
+        if (0
+            || sr_track_changes() != 0
+            || !(map  = calloc((size_t)sysblk.srframes, 1))
+            || !(late = calloc((size_t)sysblk.srframes, 1))
+        )
+        {
+            // "SR: error in function '%s': '%s'"
+            WRMSG(HHC02001, "E", "calloc()", strerror(errno));
+            free(map);
+            free(late);
+            if (!tracked)
+                sr_untrack_changes();
+            return -1;
+        }
+    }
+
     file = SR_OPEN (fn, "wb");
     if (file == NULL)
     {
         // "SR: error in function '%s': '%s'"
         WRMSG(HHC02001, "E","open()",strerror(errno));
+        free(map);
+        free(late);
+        if (!tracked)
+            sr_untrack_changes();
         return -1;
     }
 
     TRACE("SR: Begin Suspend Processing...\n");
 
+    /* Write header */
+    TRACE("SR: Writing File Header...\n");
+    SR_WRITE_STRING(file, SR_HDR_ID, SR_ID);
+    SR_WRITE_STRING(file, SR_HDR_VERSION, VERSION);
+    gettimeofday(&tv, NULL); tt = tv.tv_sec;
+    SR_WRITE_STRING(file, SR_HDR_DATE, ctime(&tt));
+    if (incr)
+        SR_WRITE_STRING(file, SR_HDR_BASE, sysblk.srbase);
+    SR_WRITE_VALUE (file,SR_SYS_MAINSIZE,sysblk.mainsize,sizeof(sysblk.mainsize));
+
+    /* Copy main storage while the CPUs are still running, then the
+       frames changed meanwhile, until few enough changes are left  */
+    if (live)
+    {
+        TRACE("SR: Pre-copying MAINSTOR...\n");
+        for (pass = 1;; pass++)
+        {
+            n = sr_take_changes(map, late);
+            sr_cpu_boundary();
+            if (sr_save_storage(file, (pass == 1 && !incr) ? NULL : map,
+                                pass, &total) != 0)
+                goto sr_error_exit;
+            k = sr_count_changes();
+            if (0
+                || pass >= SR_LIVE_MAX_PASSES
+                || k <= SR_LIVE_STOP_FRAMES
+                || (pass > 1 && k >= n)
+            )
+                break;
+        }
+    }
+
     /* Save CPU state and stop all CPU's */
+    gettimeofday(&stop, NULL);
     TRACE("SR: Stopping All CPUs...\n");
     OBTAIN_INTLOCK(NULL);
     started_mask = sysblk.started_mask;
@@ -151,20 +1036,24 @@ BYTE     psw[16];
         WRMSG(HHC02003, "W",dev->devnum);
     }
 
-    /* Write header */
-    TRACE("SR: Writing File Header...\n");
-    SR_WRITE_STRING(file, SR_HDR_ID, SR_ID);
-    SR_WRITE_STRING(file, SR_HDR_VERSION, VERSION);
-    gettimeofday(&tv, NULL); tt = tv.tv_sec;
-    SR_WRITE_STRING(file, SR_HDR_DATE, ctime(&tt));
-
     /* Write system data */
     TRACE("SR: Saving System Data...\n");
     SR_WRITE_STRING(file,SR_SYS_ARCH_NAME, get_arch_name( NULL ));
-    SR_WRITE_VALUE (file,SR_SYS_STARTED_MASK,started_mask,sizeof(started_mask));
-    SR_WRITE_VALUE (file,SR_SYS_MAINSIZE,sysblk.mainsize,sizeof(sysblk.mainsize));
+    /* (values are at most 8 bytes, so a 128 CPU mask is split) */
+    SR_WRITE_VALUE (file,SR_SYS_STARTED_MASK,(U64)started_mask,sizeof(U64));
+#if MAX_CPU_ENGS > 64
+    SR_WRITE_VALUE (file,SR_SYS_STARTED_MASK_HI,(U64)(started_mask >> 64),sizeof(U64));
+#endif
     TRACE("SR: Saving MAINSTOR...\n");
-    SR_WRITE_BUF   (file,SR_SYS_MAINSTOR,sysblk.mainstor,sysblk.mainsize);
+    if (incr || live)
+    {
+        /* (including every frame stored into by I/O meanwhile) */
+        sr_take_changes(map, NULL);
+        for (k = 0; k < sysblk.srframes; k++)
+            map[k] |= late[k];
+    }
+    if (sr_save_storage(file, map, live ? pass + 1 : 0, &total) != 0)
+        goto sr_error_exit;
     SR_WRITE_VALUE (file,SR_SYS_SKEYSIZE,(sysblk.mainsize/_STORKEY_ARRAY_UNITSIZE),sizeof(U32));
     TRACE("SR: Saving Storage Keys...\n");
     SR_WRITE_BUF   (file,SR_SYS_STORKEYS,sysblk.storkeys,sysblk.mainsize/_STORKEY_ARRAY_UNITSIZE);
@@ -346,6 +1235,17 @@ BYTE     psw[16];
     SR_WRITE_HDR(file, SR_EOF, 0);
     SR_CLOSE (file);
 
+    if (live)
+    {
+        gettimeofday(&tv, NULL);
+        i = (int)((tv.tv_sec - stop.tv_sec) * 1000
+                + (tv.tv_usec - stop.tv_usec) / 1000);
+        // "SR: processors were stopped for %d.%03d seconds, %"PRIu64" storage bytes written in %d passes"
+        WRMSG(HHC02030, "I", i / 1000, i % 1000, total, pass + 1);
+    }
+    free(map);
+    free(late);
+
     TRACE("SR: Suspend Complete; shutting down...\n");
 
     /* Shutdown */
@@ -357,6 +1257,18 @@ sr_error_exit:
     // "SR: error processing file '%s'"
     WRMSG(HHC02004, "E", fn);
     SR_CLOSE (file);
+
+    /* The frames not written remain changed, unless the changes
+       were only being tracked for this (live) suspend */
+    if (!tracked)
+        sr_untrack_changes();
+    else if (map)
+    {
+        sr_return_changes(map);
+        sr_return_changes(late);
+    }
+    free(map);
+    free(late);
     return -1;
 }
 
@@ -384,9 +1296,18 @@ char     buf[SR_MAX_STRING_LENGTH+1];
 char     zeros[16];
 S64      dreg;
 int      numconfdev=0;
+bool     incr = false;
+bool     havehdr = false;
+bool     track = false;                 /* Track changed frames      */
 
     UNREFERENCED(cmdline);
 
+    if (argc > 1 && CMD(argv[argc-1], INCREMENTAL, 4))
+    {
+        track = true;
+        argc--;
+    }
+
     if (argc > 2)
     {
         // "SR: too many arguments"
@@ -429,6 +1350,11 @@ int      numconfdev=0;
         goto sr_error_exit;
     }
 
+    /* Forget the changes noted since any previous resume */
+    sr_untrack_changes();
+    free(sysblk.srbase);
+    sysblk.srbase = NULL;
+
     /* Deconfigure all CPUs */
     TRACE("SR: Deconfiguring all CPUs...\n");
     OBTAIN_INTLOCK(NULL);
@@ -441,7 +1367,9 @@ int      numconfdev=0;
 
     while (key != SR_EOF)
     {
-        SR_READ_HDR(file, key, len);
+        if (!havehdr)
+            SR_READ_HDR(file, key, len);
+        havehdr = false;
         switch (key) {
 
         case SR_HDR_DATE:
@@ -457,9 +1385,29 @@ int      numconfdev=0;
             WRMSG(HHC02007, "I", buf);
             break;
 
+        case SR_HDR_BASE:
+            SR_READ_STRING(file, buf, len);
+            if (sr_restore_base(buf, 1) != 0) goto sr_error_exit;
+            incr = true;
+            break;
+
         case SR_SYS_STARTED_MASK:
-            SR_READ_VALUE(file, len, &started_mask, sizeof(started_mask));
+        {
+            U64 value;
+            SR_READ_VALUE(file, len, &value, sizeof(value));
+            started_mask |= (CPU_BITMAP)value;
+            break;
+        }
+
+#if MAX_CPU_ENGS > 64
+        case SR_SYS_STARTED_MASK_HI:
+        {
+            U64 value;
+            SR_READ_VALUE(file, len, &value, sizeof(value));
+            started_mask |= (CPU_BITMAP)value << 64;
             break;
+        }
+#endif
 
         case SR_SYS_ARCH_NAME:
         {
@@ -506,6 +1454,13 @@ int      numconfdev=0;
             SR_READ_BUF(file, sysblk.mainstor, mainsize);
             break;
 
+        case SR_SYS_MAINCHUNKS:
+            TRACE("SR: Restoring MAINSTOR...\n");
+            rc = sr_restore_storage(file, len, mainsize, incr, &key, &len);
+            if (rc < 0) goto sr_error_exit;
+            havehdr = true;
+            break;
+
         case SR_SYS_SKEYSIZE:
             SR_READ_VALUE(file, len, &len, sizeof(len));
             if (len > (U32)(sysblk.mainsize/_STORKEY_ARRAY_UNITSIZE))
@@ -617,6 +1572,8 @@ int      numconfdev=0;
             else
                 ioq->next = &dev->ioint;
             ioq = &dev->ioint;
+            ioq->iscmask = 0xFF;  /* (subclass not yet restored) */
+            sysblk.iointisc = 0xFF;
             dev = NULL;
             lcss = 0;
             break;
@@ -634,6 +1591,8 @@ int      numconfdev=0;
             else
                 ioq->next = &dev->pciioint;
             ioq = &dev->pciioint;
+            ioq->iscmask = 0xFF;  /* (subclass not yet restored) */
+            sysblk.iointisc = 0xFF;
             dev = NULL;
             lcss = 0;
             break;
@@ -651,6 +1610,8 @@ int      numconfdev=0;
             else
                 ioq->next = &dev->attnioint;
             ioq = &dev->attnioint;
+            ioq->iscmask = 0xFF;  /* (subclass not yet restored) */
+            sysblk.iointisc = 0xFF;
             dev = NULL;
             lcss = 0;
             break;
@@ -1394,6 +2355,10 @@ int      numconfdev=0;
 #endif
     machine_check_crwpend();
 
+    /* Note the frames changed from now on for an incremental suspend */
+    if (track)
+        sr_track_changes();
+
     /* Start the CPUs */
     TRACE("SR: Resuming CPUs...\n");
     OBTAIN_INTLOCK(NULL);
@@ -1408,6 +2373,9 @@ int      numconfdev=0;
         }
     RELEASE_INTLOCK(NULL);
 
+    /* The next incremental suspend file is based on this one */
+    sysblk.srbase = strdup(fn);
+
     TRACE("SR: Resume Complete; System Resumed.\n");
     return 0;
 
@@ -127,6 +127,43 @@
  * There may be other instances where the processing of one
  * key requires that another key has been previously processed.
  *
+ * Main storage
+ *
+ * Main storage is saved as one SR_SYS_MAINCHUNK text unit for each
+ * SR_CHUNK_SIZE bytes of storage, preceded by SR_SYS_MAINCHUNKS
+ * giving the chunk size.  A chunk text unit starts with a 16 byte
+ * header:
+ *
+ *   0-7   absolute address of the chunk
+ *   8-11  length of the chunk's frame data when expanded
+ *   12    format of the frame data (SR_CHUNK_STORED or SR_CHUNK_ZLIB)
+ *   13    flags (SR_CHUNK_DELTA)
+ *   14-15 reserved
+ *
+ * followed by a map with one bit for each 4K frame of the chunk and
+ * then the data for the frames whose bit is on.  The chunks are
+ * compressed and expanded by several threads at the same time, so
+ * the order of the chunks in the file is not significant.  Since
+ * the chunks are already compressed the file itself is written
+ * without further compression while they are being written.
+ *
+ * A frame whose bit is off contains all zeroes.  In an incremental
+ * file, which is one with an SR_HDR_BASE key naming the file it is
+ * based on, a frame whose bit is off is instead unchanged from the
+ * base file, and only chunks with at least one changed frame are
+ * present.  The base file is resumed first, as far as its storage
+ * is concerned, when its name is found.  Older files which contain
+ * SR_SYS_MAINSTOR instead are still accepted.
+ *
+ * A live suspend copies main storage while the CPUs are still
+ * running, and then again copies the frames changed meanwhile until
+ * few enough are left to be copied with the CPUs stopped.  Each such
+ * pass is a separate SR_SYS_MAINCHUNKS group of chunks, which must
+ * be restored in the order they appear in the file.  The chunks of
+ * the second and later passes, like those of an incremental file,
+ * have SR_CHUNK_DELTA set: a frame whose bit is off is then left as
+ * it was.
+ *
  */
 
 #ifndef _HERCULES_SR_H
@@ -139,12 +176,25 @@
 #define SR_SKIP_CHUNKSIZE       256
 #define SR_BUF_CHUNKSIZE        (256*1024*1024)
 
+#define SR_CHUNK_SIZE           (1024*1024)
+#define SR_CHUNK_MAXSIZE        (16*1024*1024)
+#define SR_CHUNK_HDRLEN         16
+#define SR_CHUNK_STORED         0
+#define SR_CHUNK_ZLIB           1
+#define SR_CHUNK_DELTA          0x01
+#define SR_MAX_THREADS          16
+#define SR_MAX_QUEUED           (2*SR_MAX_THREADS)
+#define SR_MAX_BASE_DEPTH       16
+#define SR_LIVE_MAX_PASSES      8
+#define SR_LIVE_STOP_FRAMES     256
+
 #define SR_KEY_ID_MASK          0xfff00000
 #define SR_KEY_ID               0xace00000
 
 #define SR_HDR_ID               0xace00000
 #define SR_HDR_VERSION          0xace00001
 #define SR_HDR_DATE             0xace00002
+#define SR_HDR_BASE             0xace00003
 
 #define SR_SYS_MASK             0xfffff000
 #define SR_SYS_STARTED_MASK     0xace10000
@@ -192,6 +242,9 @@
 #define SR_SYS_LPARNUM          0xace10052
 #define SR_SYS_CPUIDFMT         0xace10053
 #define SR_SYS_OPERATION_MODE   0xace10054
+#define SR_SYS_MAINCHUNKS       0xace10055
+#define SR_SYS_MAINCHUNK        0xace10056
+#define SR_SYS_STARTED_MASK_HI  0xace10057
 
 #define SR_SYS_SERVC            0xace11000
 
@@ -468,6 +521,10 @@
  gzseek((gzFile)(_stream), (_offset), (_whence))
 #define SR_CLOSE(_stream) \
  gzclose((gzFile)(_stream))
+#define SR_SET_LEVEL(_stream, _level) \
+ gzsetparams((gzFile)(_stream), (_level), Z_DEFAULT_STRATEGY)
+#define SR_LEVEL_NONE       Z_NO_COMPRESSION
+#define SR_LEVEL_DEFAULT    Z_DEFAULT_COMPRESSION
 #else
 #define SR_DEFAULT_FILENAME "hercules.srf"
 #define SR_FILE FILE *
@@ -481,6 +538,9 @@
  fseek((_stream), (_offset), (_whence))
 #define SR_CLOSE(_stream) \
  fclose((_stream))
+#define SR_SET_LEVEL(_stream, _level)
+#define SR_LEVEL_NONE       0
+#define SR_LEVEL_DEFAULT    0
 #endif
 
 static INLINE int sr_write_hdr    (FILE* file, U32  key,               U32  len);
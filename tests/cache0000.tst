@@ -0,0 +1,89 @@
+*Testcase cache0000: cache entries for device 0000 track 0
+
+# Device 0000 track 0 has cache key 0.  A record on that track is
+# written, another track is read, and the record is read back.  The
+# write goes to a shadow file which is discarded afterwards.
+
+mainsize    1
+numcpu      1
+archlvl     S/390
+sysclear    # must FOLLOW archlvl command!
+
+detach  0000
+attach  0000  3390  "$(testpath)/CCWILS.3390-1.comp-z"  sf=cache0000_0.sf
+sf+0000
+
+r 00=0008000000000200       # Restart New PSW
+r 68=000A00000000DEAD       # Program Check New PSW
+r 78=0008000000000310       # I/O New PSW
+
+r 200=581007B4              # R1 = first subchannel id
+r 204=B2340600              # STSCH
+r 208=47700260              # cc<>0: FAIL
+r 20C=91010605              # device valid?
+r 210=47800220              # no: next subchannel
+r 214=D501060607B8          # device number 0000?
+r 21A=47800228              # yes: found it
+r 21E=0700
+r 220=41110001              # next subchannel
+r 224=47F00204
+r 228=96800605              # enable the subchannel
+r 22C=B2320600              # MSCH
+r 230=47700260              # cc<>0: FAIL
+r 234=412006A0              # write record 1 of track 0
+r 238=45E00300
+r 23C=412006C0              # read track 1
+r 240=45E00300
+r 244=412006E0              # read record 1 of track 0
+r 248=45E00300
+r 24C=D503079007A0          # data read back as written?
+r 252=47700260              # no: FAIL
+r 256=D20307D007A0          # save data read back
+r 25C=820007C0              # Test finished
+r 260=820007C8              # FAIL
+
+r 300=B76607E8              # LCTL: enable all I/O interruption subclasses
+r 304=B2332000              # SSCH
+r 308=47700260              # cc<>0: FAIL
+r 30C=820007E0              # wait for the I/O interrupt
+r 310=B2350640              # TSCH
+r 314=47700260              # cc<>0: FAIL
+r 318=D501064807B0          # channel end and device end?
+r 31E=47700260              # no: FAIL
+r 322=07FE                  # return
+
+r 6A0=000000000000FF0000000700  # ORBs
+r 6C0=000000000000FF0000000720
+r 6E0=000000000000FF0000000740
+
+r 700=0700078040000006      # Seek cyl 0 head 0
+r 708=3100078840000005      # Search ID equal record 1
+r 710=0800070800000000      # TIC *-8
+r 718=0500079020000004      # Write data
+r 720=0700079800000006      # Seek cyl 0 head 1
+r 740=0700078040000006      # Seek cyl 0 head 0
+r 748=3100078840000005      # Search ID equal record 1
+r 750=0800074800000000      # TIC *-8
+r 758=060007A020000004      # Read data
+
+r 780=0000000000000000      # Seek cyl 0 head 0
+r 788=0000000001000000      # Search ID record 1
+r 790=C1C2C3C4              # Data written
+r 798=0000000000010000      # Seek cyl 0 head 1
+r 7B0=0C00                  # Channel end and device end
+r 7B4=0001000000000000      # First subchannel id, device number 0000
+r 7C0=000A000000000000      # Test finished PSW
+r 7C8=000A00000000BAD0      # FAIL PSW
+r 7E0=020A000000000000      # I/O enabled wait PSW
+r 7E8=FF000000              # CR6 value
+
+runtest   1.0
+
+*Compare
+r 7D0.4
+*Want "Record 1 of track 0 read back" C1C2C3C4
+
+sf-0000 nomerge
+detach    0000              # (no longer needed)
+
+*Done
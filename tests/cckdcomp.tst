@@ -0,0 +1,10 @@
+*Testcase cckdcomp: track compression round trip
+
+# 50 synthetic 3390 track images are compressed and uncompressed by
+# every compression algorithm this build supports (zlib, bzip2, zstd
+# and lz4 when built with them) and each must match the original.
+
+*Compare
+cckd compbench=50
+*Info HHC00385I CCKD compression benchmark: all track images round trip
+*Done nowait
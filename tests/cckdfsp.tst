@@ -0,0 +1,11 @@
+*Testcase cckdfsp: free space index consistency
+
+# A scratch file is fragmented into 1000 free spaces and 10000 track
+# image rewrites are simulated, each getting new space and releasing
+# the old.  The free space chain and both trees of the free space
+# index are then checked against each other.
+
+*Compare
+cckd fspbench=1000
+*Info HHC00383I CCKD free space benchmark: free space is consistent
+*Done nowait
@@ -198,6 +198,24 @@ mainsize 64k
 archlvl z/Arch
 *Info 2 HHC17006W MAINSIZE increased to 1M architectural minimum
 
+#-------------------------------------------------------------------------------
+# Huge page backing falls back to ordinary pages if none are available
+
+* Test 26
+
+mainsize 4 hugepages
+*Info HHC17003I MAIN     storage is 4M (mainsize); storage is not locked
+
+* Test 27
+
+mainsize 1 huge nohuge
+*Info HHC17003I MAIN     storage is 1M (mainsize); storage is not locked
+
+* Test 28
+
+mainsize 1 hug
+*Error HHC01451E Invalid value hug specified for MAINSIZE
+
 *Done nowait
 
 #-------------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+*Testcase mvc-001: MVC and MVCL copy, propagation and page crossing
+
+# X'2000' bytes at X'10000' are set to the low byte of their offset.
+# They are then moved with MVC to a destination three bytes past a
+# doubleword boundary, and across a page boundary, and with MVCL
+# to a destination which crosses two page boundaries.  MVC is also
+# used to propagate one byte (destination one byte to the right of
+# the source) and a 16 byte pattern (destination 16 bytes to the
+# right of the source), which must be done as if one byte at a time.
+#
+#   1000  LHI   R12,X'1000'
+#   1004  LLILH R5,X'0001'          R5 -> X'10000'
+#   1008  LHI   R2,0
+#   100C  LHI   R3,X'2000'
+#   1010  STC   R2,0(R2,R5)         LOOP
+#   1014  AHI   R2,1
+#   1018  BCT   R3,LOOP
+#   101C  LLILH R6,X'0002'          R6 -> X'20000'
+#   1020  MVC   3(256,R6),0(R5)
+#   1026  MVC   X'F80'(256,R6),0(R5)
+#   102C  MVI   X'400'(R6),X'C1'
+#   1030  MVC   X'401'(255,R6),X'400'(R6)
+#   1036  MVC   X'600'(16,R6),0(R5)
+#   103C  MVC   X'610'(240,R6),X'600'(R6)
+#   1042  LLILH R8,X'0003'
+#   1046  AHI   R8,3                R8 -> X'30003'
+#   104A  LHI   R9,X'2000'
+#   104E  LR    R10,R5
+#   1050  LHI   R11,X'2000'
+#   1054  MVCL  R8,R10
+#   1056  LPSWE WAITPSW
+#   1060  WAITPSW  DC  X'00020001800000000000000000000000'
+
+sysclear
+archmode z
+r  1A0=00000001800000000000000000001000
+r 1000=A7C81000A55E0001A7280000A738200042225000A72A00014630C010A56E0002
+r 1020=D2FF60035000D2FF6F80500092C16400D2FE64016400D20F66005000D2EF6610
+r 1040=6600A58E0003A78A0003A798200018A5A7B820000E8AB2B2C060
+r 1060=00020001800000000000000000000000
+runtest .1
+*Compare
+gpr
+*Gpr 8 0000000000032003
+*Gpr 9 0000000000000000
+#                            0 1 2 3  4 5 6 7  8 9 A B  C D E F
+r 20000.10
+*Want "MVC start"           00000000 01020304 05060708 090A0B0C
+r 200F0.10
+*Want "MVC"                 EDEEEFF0 F1F2F3F4 F5F6F7F8 F9FAFBFC
+r 20100.10
+*Want "MVC end"             FDFEFF00 00000000 00000000 00000000
+r 20FF0.10
+*Want "MVC page cross"      70717273 74757677 78797A7B 7C7D7E7F
+r 21000.10
+*Want "MVC page cross"      80818283 84858687 88898A8B 8C8D8E8F
+r 21070.10
+*Want "MVC page cross end"  F0F1F2F3 F4F5F6F7 F8F9FAFB FCFDFEFF
+r 20400.10
+*Want "Propagate start"     C1C1C1C1 C1C1C1C1 C1C1C1C1 C1C1C1C1
+r 204F0.10
+*Want "Propagate end"       C1C1C1C1 C1C1C1C1 C1C1C1C1 C1C1C1C1
+r 20500.10
+*Want "Propagate end"       00000000 00000000 00000000 00000000
+r 206F0.10
+*Want "Pattern end"         00010203 04050607 08090A0B 0C0D0E0F
+r 30FF0.10
+*Want "MVCL first cross"    EDEEEFF0 F1F2F3F4 F5F6F7F8 F9FAFBFC
+r 31000.10
+*Want "MVCL first cross"    FDFEFF00 01020304 05060708 090A0B0C
+r 31FF0.10
+*Want "MVCL second cross"   EDEEEFF0 F1F2F3F4 F5F6F7F8 F9FAFBFC
+r 32000.10
+*Want "MVCL end"            FDFEFF00 00000000 00000000 00000000
+*Done
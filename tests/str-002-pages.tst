@@ -0,0 +1,293 @@
+*Testcase str-002-pages: CKSM, SRST, SRSTU, CUSE and CUxx across page boundaries
+
+# X'4000' bytes at X'10000' are set to the low 7 bits of their
+# offset.  Then, saving three registers and the IPM result after
+# each at X'30000' etc.:
+#
+#   CKSM  X'203' bytes at X'10F02', once to the end of the page with
+#         CC 3, then until done.  The last word crosses into X'11000'
+#         and the last three bytes are padded.
+#   SRST  from X'11030' for X'20', found at X'110A0'; for X'80', which
+#         ends at X'11200' with CC 2, and again with the end address
+#         behind, which stops with CC 3 at the page boundary.
+#   SRSTU from X'11001' for X'4142', found at X'11041'; from X'11000',
+#         which ends at X'11100'; and from X'11F80' with CC 3 after
+#         256 characters, past the page boundary.
+#   CUSE  X'1800' bytes at X'10000' and X'12001' which are never
+#         equal, stopping with CC 3 after 4096 bytes; then X'200' bytes
+#         at X'10F80' and X'12F81' with three equal bytes put at
+#         X'13011'.
+#   CU14  X'180' bytes of UTF-8 at X'11F00' to X'40000', with a
+#         Euro sign (X'E282AC') put at X'12040'.
+#   CU41  the result back to UTF-8 at X'42F80'.
+#   CU12  the same UTF-8 to UTF-16 at X'44000'.
+#   CU21  that back to UTF-8 at X'45F80'.
+#
+#   1000  LHI   R12,X'1000'
+#   1004  LLILH R5,X'0001'
+#   1008  LHI   R2,0
+#   100C  LHI   R3,X'4000'
+#   1010  LR    R4,R2                 LOOP
+#   1012  NILL  R4,X'007F'
+#   1016  STC   R4,0(R2,R5)
+#   101A  AHI   R2,X'1'
+#   101E  BCT   R3,LOOP
+#   1022  LLILH R13,X'0003'
+#   1026  LHI   R6,0
+#   102A  LLILH R8,X'0001'
+#   102E  AHI   R8,X'F02'
+#   1032  LHI   R9,X'203'
+#   1036  CKSM  R6,R8
+#   103A  IPM   R11
+#   103E  ST    R6,0(R13)
+#   1042  ST    R8,4(R13)
+#   1046  ST    R9,8(R13)
+#   104A  ST    R11,12(R13)
+#   104E  AHI   R13,X'10'
+#   1052  CKSM  R6,R8
+#   1056  BRC   1,*-4
+#   105A  IPM   R11
+#   105E  ST    R6,0(R13)
+#   1062  ST    R8,4(R13)
+#   1066  ST    R9,8(R13)
+#   106A  ST    R11,12(R13)
+#   106E  AHI   R13,X'10'
+#   1072  LHI   R0,X'20'
+#   1076  LLILH R1,X'0001'
+#   107A  AHI   R1,X'2000'
+#   107E  LLILH R2,X'0001'
+#   1082  AHI   R2,X'1030'
+#   1086  SRST  R1,R2
+#   108A  IPM   R11
+#   108E  ST    R0,0(R13)
+#   1092  ST    R1,4(R13)
+#   1096  ST    R2,8(R13)
+#   109A  ST    R11,12(R13)
+#   109E  AHI   R13,X'10'
+#   10A2  LHI   R0,X'80'
+#   10A6  LLILH R1,X'0001'
+#   10AA  AHI   R1,X'1200'
+#   10AE  LLILH R2,X'0001'
+#   10B2  AHI   R2,X'1030'
+#   10B6  SRST  R1,R2
+#   10BA  IPM   R11
+#   10BE  ST    R0,0(R13)
+#   10C2  ST    R1,4(R13)
+#   10C6  ST    R2,8(R13)
+#   10CA  ST    R11,12(R13)
+#   10CE  AHI   R13,X'10'
+#   10D2  LLILH R1,X'0001'
+#   10D6  LLILH R2,X'0001'
+#   10DA  AHI   R2,X'1030'
+#   10DE  SRST  R1,R2
+#   10E2  IPM   R11
+#   10E6  ST    R0,0(R13)
+#   10EA  ST    R1,4(R13)
+#   10EE  ST    R2,8(R13)
+#   10F2  ST    R11,12(R13)
+#   10F6  AHI   R13,X'10'
+#   10FA  LHI   R0,X'4142'
+#   10FE  LLILH R1,X'0001'
+#   1102  AHI   R1,X'2000'
+#   1106  LLILH R2,X'0001'
+#   110A  AHI   R2,X'1001'
+#   110E  SRSTU R1,R2
+#   1112  IPM   R11
+#   1116  ST    R0,0(R13)
+#   111A  ST    R1,4(R13)
+#   111E  ST    R2,8(R13)
+#   1122  ST    R11,12(R13)
+#   1126  AHI   R13,X'10'
+#   112A  LLILH R1,X'0001'
+#   112E  AHI   R1,X'1100'
+#   1132  LLILH R2,X'0001'
+#   1136  AHI   R2,X'1000'
+#   113A  SRSTU R1,R2
+#   113E  IPM   R11
+#   1142  ST    R0,0(R13)
+#   1146  ST    R1,4(R13)
+#   114A  ST    R2,8(R13)
+#   114E  ST    R11,12(R13)
+#   1152  AHI   R13,X'10'
+#   1156  LLILH R1,X'0001'
+#   115A  LLILH R2,X'0001'
+#   115E  AHI   R2,X'1F80'
+#   1162  SRSTU R1,R2
+#   1166  IPM   R11
+#   116A  ST    R0,0(R13)
+#   116E  ST    R1,4(R13)
+#   1172  ST    R2,8(R13)
+#   1176  ST    R11,12(R13)
+#   117A  AHI   R13,X'10'
+#   117E  LHI   R0,X'3'
+#   1182  LHI   R1,0
+#   1186  LLILH R4,X'0001'
+#   118A  LHI   R5,X'1800'
+#   118E  LLILH R6,X'0001'
+#   1192  AHI   R6,X'2001'
+#   1196  LHI   R7,X'1800'
+#   119A  CUSE  R4,R6
+#   119E  IPM   R11
+#   11A2  ST    R4,0(R13)
+#   11A6  ST    R5,4(R13)
+#   11AA  ST    R6,8(R13)
+#   11AE  ST    R11,12(R13)
+#   11B2  AHI   R13,X'10'
+#   11B6  LLILH R10,X'0001'
+#   11BA  AHI   R10,X'3011'
+#   11BE  MVI   0(R10),X'10'
+#   11C2  LLILH R10,X'0001'
+#   11C6  AHI   R10,X'3012'
+#   11CA  MVI   0(R10),X'11'
+#   11CE  LLILH R10,X'0001'
+#   11D2  AHI   R10,X'3013'
+#   11D6  MVI   0(R10),X'12'
+#   11DA  LLILH R4,X'0001'
+#   11DE  AHI   R4,X'F80'
+#   11E2  LHI   R5,X'200'
+#   11E6  LLILH R6,X'0001'
+#   11EA  AHI   R6,X'2F81'
+#   11EE  LHI   R7,X'200'
+#   11F2  CUSE  R4,R6
+#   11F6  IPM   R11
+#   11FA  ST    R4,0(R13)
+#   11FE  ST    R5,4(R13)
+#   1202  ST    R6,8(R13)
+#   1206  ST    R11,12(R13)
+#   120A  AHI   R13,X'10'
+#   120E  LLILH R10,X'0001'
+#   1212  AHI   R10,X'2040'
+#   1216  MVI   0(R10),X'E2'
+#   121A  LLILH R10,X'0001'
+#   121E  AHI   R10,X'2041'
+#   1222  MVI   0(R10),X'82'
+#   1226  LLILH R10,X'0001'
+#   122A  AHI   R10,X'2042'
+#   122E  MVI   0(R10),X'AC'
+#   1232  LLILH R2,X'0004'
+#   1236  LHI   R3,X'1000'
+#   123A  LLILH R4,X'0001'
+#   123E  AHI   R4,X'1F00'
+#   1242  LHI   R5,X'180'
+#   1246  CU14  R2,R4
+#   124A  IPM   R11
+#   124E  ST    R2,0(R13)
+#   1252  ST    R3,4(R13)
+#   1256  ST    R4,8(R13)
+#   125A  ST    R11,12(R13)
+#   125E  AHI   R13,X'10'
+#   1262  LLILH R6,X'0004'
+#   1266  AHI   R6,X'2F80'
+#   126A  LHI   R7,X'1000'
+#   126E  LLILH R8,X'0004'
+#   1272  LHI   R9,X'5F8'
+#   1276  CU41  R6,R8
+#   127A  IPM   R11
+#   127E  ST    R6,0(R13)
+#   1282  ST    R7,4(R13)
+#   1286  ST    R8,8(R13)
+#   128A  ST    R11,12(R13)
+#   128E  AHI   R13,X'10'
+#   1292  LLILH R2,X'0004'
+#   1296  AHI   R2,X'4000'
+#   129A  LHI   R3,X'1000'
+#   129E  LLILH R4,X'0001'
+#   12A2  AHI   R4,X'1F00'
+#   12A6  LHI   R5,X'180'
+#   12AA  CU12  R2,R4
+#   12AE  IPM   R11
+#   12B2  ST    R2,0(R13)
+#   12B6  ST    R3,4(R13)
+#   12BA  ST    R4,8(R13)
+#   12BE  ST    R11,12(R13)
+#   12C2  AHI   R13,X'10'
+#   12C6  LLILH R6,X'0004'
+#   12CA  AHI   R6,X'5F80'
+#   12CE  LHI   R7,X'1000'
+#   12D2  LLILH R8,X'0004'
+#   12D6  AHI   R8,X'4000'
+#   12DA  LHI   R9,X'2FC'
+#   12DE  CU21  R6,R8
+#   12E2  IPM   R11
+#   12E6  ST    R6,0(R13)
+#   12EA  ST    R7,4(R13)
+#   12EE  ST    R8,8(R13)
+#   12F2  ST    R11,12(R13)
+#   12F6  AHI   R13,X'10'
+#   12FA  LPSWE WAITPSW
+#   1FF0  WAITPSW  DC  X'00020001800000000000000000000000'
+
+sysclear
+archmode z
+r  1A0=00000001800000000000000000001000
+r 1000=A7C81000A55E0001A7280000A73840001842A547007F42425000A72A00014630
+r 1020=C010A5DE0003A7680000A58E0001A78A0F02A7980203B2410068B22200B05060
+r 1040=D0005080D0045090D00850B0D00CA7DA0010B2410068A714FFFEB22200B05060
+r 1060=D0005080D0045090D00850B0D00CA7DA0010A7080020A51E0001A71A2000A52E
+r 1080=0001A72A1030B25E0012B22200B05000D0005010D0045020D00850B0D00CA7DA
+r 10A0=0010A7080080A51E0001A71A1200A52E0001A72A1030B25E0012B22200B05000
+r 10C0=D0005010D0045020D00850B0D00CA7DA0010A51E0001A52E0001A72A1030B25E
+r 10E0=0012B22200B05000D0005010D0045020D00850B0D00CA7DA0010A7084142A51E
+r 1100=0001A71A2000A52E0001A72A1001B9BE0012B22200B05000D0005010D0045020
+r 1120=D00850B0D00CA7DA0010A51E0001A71A1100A52E0001A72A1000B9BE0012B222
+r 1140=00B05000D0005010D0045020D00850B0D00CA7DA0010A51E0001A52E0001A72A
+r 1160=1F80B9BE0012B22200B05000D0005010D0045020D00850B0D00CA7DA0010A708
+r 1180=0003A7180000A54E0001A7581800A56E0001A76A2001A7781800B2570046B222
+r 11A0=00B05040D0005050D0045060D00850B0D00CA7DA0010A5AE0001A7AA30119210
+r 11C0=A000A5AE0001A7AA30129211A000A5AE0001A7AA30139212A000A54E0001A74A
+r 11E0=0F80A7580200A56E0001A76A2F81A7780200B2570046B22200B05040D0005050
+r 1200=D0045060D00850B0D00CA7DA0010A5AE0001A7AA204092E2A000A5AE0001A7AA
+r 1220=20419282A000A5AE0001A7AA204292ACA000A52E0004A7381000A54E0001A74A
+r 1240=1F00A7580180B9B00024B22200B05020D0005030D0045040D00850B0D00CA7DA
+r 1260=0010A56E0004A76A2F80A7781000A58E0004A79805F8B9B20068B22200B05060
+r 1280=D0005070D0045080D00850B0D00CA7DA0010A52E0004A72A4000A7381000A54E
+r 12A0=0001A74A1F00A7580180B2A70024B22200B05020D0005030D0045040D00850B0
+r 12C0=D00CA7DA0010A56E0004A76A5F80A7781000A58E0004A78A4000A79802FCB2A6
+r 12E0=0068B22200B05060D0005070D0045080D00850B0D00CA7DA0010B2B2CFF0
+r 1FF0=00020001800000000000000000000000
+runtest .1
+*Compare
+#                            0 1 2 3  4 5 6 7  8 9 A B  C D E F
+r 30000.10
+*Want "CKSM page end"       91D08FCE 00010FFE 00000107 30000000
+r 30010.10
+*Want "CKSM done"           22A223A0 00011105 00000000 00000000
+r 30020.10
+*Want "SRST found"          00000020 000110A0 00011030 10000000
+r 30030.10
+*Want "SRST end"            00000080 00011200 00011030 20000000
+r 30040.10
+*Want "SRST page end"       00000080 00010000 00012000 30000000
+r 30050.10
+*Want "SRSTU found"         00004142 00011041 00011001 10000000
+r 30060.10
+*Want "SRSTU end"           00004142 00011100 00011000 20000000
+r 30070.10
+*Want "SRSTU 256 chars"     00004142 00010000 00012180 30000000
+r 30080.10
+*Want "CUSE 4096 bytes"     00011000 00000800 00013001 30000000
+r 30090.10
+*Want "CUSE substring"      00011010 00000170 00013011 00000000
+r 300A0.10
+*Want "CU14"                000405F8 00000A08 00012080 00000000
+r 300B0.10
+*Want "CU41"                00043100 00000E80 000405F8 00000000
+r 300C0.10
+*Want "CU12"                000442FC 00000D04 00012080 00000000
+r 300D0.10
+*Want "CU21"                00046100 00000E80 000442FC 00000000
+r 400F0.10
+*Want "CU14 page end"       0000003C 0000003D 0000003E 0000003F
+r 40400.10
+*Want "CU14 next page"      00000000 00000001 00000002 00000003
+r 40500.10
+*Want "CU14 Euro sign"      000020AC 00000043 00000044 00000045
+r 42FF0.10
+*Want "CU41 page end"       70717273 74757677 78797A7B 7C7D7E7F
+r 430C0.10
+*Want "CU41 Euro sign"      E282AC43 44454647 48494A4B 4C4D4E4F
+r 44280.10
+*Want "CU12 Euro sign"      20AC0043 00440045 00460047 00480049
+r 460C0.10
+*Want "CU21 Euro sign"      E282AC43 44454647 48494A4B 4C4D4E4F
+*Done
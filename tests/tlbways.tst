@@ -0,0 +1,122 @@
+*Testcase tlbways: 4-way TLB hits and IPTE invalidation
+
+# Four virtual pages which all map to TLB set 0 are repeatedly
+# added to R2, so that with a 4-way TLB they are all found in the
+# TLB after the first pass.  The page table entry for the third page
+# is then invalidated using IPTE while the page is in way 1 of its
+# set, and replaced (with DAT off) by one for a different frame.  If
+# the stale TLB entry were to be used, R2 would end up as X'5E0'
+# instead of X'6DC'.
+#
+#   1000  LHI   R12,X'1000'
+#   1004  LLILH R5,X'0040'          4M   -> frame X'20000' (1)
+#   1008  LLILH R6,X'0080'          8M   -> frame X'21000' (2)
+#   100C  LLILH R7,X'00C0'          12M  -> frame X'22000' (4)
+#   1010  LLILH R8,X'0100'          16M  -> frame X'23000' (8)
+#   1014  L     R10,PTO             page table for 12M
+#   1018  LHI   R3,100
+#   101C  A     R2,0(,R5)           LOOP
+#   1020  A     R2,0(,R6)
+#   1024  A     R2,0(,R7)
+#   1028  A     R2,0(,R8)
+#   102C  BCT   R3,LOOP
+#   1030  IPTE  R10,R7
+#   1034  STNSM SAVE,X'FB'          DAT off
+#   1038  MVC   0(8,R10),NEWPTE     12M  -> frame X'25000' (X'100')
+#   103E  STOSM SAVE,X'04'          DAT on
+#   1042  A     R2,0(,R7)
+#   1046  LPSWE WAITPSW
+#   1080  PTO      DC  X'00012800'
+#   1088  NEWPTE   DC  X'0000000000025000'
+#   1090  SAVE     DS  X
+#   10A0  WAITPSW  DC  X'00020001800000000000000000000000'
+
+sysclear
+archmode z
+tlbways 4
+cr 1=0000000000010000
+r  1A0=04000001800000000000000000001000
+r 1000=A7C81000A55E0040A56E0080A57E00C0A58E0100
+r 1014=58A0C080A7380064
+r 101C=5A2050005A2060005A2070005A2080004630C01C
+r 1030=B22100A7ACFBC090D207A000C088AD04C0905A207000B2B2C0A0
+r 1080=000128000000000000000000000250000000000000000000
+r 10A0=00020001800000000000000000000000
+r 10000=0000000000011000
+r 10020=0000000000011800
+r 10040=0000000000012000
+r 10060=0000000000012800
+r 10080=0000000000013000
+r 11000=00000000000000000000000000001000
+r 11800=0000000000020000
+r 12000=0000000000021000
+r 12800=0000000000022000
+r 13000=0000000000023000
+r 20000=00000001
+r 21000=00000002
+r 22000=00000004
+r 23000=00000008
+r 25000=00000100
+runtest .1
+tlbways 1
+*Compare
+gpr
+*Gpr 2 00000000000006DC
+*Done
+
+*Testcase tlbways: EDAT-1 large frame TLB and PTLB
+
+# Four pages of the 1M segment at virtual X'100000', which is a large
+# (format control) segment at absolute X'200000', are added to R2.  All
+# but the first are 4K TLB misses which are satisfied from the large
+# frame TLB.  The segment table entry is then changed (with DAT off) to
+# designate the frame at X'300000' instead, PTLB is issued, and the
+# loop is run again.  If the stale large frame entry were to be used,
+# R2 would end up as X'1E' instead of X'FF'.
+#
+#   1000  LHI   R12,X'1000'
+#   1004  LLILH R11,X'0001'         segment table
+#   1008  LHI   R4,2
+#   100C  LLILH R5,X'0010'          PASS
+#   1010  LHI   R3,4
+#   1014  A     R2,0(,R5)           LOOP
+#   1018  AHI   R5,X'1000'
+#   101C  BCT   R3,LOOP
+#   1020  STNSM SAVE,X'FB'          DAT off
+#   1024  MVC   8(8,R11),NEWSTE     1M   -> frame X'300000'
+#   102A  STOSM SAVE,X'04'          DAT on
+#   102E  PTLB
+#   1032  BCT   R4,PASS
+#   1036  LPSWE WAITPSW
+#   1088  NEWSTE   DC  X'0000000000300400'
+#   1090  SAVE     DS  X
+#   10A0  WAITPSW  DC  X'00020001800000000000000000000000'
+
+mainsize 4
+sysclear
+archmode z
+cr 0=0000000000800000
+cr 1=0000000000010000
+r  1A0=04000001800000000000000000001000
+r 1000=A7C81000A5BE0001A7480002A55E0010A7380004
+r 1014=5A205000A75A10004630C014ACFBC090D207B008C088
+r 102A=AD04C090B20D00004640C00CB2B2C0A0
+r 1088=0000000000300400
+r 10A0=00020001800000000000000000000000
+r 10000=00000000000110000000000000200400
+r 11000=00000000000000000000000000001000
+r 200000=00000001
+r 201000=00000002
+r 202000=00000004
+r 203000=00000008
+r 300000=00000010
+r 301000=00000020
+r 302000=00000040
+r 303000=00000080
+runtest .1
+*Compare
+gpr
+*Gpr 2 00000000000000FF
+*Done
+
+mainsize 2
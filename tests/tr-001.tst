@@ -0,0 +1,192 @@
+*Testcase tr-001: TR, TRT, TRTR, TRE, CLCLE and TROO across page boundaries
+
+# X'3000' bytes at X'10000' are set to the low byte of their offset.
+# Three 256 byte tables are built at X'20000': T1 translates each
+# byte to its value plus one, T2 has only X'20' nonzero (X'11') and
+# T3 has only X'E0' nonzero (X'22').  Then:
+#
+#   TR    a destination crossing a page boundary through T1.
+#   TRT   256 bytes from X'11F50' through T2, which first finds a
+#         nonzero function byte in the second page (at X'12020'),
+#         and 16 bytes from the same address, which find nothing.
+#   TRTR  256 bytes ending at X'1204F' through T3, which first finds
+#         a nonzero function byte in the first page (at X'11FE0').
+#   TRE   X'100' bytes at X'12100' through T1 with test byte X'40',
+#         which stops at X'12140'.
+#   CLCLE X'100' bytes at X'10F00' and at X'11F00', which are equal
+#         up to X'10F80', where TR changed the first operand.
+#
+# R1, R2 and the IPM result after each are stored at X'30000' etc.
+#
+#   1000  LHI   R12,X'1000'
+#   1004  LLILH R5,X'0001'          R5 -> X'10000'
+#   1008  LHI   R2,0
+#   100C  LHI   R3,X'3000'
+#   1010  STC   R2,0(R2,R5)         LOOP
+#   1014  AHI   R2,1
+#   1018  BCT   R3,LOOP
+#   101C  LLILH R13,X'0002'         R13 -> X'20000'
+#   1020  MVC   0(256,R13),1(R5)    T1
+#   1026  MVI   X'120'(R13),X'11'   T2
+#   102A  MVI   X'2E0'(R13),X'22'   T3
+#   102E  LLILH R15,X'0003'         R15 -> X'30000'
+#   1032  TR    X'F80'(256,R5),0(R13)
+#   1038  LLILH R8,X'0001'
+#   103C  AHI   R8,X'1F50'          R8 -> X'11F50'
+#   1040  LHI   R1,0
+#   1044  LHI   R2,0
+#   1048  TRT   0(256,R8),X'100'(R13)
+#   104E  BAS   R14,SAVE
+#   1052  LHI   R1,0
+#   1056  LHI   R2,0
+#   105A  TRT   0(16,R8),X'100'(R13)
+#   1060  BAS   R14,SAVE
+#   1064  LHI   R1,0
+#   1068  LHI   R2,0
+#   106C  TRTR  X'FF'(256,R8),X'200'(R13)
+#   1072  BAS   R14,SAVE
+#   1076  LHI   R0,X'40'
+#   107A  LLILH R10,X'0001'
+#   107E  AHI   R10,X'2100'         R10 -> X'12100'
+#   1082  LHI   R11,X'100'
+#   1086  TRE   R10,R13
+#   108A  BAS   R14,SAVE
+#   108E  LLILH R4,X'0001'
+#   1092  AHI   R4,X'F00'           R4 -> X'10F00'
+#   1096  LHI   R5,X'100'
+#   109A  LLILH R6,X'0001'
+#   109E  AHI   R6,X'1F00'          R6 -> X'11F00'
+#   10A2  LHI   R7,X'100'
+#   10A6  CLCLE R4,R6,0
+#   10AA  BAS   R14,SAVE
+#   10AE  LPSWE WAITPSW
+#   10C0  IPM   R3                  SAVE
+#   10C4  ST    R1,0(R15)
+#   10C8  ST    R2,4(R15)
+#   10CC  ST    R3,8(R15)
+#   10D0  AHI   R15,16
+#   10D4  BR    R14
+#   10E0  WAITPSW  DC  X'00020001800000000000000000000000'
+
+sysclear
+archmode z
+r  1A0=00000001800000000000000000001000
+r 1000=A7C81000A55E0001A7280000A738300042225000A72A00014630C010A5DE0002
+r 1020=D2FFD00050019211D1209222D2E0A5FE0003DCFF5F80D000A58E0001A78A1F50
+r 1040=A7180000A7280000DDFF8000D1004DE0C0C0A7180000A7280000DD0F8000D100
+r 1060=4DE0C0C0A7180000A7280000D0FF80FFD2004DE0C0C0A7080040A5AE0001A7AA
+r 1080=2100A7B80100B2A500AD4DE0C0C0A54E0001A74A0F00A7580100A56E0001A76A
+r 10A0=1F00A7780100A94600004DE0C0C0B2B2C0E00000000000000000000000000000
+r 10C0=B22200305010F0005020F0045030F008A7FA001007FE00000000000000000000
+r 10E0=00020001800000000000000000000000
+runtest .1
+*Compare
+gpr
+*Gpr 4 0000000000010F80
+*Gpr 5 0000000000000080
+*Gpr 6 0000000000011F80
+*Gpr 7 0000000000000080
+*Gpr 10 0000000000012140
+*Gpr 11 00000000000000C0
+#                            0 1 2 3  4 5 6 7  8 9 A B  C D E F
+r 10F70.10
+*Want "TR before"           70717273 74757677 78797A7B 7C7D7E7F
+r 10FF0.10
+*Want "TR first page"       F1F2F3F4 F5F6F7F8 F9FAFBFC FDFEFF00
+r 11000.10
+*Want "TR second page"      01020304 05060708 090A0B0C 0D0E0F10
+r 11070.10
+*Want "TR end"              71727374 75767778 797A7B7C 7D7E7F80
+r 11080.10
+*Want "TR after"            80818283 84858687 88898A8B 8C8D8E8F
+r 30000.10
+*Want "TRT second page"     00012020 00000011 10000000 00000000
+r 30010.10
+*Want "TRT no hit"          00000000 00000000 00000000 00000000
+r 30020.10
+*Want "TRTR first page"     00011FE0 00000022 10000000 00000000
+r 30030.10
+*Want "TRE test byte"       00011FE0 00000022 10000000 00000000
+r 30040.10
+*Want "CLCLE unequal"       00011FE0 00000022 20000000 00000000
+r 12100.10
+*Want "TRE start"           01020304 05060708 090A0B0C 0D0E0F10
+r 12130.10
+*Want "TRE end"             31323334 35363738 393A3B3C 3D3E3F40
+r 12140.10
+*Want "TRE after"           40414243 44454647 48494A4B 4C4D4E4F
+*Done
+
+*Testcase tr-001 TROO: Translate One to One up to a page boundary
+
+# X'2000' bytes at X'10000' are again set to the low byte of their
+# offset and T1 is built at X'20000'.  R1 -> T1, test byte X'40'.
+# TROO translates X'200' bytes at X'10F80' to X'40F80' three times:
+#
+#   TROO  with the test byte ignored, which stops with CC 3 at the
+#         page boundary of both operands after X'80' bytes.
+#   TROO  which stops with CC 1 at X'1103F', whose function byte is
+#         the test byte, after X'3F' more bytes.
+#   TROO  again, which stores nothing and ends with CC 1 at once.
+#
+# R2, R3, the IPM result and R4 after each are stored at X'30000'.
+#
+#   1000  LHI   R12,X'1000'
+#   1004  LLILH R5,X'0001'          R5 -> X'10000'
+#   1008  LHI   R2,0
+#   100C  LHI   R3,X'2000'
+#   1010  STC   R2,0(R2,R5)         LOOP
+#   1014  AHI   R2,1
+#   1018  BCT   R3,LOOP
+#   101C  LLILH R13,X'0002'         R13 -> X'20000'
+#   1020  MVC   0(256,R13),1(R5)    T1
+#   1026  LLILH R15,X'0003'         R15 -> X'30000'
+#   102A  LR    R1,R13
+#   102C  LHI   R0,X'40'
+#   1030  LLILH R2,X'0004'
+#   1034  AHI   R2,X'F80'           R2 -> X'40F80'
+#   1038  LHI   R3,X'200'
+#   103C  LLILH R4,X'0001'
+#   1040  AHI   R4,X'F80'           R4 -> X'10F80'
+#   1044  TROO  R2,R4,1
+#   1048  BAS   R14,SAVE
+#   104C  TROO  R2,R4
+#   1050  BAS   R14,SAVE
+#   1054  TROO  R2,R4
+#   1058  BAS   R14,SAVE
+#   105C  LPSWE WAITPSW
+#   10C0  IPM   R6                  SAVE
+#   10C4  ST    R2,0(R15)
+#   10C8  ST    R3,4(R15)
+#   10CC  ST    R6,8(R15)
+#   10D0  ST    R4,12(R15)
+#   10D4  AHI   R15,16
+#   10D8  BR    R14
+#   10E0  WAITPSW  DC  X'00020001800000000000000000000000'
+
+sysclear
+archmode z
+r  1A0=00000001800000000000000000001000
+r 1000=A7C81000A55E0001A7280000A738200042225000A72A00014630C010A5DE0002
+r 1020=D2FFD0005001A5FE0003181DA7080040A52E0004A72A0F80A7380200A54E0001
+r 1040=A74A0F80B99310244DE0C0C0B99300244DE0C0C0B99300244DE0C0C0B2B2C0E0
+r 10C0=B22200605020F0005030F0045060F0085040F00CA7FA001007FE000000000000
+r 10E0=00020001800000000000000000000000
+runtest .1
+*Compare
+#                            0 1 2 3  4 5 6 7  8 9 A B  C D E F
+r 30000.10
+*Want "TROO page boundary"  00041000 00000180 30000000 00011000
+r 30010.10
+*Want "TROO test byte"      0004103F 00000141 10000000 0001103F
+r 30020.10
+*Want "TROO test byte again" 0004103F 00000141 10000000 0001103F
+r 40F80.10
+*Want "TROO first page"     81828384 85868788 898A8B8C 8D8E8F90
+r 40FF0.10
+*Want "TROO page end"       F1F2F3F4 F5F6F7F8 F9FAFBFC FDFEFF00
+r 41000.10
+*Want "TROO second page"    01020304 05060708 090A0B0C 0D0E0F10
+r 41030.10
+*Want "TROO end"            31323334 35363738 393A3B3C 3D3E3F00
+*Done
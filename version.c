@@ -647,6 +647,18 @@ static const char *build_info[] = {
     "Without CCKD BZIP2 support",
 #endif
 
+#if defined( CCKD_ZSTD )
+    "With    CCKD ZSTD support",
+#else
+    "Without CCKD ZSTD support",
+#endif
+
+#if defined( CCKD_LZ4 )
+    "With    CCKD LZ4 support",
+#else
+    "Without CCKD LZ4 support",
+#endif
+
 #if defined(HET_BZIP2)
     "With    HET BZIP2 support",
 #else
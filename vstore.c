@@ -150,6 +150,7 @@ extern inline void ARCH_DEP( move_chars_rl )( VADR addr1, int arn1, BYTE key1,
 /*-------------------------------------------------------------------*/
 
 extern inline void concpy    ( REGS* regs, void* d, void* s, int n );
+extern inline void concpy_long( REGS* regs, void* d, void* s, int n );
 #if defined( _FEATURE_061_MISC_INSTR_EXT_FACILITY_3 )
 extern inline void concpy_rl ( REGS* regs, void* d, void* s, int n );
 #endif
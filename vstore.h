@@ -153,6 +153,9 @@
 #ifndef _VSTORE_CONCPY
 #define _VSTORE_CONCPY
 
+/* Shortest length concpy_long hands to host_vec_copy                */
+#define CONCPY_VEC_MIN      256
+
 /*-------------------------------------------------------------------*/
 /* Copy 8 bytes at a time concurrently   (from left to right)        */
 /*-------------------------------------------------------------------*/
@@ -161,6 +164,13 @@ inline void concpy( REGS* regs, void* d, void* s, int n )
     BYTE* u8d = d;
     BYTE* u8s = s;
 
+    /* Single byte propagation (destination one byte right of source) */
+    if (unlikely( u8d == u8s + 1 ) && n)
+    {
+        memset( u8d, *u8s, n );
+        return;
+    }
+
     /* Copy until ready or 8 byte integral boundary */
     while (n && ((uintptr_t) u8d & 7))
     {
@@ -216,6 +226,34 @@ inline void concpy( REGS* regs, void* d, void* s, int n )
         n--;
     }
 } /* end function concpy */
+
+/*-------------------------------------------------------------------*/
+/* Copy long operands (MVCL, MVCLE, MVCOS) using host vectors        */
+/*-------------------------------------------------------------------*/
+/* Kept apart from concpy so the call does not slow down the MVC     */
+/* path, where concpy is inlined.                                    */
+/*-------------------------------------------------------------------*/
+inline void concpy_long( REGS* regs, void* d, void* s, int n )
+{
+#if defined( HAVE_HOST_VEC_COPY )
+
+    BYTE* u8d = d;
+    BYTE* u8s = s;
+
+    /* Copy host vectors on enough length and src - dst distance */
+    if (n >= CONCPY_VEC_MIN && (u8d <= u8s || u8d - u8s >= 32))
+    {
+        int k = host_vec_copy( u8d, u8s, n );
+        d = u8d + k;
+        s = u8s + k;
+        n -= k;
+    }
+
+#endif
+
+    concpy( regs, d, s, n );
+
+} /* end function concpy_long */
 #endif // _VSTORE_CONCPY
 
 #if defined( FEATURE_061_MISC_INSTR_EXT_FACILITY_3 )
@@ -1310,7 +1348,7 @@ int     len1, len2, len3;               /* Work areas for lengths    */
         len3 = len1 < len2 ? len1 : len2;
 
         /* Copy bytes from source to destination */
-        concpy( regs, main1, main2, len3 );
+        concpy_long( regs, main1, main2, len3 );
 
         /* Calculate virtual addresses for next chunk */
         addr1 = (addr1 + len3) & ADDRESS_MAXWRAP( regs );